@@ -1,6 +1,9 @@
 #include "alloc_tracker.h"
 
 #include <errno.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
 
 static struct Allocation {
     void* subject = NULL;
@@ -11,6 +14,8 @@ static struct Allocation {
 
 static Allocation* GLB_free_cell = GLB_allocations + 1;
 
+static void write_profile_output();
+
 /**
  * @brief Fill allocation buffer with default values and link them.
  * 
@@ -48,7 +53,7 @@ static void pop_allocation(Allocation* ptr) {
     GLB_free_cell = ptr;
 }
 
-void _track_allocation(void* subject, dtor_t *dtor) {
+void _track_allocation(void* subject, dtor_t *dtor, const size_t size, const AllocSite site) {
     Allocation* next_free = GLB_free_cell->_next;
     *GLB_free_cell = Allocation {subject, dtor, GLB_allocations, GLB_allocations->_prev};
 
@@ -57,6 +62,8 @@ void _track_allocation(void* subject, dtor_t *dtor) {
 
     log_printf(STATUS_REPORTS, "status", "Started tracking address %p at index %ld.\n", subject, GLB_free_cell - GLB_allocations);
     GLB_free_cell = next_free;
+
+    alloc_profile_add(subject, size, site);
 }
 
 void untrack_allocation(void* subject) {
@@ -67,12 +74,14 @@ void untrack_allocation(void* subject) {
             break; 
         }
     }
+
+    alloc_profile_remove(subject);
 }
 
 void free_allocation(void* subject) {
     for (Allocation* ptr = GLB_allocations->_next; ptr != GLB_allocations; ptr = ptr->_next) {
 
-        if (ptr->subject != subject) {
+        if (ptr->subject == subject) {
 
             ptr->dtor(ptr->subject);
             pop_allocation(ptr);
@@ -80,14 +89,20 @@ void free_allocation(void* subject) {
             break;
         }
     }
+
+    alloc_profile_remove(subject);
 }
 
 void free_all_allocations() {
     for (Allocation* ptr = GLB_allocations->_next; ptr != GLB_allocations; ptr = ptr->_next) {
         log_printf(STATUS_REPORTS, "status", "Processing address %p from cell %ld.\n", ptr->subject, ptr - GLB_allocations);
         ptr->dtor(ptr->subject);
+        alloc_profile_remove(ptr->subject);
     }
     __fill_allocations();
+
+    //* Everything tracked is freed by now, so live allocations of the profile are the leaked ones.
+    write_profile_output();
 }
 
 void free_var(void** ptr) {
@@ -95,4 +110,536 @@ void free_var(void** ptr) {
     log_printf(STATUS_REPORTS, "status", "Freeing address %p.\n", *ptr);
     free(*ptr);
     *ptr = NULL;
-}
\ No newline at end of file
+}
+
+//* Minimal number of slots of profile hash tables.
+static const size_t PROFILE_MIN_SLOTS = 64;
+
+/**
+ * @brief Allocations of one site.
+ * 
+ */
+struct SiteStats {
+    AllocSite site = {};
+    unsigned long long total_count = 0;
+    unsigned long long total_bytes = 0;     // Sum of sizes (resized allocations count with their greatest size).
+    unsigned long long live_count = 0;
+    unsigned long long live_bytes = 0;
+    unsigned long long peak_bytes = 0;      // Greatest live bytes value.
+    unsigned long long freed_count = 0;
+    unsigned long long freed_bytes = 0;
+    unsigned long long used_bytes = 0;      // Bytes of freed allocations that were used.
+    unsigned long long lifetime_ns = 0;     // Sum of lifetimes of freed allocations.
+    unsigned long long max_lifetime_ns = 0;
+};
+
+/**
+ * @brief Live allocation (slot of the record table).
+ * 
+ */
+struct AllocRecord {
+    const void* subject = NULL; // NULL for empty slots.
+    size_t site = 0;
+    size_t size = 0;
+    size_t peak_size = 0;
+    unsigned long long start_ns = 0;
+};
+
+/**
+ * @brief Tables of the allocation profile (open addressing, at most half full).
+ * 
+ */
+static struct AllocProfile {
+    SiteStats* sites = NULL;
+    size_t site_count = 0;
+    size_t* site_index = NULL;          // Site numbers +1 (0 for empty slots).
+    size_t site_mask = 0;
+    AllocRecord* records = NULL;
+    size_t record_count = 0;
+    size_t record_mask = 0;
+    char output[FILENAME_MAX] = "";
+    AllocReportFormat format = ALLOC_REPORT_TEXT;
+} GLB_profile = {};
+
+static volatile sig_atomic_t GLB_profile_signaled = 0;
+
+static unsigned long long monotonic_ns() {
+    timespec moment = {};
+    clock_gettime(CLOCK_MONOTONIC, &moment);
+    return (unsigned long long)moment.tv_sec * 1000000000ull + (unsigned long long)moment.tv_nsec;
+}
+
+static size_t mix_hash(uint64_t hash) {
+    hash = (hash ^ (hash >> 33)) * 0xFF51AFD7ED558CCD;
+    hash = (hash ^ (hash >> 33)) * 0xC4CEB9FE1A85EC53;
+    return hash ^ (hash >> 33);
+}
+
+static uint64_t string_hash(const char* str, uint64_t hash) {
+    if (!str) return hash;
+
+    for (; *str; ++str) hash = (hash ^ (unsigned char)*str) * 0x100000001B3;
+    return hash;
+}
+
+static bool same_string(const char* first, const char* second) {
+    return first == second || (first && second && strcmp(first, second) == 0);
+}
+
+/**
+ * @brief Get home slot of the site.
+ * 
+ * @note Sites are compared by contents, as equal file names of different translation units may be different strings.
+ * 
+ * @param site
+ * @return size_t
+ */
+static size_t site_home(const AllocSite& site) {
+    uint64_t hash = string_hash(site.function, string_hash(site.file, 0xCBF29CE484222325));
+    return mix_hash(hash ^ (uint64_t)site.line) & GLB_profile.site_mask;
+}
+
+static size_t record_home(const void* subject) {
+    return mix_hash((uint64_t)subject) & GLB_profile.record_mask;
+}
+
+/**
+ * @brief Find number of the site, add the site if it is new.
+ * 
+ * @param site
+ * @return number of the site (SIZE_MAX if there is no memory for it)
+ */
+static size_t find_site(const AllocSite& site) {
+    AllocProfile* profile = &GLB_profile;
+
+    if (2 * (profile->site_count + 1) > profile->site_mask + 1 || !profile->site_index) {
+        size_t slot_count = profile->site_index ? 2 * (profile->site_mask + 1) : PROFILE_MIN_SLOTS;
+        size_t* index = (size_t*) calloc(slot_count, sizeof(*index));
+        SiteStats* sites = (SiteStats*) realloc(profile->sites, slot_count / 2 * sizeof(*sites));
+
+        _LOG_FAIL_CHECK_(index && sites, "error", ERROR_REPORTS, {
+            free(index);
+            if (sites) profile->sites = sites;
+            return SIZE_MAX;
+        }, NULL, ENOMEM);
+
+        free(profile->site_index);
+        profile->site_index = index;
+        profile->site_mask = slot_count - 1;
+        profile->sites = sites;
+
+        for (size_t number = 0; number < profile->site_count; ++number) {
+            size_t slot = site_home(sites[number].site);
+            while (index[slot]) slot = (slot + 1) & profile->site_mask;
+            index[slot] = number + 1;
+        }
+    }
+
+    size_t slot = site_home(site);
+    for (; profile->site_index[slot]; slot = (slot + 1) & profile->site_mask) {
+        const AllocSite& known = profile->sites[profile->site_index[slot] - 1].site;
+        if (known.line == site.line && same_string(known.file, site.file) && same_string(known.function, site.function))
+            return profile->site_index[slot] - 1;
+    }
+
+    profile->sites[profile->site_count] = SiteStats {};
+    profile->sites[profile->site_count].site = site;
+    profile->site_index[slot] = ++profile->site_count;
+
+    return profile->site_count - 1;
+}
+
+static size_t record_slot(const void* subject) {
+    size_t slot = record_home(subject);
+    while (GLB_profile.records[slot].subject && GLB_profile.records[slot].subject != subject)
+        slot = (slot + 1) & GLB_profile.record_mask;
+
+    return slot;
+}
+
+/**
+ * @brief Find record of the live allocation.
+ * 
+ * @param subject
+ * @return AllocRecord* (NULL if the allocation is unknown)
+ */
+static AllocRecord* find_record(const void* subject) {
+    if (!GLB_profile.records || !subject) return NULL;
+
+    AllocRecord* record = GLB_profile.records + record_slot(subject);
+    return record->subject ? record : NULL;
+}
+
+/**
+ * @brief Empty the record slot, moving records of the probe chain after it back.
+ * 
+ * @param slot
+ */
+static void erase_record(size_t slot) {
+    AllocRecord* records = GLB_profile.records;
+    const size_t mask = GLB_profile.record_mask;
+
+    for (size_t next = (slot + 1) & mask; records[next].subject; next = (next + 1) & mask) {
+        size_t home = record_home(records[next].subject);
+
+        //* Records whose home slots lie after the hole are still reachable where they are.
+        if (((next - home) & mask) >= ((next - slot) & mask)) {
+            records[slot] = records[next];
+            slot = next;
+        }
+    }
+
+    records[slot] = AllocRecord {};
+    --GLB_profile.record_count;
+}
+
+/**
+ * @brief Make sure the record table has space for one more record.
+ * 
+ * @return false if there is no memory for it
+ */
+static bool reserve_record() {
+    AllocProfile* profile = &GLB_profile;
+    if (profile->records && 2 * (profile->record_count + 1) <= profile->record_mask + 1) return true;
+
+    size_t slot_count = profile->records ? 2 * (profile->record_mask + 1) : PROFILE_MIN_SLOTS;
+    AllocRecord* records = (AllocRecord*) calloc(slot_count, sizeof(*records));
+    _LOG_FAIL_CHECK_(records, "error", ERROR_REPORTS, return false, NULL, ENOMEM);
+
+    AllocRecord* old_records = profile->records;
+    size_t old_count = old_records ? profile->record_mask + 1 : 0;
+
+    profile->records = records;
+    profile->record_mask = slot_count - 1;
+
+    for (size_t old_slot = 0; old_slot < old_count; ++old_slot)
+        if (old_records[old_slot].subject) records[record_slot(old_records[old_slot].subject)] = old_records[old_slot];
+
+    free(old_records);
+    return true;
+}
+
+/**
+ * @brief Write the profile to the output if it is set.
+ * 
+ */
+static void write_profile_output() {
+    if (!*GLB_profile.output) return;
+
+    FILE* output = fopen(GLB_profile.output, GLB_profile.format == ALLOC_REPORT_PPROF ? "wb" : "w");
+    _LOG_FAIL_CHECK_(output, "error", ERROR_REPORTS, return, NULL, errno);
+
+    alloc_profile_report(output, GLB_profile.format);
+    fclose(output);
+
+    log_printf(STATUS_REPORTS, "status", "Allocation profile was written to %s.\n", GLB_profile.output);
+}
+
+void alloc_profile_add(const void* subject, const size_t size, const AllocSite site) {
+    alloc_profile_poll();
+
+    if (!subject || find_record(subject) || !reserve_record()) return;
+
+    size_t number = find_site(site);
+    if (number == SIZE_MAX) return;
+
+    SiteStats* stats = GLB_profile.sites + number;
+    ++stats->total_count;
+    ++stats->live_count;
+    stats->total_bytes += size;
+    stats->live_bytes += size;
+    if (stats->live_bytes > stats->peak_bytes) stats->peak_bytes = stats->live_bytes;
+
+    GLB_profile.records[record_slot(subject)] = AllocRecord { subject, number, size, size, monotonic_ns() };
+    ++GLB_profile.record_count;
+}
+
+void alloc_profile_resize(const void* subject, const size_t size) {
+    alloc_profile_poll();
+
+    AllocRecord* record = find_record(subject);
+    if (!record) return;
+
+    SiteStats* stats = GLB_profile.sites + record->site;
+    stats->live_bytes = stats->live_bytes - record->size + size;
+    if (stats->live_bytes > stats->peak_bytes) stats->peak_bytes = stats->live_bytes;
+
+    if (size > record->peak_size) {
+        stats->total_bytes += size - record->peak_size;
+        record->peak_size = size;
+    }
+
+    record->size = size;
+}
+
+void alloc_profile_remove(const void* subject, const size_t used_size) {
+    alloc_profile_poll();
+
+    AllocRecord* record = find_record(subject);
+    if (!record) return;
+
+    SiteStats* stats = GLB_profile.sites + record->site;
+    unsigned long long lifetime = monotonic_ns() - record->start_ns;
+
+    --stats->live_count;
+    stats->live_bytes -= record->size;
+    ++stats->freed_count;
+    stats->freed_bytes += record->peak_size;
+    stats->used_bytes += used_size < record->peak_size ? used_size : record->peak_size;
+    stats->lifetime_ns += lifetime;
+    if (lifetime > stats->max_lifetime_ns) stats->max_lifetime_ns = lifetime;
+
+    erase_record((size_t)(record - GLB_profile.records));
+}
+
+/**
+ * @brief Compare sites by allocated bytes (greater first).
+ * 
+ * @param first pointer to the site number
+ * @param second pointer to the site number
+ * @return int
+ */
+static int compare_sites(const void* first, const void* second) {
+    const SiteStats* first_stats = GLB_profile.sites + *(const size_t*)first;
+    const SiteStats* second_stats = GLB_profile.sites + *(const size_t*)second;
+
+    if (first_stats->total_bytes != second_stats->total_bytes) return first_stats->total_bytes < second_stats->total_bytes ? 1 : -1;
+    if (first_stats->total_count != second_stats->total_count) return first_stats->total_count < second_stats->total_count ? 1 : -1;
+    return 0;
+}
+
+static void print_text_report(FILE* const stream, const size_t* const order) {
+    fprintf(stream, "Allocation profile (%zu sites, sorted by allocated bytes):\n", GLB_profile.site_count);
+    fprintf(stream, "%14s %10s %12s %14s %10s %14s %14s %7s %14s %14s  %s\n", "total bytes", "count", "mean bytes",
+            "live bytes", "live", "peak bytes", "freed bytes", "used", "mean life, ns", "max life, ns", "site");
+
+    for (size_t rank = 0; rank < GLB_profile.site_count; ++rank) {
+        const SiteStats* stats = GLB_profile.sites + order[rank];
+
+        unsigned long long mean_bytes = stats->total_count ? stats->total_bytes / stats->total_count : 0;
+        double used = stats->freed_bytes ? 100.0 * (double)stats->used_bytes / (double)stats->freed_bytes : 100.0;
+        unsigned long long mean_life = stats->freed_count ? stats->lifetime_ns / stats->freed_count : 0;
+
+        fprintf(stream, "%14llu %10llu %12llu %14llu %10llu %14llu %14llu %6.1f%% %14llu %14llu  %s:%d (%s)\n",
+                stats->total_bytes, stats->total_count, mean_bytes, stats->live_bytes, stats->live_count,
+                stats->peak_bytes, stats->freed_bytes, used, mean_life, stats->max_lifetime_ns,
+                stats->site.file ? stats->site.file : "?", stats->site.line,
+                stats->site.function ? stats->site.function : "?");
+    }
+}
+
+//* Protocol buffer encoding of the pprof profile (profile.proto), written without compression.
+
+/**
+ * @brief Growing byte buffer of an encoded message.
+ * 
+ */
+struct ProtoBuffer {
+    unsigned char* data = NULL;
+    size_t size = 0;
+    size_t capacity = 0;
+    bool failed = false;
+};
+
+static void proto_put(ProtoBuffer* const buffer, const void* const data, const size_t size) {
+    if (buffer->failed) return;
+
+    if (buffer->size + size > buffer->capacity) {
+        size_t capacity = buffer->capacity ? buffer->capacity : 256;
+        while (capacity < buffer->size + size) capacity *= 2;
+
+        unsigned char* grown = (unsigned char*) realloc(buffer->data, capacity);
+        _LOG_FAIL_CHECK_(grown, "error", ERROR_REPORTS, {
+            buffer->failed = true;
+            return;
+        }, NULL, ENOMEM);
+
+        buffer->data = grown;
+        buffer->capacity = capacity;
+    }
+
+    memcpy(buffer->data + buffer->size, data, size);
+    buffer->size += size;
+}
+
+static void proto_varint(ProtoBuffer* const buffer, unsigned long long value) {
+    unsigned char bytes[10] = {};
+    size_t size = 0;
+
+    do {
+        bytes[size++] = (unsigned char)((value & 0x7F) | (value > 0x7F ? 0x80 : 0));
+        value >>= 7;
+    } while (value);
+
+    proto_put(buffer, bytes, size);
+}
+
+static void proto_uint(ProtoBuffer* const buffer, const unsigned field, const unsigned long long value) {
+    proto_varint(buffer, field << 3);
+    proto_varint(buffer, value);
+}
+
+static void proto_bytes(ProtoBuffer* const buffer, const unsigned field, const void* const data, const size_t size) {
+    proto_varint(buffer, field << 3 | 2);
+    proto_varint(buffer, size);
+    proto_put(buffer, data, size);
+}
+
+/**
+ * @brief Write the nested message as the field and empty the nested buffer for the next one.
+ * 
+ * @param buffer
+ * @param field
+ * @param message
+ */
+static void proto_message(ProtoBuffer* const buffer, const unsigned field, ProtoBuffer* const message) {
+    buffer->failed |= message->failed;
+    proto_bytes(buffer, field, message->data, message->size);
+    message->size = 0;
+}
+
+//* Sample values of the pprof profile.
+static const char* const PPROF_STRINGS[] = {
+    "",
+    "alloc_objects", "count",
+    "alloc_space", "bytes",
+    "inuse_objects",
+    "inuse_space",
+    "freed_lifetime", "nanoseconds",
+};
+
+static const unsigned long long PPROF_SAMPLE_TYPES[][2] = { {1, 2}, {3, 4}, {5, 2}, {6, 4}, {7, 8} };
+static const size_t PPROF_STRING_COUNT = sizeof(PPROF_STRINGS) / sizeof(*PPROF_STRINGS);
+
+static void print_pprof_report(FILE* const stream, const size_t* const order, int* const err_code) {
+    ProtoBuffer profile = {}, message = {}, nested = {}, packed = {};
+
+    for (size_t type = 0; type < sizeof(PPROF_SAMPLE_TYPES) / sizeof(*PPROF_SAMPLE_TYPES); ++type) {
+        proto_uint(&message, 1, PPROF_SAMPLE_TYPES[type][0]);
+        proto_uint(&message, 2, PPROF_SAMPLE_TYPES[type][1]);
+        proto_message(&profile, 1, &message);
+    }
+
+    //* Every site gets one sample, one location and one function, all with id = site number + 1.
+    //* Its function name and file name are strings PPROF_STRING_COUNT + 2 * number and the next one.
+    for (size_t rank = 0; rank < GLB_profile.site_count; ++rank) {
+        size_t number = order[rank];
+        const SiteStats* stats = GLB_profile.sites + number;
+
+        proto_varint(&packed, number + 1);
+        proto_bytes(&message, 1, packed.data, packed.size);
+        packed.size = 0;
+
+        unsigned long long values[] = { stats->total_count, stats->total_bytes, stats->live_count, stats->live_bytes,
+                                        stats->lifetime_ns };
+        for (size_t value = 0; value < sizeof(values) / sizeof(*values); ++value) proto_varint(&packed, values[value]);
+        proto_bytes(&message, 2, packed.data, packed.size);
+        packed.size = 0;
+
+        proto_message(&profile, 2, &message);
+    }
+
+    for (size_t number = 0; number < GLB_profile.site_count; ++number) {
+        proto_uint(&message, 1, number + 1);
+        proto_uint(&nested, 1, number + 1);
+        proto_uint(&nested, 2, (unsigned long long)GLB_profile.sites[number].site.line);
+        proto_message(&message, 4, &nested);
+        proto_message(&profile, 4, &message);
+    }
+
+    for (size_t number = 0; number < GLB_profile.site_count; ++number) {
+        unsigned long long name = PPROF_STRING_COUNT + 2 * number;
+        proto_uint(&message, 1, number + 1);
+        proto_uint(&message, 2, name);
+        proto_uint(&message, 3, name);
+        proto_uint(&message, 4, name + 1);
+        proto_message(&profile, 5, &message);
+    }
+
+    for (size_t string = 0; string < PPROF_STRING_COUNT; ++string)
+        proto_bytes(&profile, 6, PPROF_STRINGS[string], strlen(PPROF_STRINGS[string]));
+
+    for (size_t number = 0; number < GLB_profile.site_count; ++number) {
+        const AllocSite& site = GLB_profile.sites[number].site;
+        const char* function = site.function ? site.function : "?";
+        const char* file = site.file ? site.file : "?";
+
+        proto_bytes(&profile, 6, function, strlen(function));
+        proto_bytes(&profile, 6, file, strlen(file));
+    }
+
+    timespec moment = {};
+    clock_gettime(CLOCK_REALTIME, &moment);
+    proto_uint(&profile, 9, (unsigned long long)moment.tv_sec * 1000000000ull + (unsigned long long)moment.tv_nsec);
+
+    //* Allocated bytes are shown by default (the same order as in the text report).
+    proto_uint(&profile, 14, 3);
+
+    bool failed = profile.failed || message.failed || nested.failed || packed.failed;
+    if (!failed) failed = fwrite(profile.data, 1, profile.size, stream) != profile.size;
+
+    free(profile.data);
+    free(message.data);
+    free(nested.data);
+    free(packed.data);
+
+    _LOG_FAIL_CHECK_(!failed, "error", ERROR_REPORTS, return, err_code, EIO);
+}
+
+void alloc_profile_report(FILE* const stream, const AllocReportFormat format, int* const err_code) {
+    _LOG_FAIL_CHECK_(stream, "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    size_t* order = (size_t*) calloc(GLB_profile.site_count + 1, sizeof(*order));
+    _LOG_FAIL_CHECK_(order, "error", ERROR_REPORTS, return, err_code, ENOMEM);
+
+    for (size_t number = 0; number < GLB_profile.site_count; ++number) order[number] = number;
+    qsort(order, GLB_profile.site_count, sizeof(*order), compare_sites);
+
+    switch (format) {
+        case ALLOC_REPORT_PPROF:
+            print_pprof_report(stream, order, err_code);
+            break;
+        case ALLOC_REPORT_TEXT:
+        default:
+            print_text_report(stream, order);
+            break;
+    }
+
+    free(order);
+}
+
+void alloc_profile_set_output(const char* const file_name, const AllocReportFormat format) {
+    GLB_profile.output[0] = '\0';
+    if (file_name) strncat(GLB_profile.output, file_name, sizeof(GLB_profile.output) - 1);
+    GLB_profile.format = format;
+}
+
+static void on_profile_signal(int signal_id) {
+    SILENCE_UNUSED(signal_id);
+    GLB_profile_signaled = 1;
+}
+
+void alloc_profile_on_signal(const int signal_id) {
+    _LOG_FAIL_CHECK_(signal(signal_id, on_profile_signal) != SIG_ERR, "error", ERROR_REPORTS, return, NULL, errno);
+}
+
+void alloc_profile_poll() {
+    if (!GLB_profile_signaled) return;
+
+    GLB_profile_signaled = 0;
+    write_profile_output();
+}
+
+void alloc_profile_reset() {
+    free(GLB_profile.sites);
+    free(GLB_profile.site_index);
+    free(GLB_profile.records);
+
+    GLB_profile.sites = NULL;
+    GLB_profile.site_index = NULL;
+    GLB_profile.records = NULL;
+    GLB_profile.site_count = 0;
+    GLB_profile.site_mask = 0;
+    GLB_profile.record_count = 0;
+    GLB_profile.record_mask = 0;
+}
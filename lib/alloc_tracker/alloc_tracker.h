@@ -13,6 +13,8 @@
 #define ALLOC_TRACKER_H
 
 #include "stdlib.h"
+#include "stdio.h"
+#include "stdint.h"
 #include "lib/util/dbg/logger.h"
 #include "lib/util/dbg/debug.h"
 
@@ -21,19 +23,48 @@ const size_t MAX_ALLOCATIONS = 1024 + 1;
 
 typedef void dtor_t(void* subject);
 
+//* Place in the code allocations are attributed to in the allocation profile.
+struct AllocSite {
+    const char* file = NULL;
+    int line = 0;
+    const char* function = NULL;
+
+    //* Constructor call keeps builtins of ALLOC_SITE_HERE from being folded at the declaration of the default argument.
+    AllocSite() = default;
+    AllocSite(const char* const site_file, const int site_line, const char* const site_function) :
+        file (site_file), line (site_line), function (site_function) {}
+};
+
+//* Site of the expression (of the caller if it is a default argument).
+#define ALLOC_SITE_HERE AllocSite { __builtin_FILE(), __builtin_LINE(), __builtin_FUNCTION() }
+
+enum AllocReportFormat {
+    ALLOC_REPORT_TEXT,      // Table of sites sorted by allocated bytes.
+    ALLOC_REPORT_PPROF,     // Uncompressed profile.proto message (`pprof -top file`).
+};
+
 /**
  * @brief Add allocation to the track list.
  * 
  * @param subject allocation subject
  * @param dtor destructor
  */
-#define track_allocation(subject, dtor) do { \
+#define track_allocation(subject, dtor) track_allocation_sized(subject, dtor, 0)
+
+/**
+ * @brief Add allocation of the specified size to the track list.
+ * 
+ * @param subject allocation subject
+ * @param dtor destructor
+ * @param size size of the allocation in bytes (for the allocation profile)
+ */
+#define track_allocation_sized(subject, dtor, size) do { \
     log_printf(STATUS_REPORTS, "status", "Processing tracking request " #subject \
                                          " with destructor "#dtor" in %s in %s:%d.\n", __PRETTY_FUNCTION__, __FILE__, __LINE__); \
-    _track_allocation(subject, dtor); \
+    _track_allocation(subject, dtor, size, ALLOC_SITE_HERE); \
 } while (0)
 
-void _track_allocation(void* subject, dtor_t *dtor);
+void _track_allocation(void* subject, dtor_t *dtor, const size_t size = 0, const AllocSite site = ALLOC_SITE_HERE);
 
 /**
  * @brief Untrack allocation by variable.
@@ -62,4 +93,75 @@ void free_all_allocations();
  */
 void free_var(void** ptr);
 
+//* Allocation profile sums up allocations of every site: how many of them were made and are still live,
+//* their bytes, how much of the bytes were used by the time they were freed and how long they lived.
+//* Tracked allocations are counted automatically, other ones are added with alloc_profile_add()
+//* (lists do it when LIST_PROFILE is defined). Like the tracker, the profile is not thread-safe.
+
+/**
+ * @brief Count the allocation in the profile of its site.
+ * 
+ * @note Subjects that are already live keep their first record (e.g. lists constructed and then tracked).
+ * 
+ * @param subject allocation subject (the key of the record)
+ * @param size size of the allocation in bytes
+ * @param site place of the allocation
+ */
+void alloc_profile_add(const void* subject, const size_t size, const AllocSite site = ALLOC_SITE_HERE);
+
+/**
+ * @brief Change size of the live allocation (e.g. after its buffer grew).
+ * 
+ * @param subject allocation subject
+ * @param size new size of the allocation in bytes
+ */
+void alloc_profile_resize(const void* subject, const size_t size);
+
+/**
+ * @brief Close the record of the allocation (unknown subjects are ignored).
+ * 
+ * @param subject allocation subject
+ * @param used_size how many bytes of the allocation were used (SIZE_MAX if all of them)
+ */
+void alloc_profile_remove(const void* subject, const size_t used_size = SIZE_MAX);
+
+/**
+ * @brief Print the profile.
+ * 
+ * @param stream stream to print to (it has to be binary for ALLOC_REPORT_PPROF)
+ * @param format
+ * @param err_code variable to use as errno
+ */
+void alloc_profile_report(FILE* const stream, const AllocReportFormat format, int* const err_code = NULL);
+
+/**
+ * @brief Set the file free_all_allocations() and signals write the profile to.
+ * 
+ * @param file_name name of the file (NULL or empty to stop writing the profile)
+ * @param format
+ */
+void alloc_profile_set_output(const char* const file_name, const AllocReportFormat format);
+
+/**
+ * @brief Write the profile to the output when the program gets the signal.
+ * 
+ * @note The handler only raises a flag, the profile is written by the next profile update
+ *       or alloc_profile_poll() call, so it is safe to use with any signal.
+ * 
+ * @param signal_id signal to write the profile on (e.g. SIGUSR1)
+ */
+void alloc_profile_on_signal(const int signal_id);
+
+/**
+ * @brief Write the profile if the signal set with alloc_profile_on_signal() arrived.
+ * 
+ */
+void alloc_profile_poll();
+
+/**
+ * @brief Forget all records of the profile.
+ * 
+ */
+void alloc_profile_reset();
+
 #endif
\ No newline at end of file
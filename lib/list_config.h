@@ -23,11 +23,65 @@
     "\t\t<TR><TD PORT=\"head\" BGCOLOR=\"%s\">Cell %d</TD></TR>\n" \
     "\t\t<TR><TD BGCOLOR=\"%s\">%02X %02X %02X %02X</TD></TR>\n" \
     "\t\t<TR><TD PORT=\"bottom\">P:%ld N:%ld</TD></TR></TABLE>>]\n", (int)id, \
-    cell==list->first_empty || cell==list->buffer ? LIST_POISON_COLOR : LIST_VALUE_COLOR, \
-    (int)id, cell->content==LIST_ELEM_POISON ? LIST_POISON_COLOR : LIST_VALUE_COLOR, \
-    data[0], data[1], data[2], data[3], cell->prev-list->buffer, cell->next-list->buffer
+    id==list->first_empty || id==0 ? LIST_POISON_COLOR : LIST_VALUE_COLOR, \
+    (int)id, !_List_is_occupied(list, id) ? LIST_POISON_COLOR : LIST_VALUE_COLOR, \
+    data[0], data[1], data[2], data[3], (long)cell->prev, (long)cell->next
 
 const size_t LIST_PICT_NAME_SIZE = 128;
 const size_t LIST_DRAW_REQUEST_SIZE = 256;
 
+//* Offset of the first cell in list files (keeps mapped cells page-aligned).
+const size_t LIST_FILE_DATA_OFFSET = 4096;
+const unsigned long long LIST_FILE_MAGIC = 0x5453494C4B524F57;  // "WORKLIST" in little-endian.
+const unsigned int LIST_FILE_VERSION = 7;
+const size_t LIST_FILE_NAME_SIZE = 256;
+
+const unsigned long long LIST_STREAM_MAGIC = 0x4D52545354534C57;  // "WLSTSTRM" in little-endian.
+const unsigned int LIST_STREAM_VERSION = 2;
+//* Size of intermediate buffers used by stream readers and writers.
+const size_t LIST_STREAM_CHUNK_SIZE = 1 << 16;
+//* Max size of stream records (and headers) readers can handle.
+const size_t LIST_STREAM_MAX_STRIDE = 1 << 10;
+
+const unsigned long long LIST_JOURNAL_MAGIC = 0x4C4E524A5453494C;  // "LISTJRNL" in little-endian.
+const unsigned int LIST_JOURNAL_VERSION = 2;
+//* Default size of journal group commit buffers (records are written and synced when it fills up).
+const size_t LIST_JOURNAL_GROUP_SIZE = 1 << 16;
+
+const unsigned long long LIST_WORKLOAD_MAGIC = 0x444C4B575453494C;  // "LISTWKLD" in little-endian.
+const unsigned int LIST_WORKLOAD_VERSION = 1;
+//* Size of workload recorder buffers (records are written when it fills up).
+const size_t LIST_WORKLOAD_BUFFER_SIZE = 1 << 16;
+
+//* Number of counter shards in list statistics (threads with equal ids modulo this number share them).
+const size_t LIST_STATS_SHARD_COUNT = 16;
+
+//* Size of chunk list nodes in bytes (two cache lines), see listchunked_.h.
+const size_t LIST_CHUNK_SIZE = 128;
+//* Min number of elements in chunk list nodes (used when elements are too big to fill LIST_CHUNK_SIZE bytes).
+const size_t LIST_CHUNK_MIN_SLOTS = 4;
+
+//* Share of SLRU cache entries the protected segment can hold, percent (see listcache_.h).
+const size_t LIST_CACHE_PROTECTED_PERCENT = 80;
+
+//* Lists shorter than this are processed on the calling thread only.
+const size_t LIST_PARALLEL_MIN_SIZE = 1 << 14;
+//* Number of sublists every pool thread gets during parallel traversal.
+const size_t LIST_SUBLISTS_PER_THREAD = 8;
+
+//* Number of lookups List_find_positions_multi() walks at once.
+const size_t LIST_LOOKUP_GROUP = 16;
+
+//* Elements of this size in bytes or bigger are kept out of list cells (see LIST_INDIRECT).
+//* Define it before the library include to choose another threshold.
+#ifndef LIST_INDIRECT_MIN_SIZE
+#define LIST_INDIRECT_MIN_SIZE 64
+#endif
+
+//* Number of cells (the sentinel included) small lists keep inside their objects (see SmallList).
+//* Define it before the library include to choose another number (at least 2, or 0 to drop inline buffers).
+#ifndef LIST_INLINE_CELLS
+#define LIST_INLINE_CELLS 8
+#endif
+
 #endif
\ No newline at end of file
@@ -0,0 +1,359 @@
+/**
+ * @file listcache.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief .cpp - style file for listworks caches.
+ * @version 0.1
+ * @date 2022-11-25
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+//* Function headers are specified in the file listcache_.h
+
+#ifndef LISTCACHE_HPP
+#define LISTCACHE_HPP
+
+#include "listcache_.h"
+
+#include <stdlib.h>
+
+#include "listworks.h"
+
+/**
+ * @brief Check cache fields operations rely on.
+ * 
+ * @param cache
+ * @return true if the cache can be worked with
+ */
+static inline bool _ListCache_valid(const ListCache* const cache) {
+    return cache && cache->entries && cache->index && cache->list.size <= cache->capacity &&
+           (cache->policy != LIST_CACHE_LFU || cache->groups);
+}
+
+/**
+ * @brief Get the home slot of the key in the index.
+ * 
+ * @param cache
+ * @param key
+ * @return size_t
+ */
+static inline size_t _ListCache_home(const ListCache* const cache, const list_cache_key_t key) {
+    uint64_t hash = key;
+    hash = (hash ^ (hash >> 33)) * 0xFF51AFD7ED558CCD;
+    hash = (hash ^ (hash >> 33)) * 0xC4CEB9FE1A85EC53;
+    return (hash ^ (hash >> 33)) & cache->index_mask;
+}
+
+/**
+ * @brief Find the index slot holding the key or the empty slot to put it in.
+ * 
+ * @param cache
+ * @param key
+ * @return size_t
+ */
+static inline size_t _ListCache_slot(const ListCache* const cache, const list_cache_key_t key) {
+    size_t slot = _ListCache_home(cache, key);
+    while (cache->index[slot] && cache->entries[cache->index[slot]].key != key) slot = (slot + 1) & cache->index_mask;
+
+    return slot;
+}
+
+/**
+ * @brief Empty the index slot, moving entries of the probe chain after it back.
+ * 
+ * @param cache
+ * @param slot
+ */
+static void _ListCache_erase_slot(ListCache* const cache, size_t slot) {
+    const size_t mask = cache->index_mask;
+
+    for (size_t next = (slot + 1) & mask; cache->index[next]; next = (next + 1) & mask) {
+        size_t home = _ListCache_home(cache, cache->entries[cache->index[next]].key);
+
+        //* Entries whose home slots lie after the hole are still reachable where they are.
+        if (((next - home) & mask) >= ((next - slot) & mask)) {
+            cache->index[slot] = cache->index[next];
+            slot = next;
+        }
+    }
+
+    cache->index[slot] = 0;
+}
+
+/**
+ * @brief Link a new frequency group between the two adjacent ones.
+ * 
+ * @param cache LFU cache
+ * @param prev group with greater frequency (0 for the first place)
+ * @param frequency
+ * @return size_t
+ */
+static size_t _ListCache_take_group(ListCache* const cache, const size_t prev, const unsigned long long frequency) {
+    _ListCacheGroup* groups = cache->groups;
+
+    size_t group = cache->free_group;
+    if (group) cache->free_group = groups[group].next;
+    else       group = cache->used_groups++;
+
+    size_t next = groups[prev].next;
+
+    groups[group] = _ListCacheGroup {};
+    groups[group].frequency = frequency;
+    groups[group].prev = prev;
+    groups[group].next = next;
+    groups[prev].next = group;
+    groups[next].prev = group;
+
+    return group;
+}
+
+/**
+ * @brief Remove the entry from its frequency group (the group is freed if it becomes empty).
+ * 
+ * @param cache LFU cache
+ * @param cell cell of the entry, still linked into the list
+ */
+static void _ListCache_leave_group(ListCache* const cache, const list_position_t cell) {
+    _ListCacheGroup* groups = cache->groups;
+    size_t group = cache->entries[cell].group;
+
+    if (groups[group].first != cell) {
+        if (groups[group].last == cell) groups[group].last = cache->list.buffer[cell].prev;
+        return;
+    }
+
+    if (groups[group].last != cell) {
+        groups[group].first = cache->list.buffer[cell].next;
+        return;
+    }
+
+    groups[groups[group].prev].next = groups[group].next;
+    groups[groups[group].next].prev = groups[group].prev;
+    groups[group].next = cache->free_group;
+    cache->free_group = group;
+}
+
+/**
+ * @brief Move the entry to its place after a hit.
+ * 
+ * @param cache
+ * @param cell cell of the entry
+ * @param err_code variable to use as errno
+ */
+static void _ListCache_touch(ListCache* const cache, const list_position_t cell, int* const err_code) {
+    List* list = &cache->list;
+    _ListCacheEntry* entry = cache->entries + cell;
+
+    switch (cache->policy) {
+        case LIST_CACHE_SLRU: {
+            if (entry->group) {
+                if (cell == cache->protected_last && list->buffer[cell].prev != 0) cache->protected_last = list->buffer[cell].prev;
+                List_move(list, cell, 0, err_code);
+                return;
+            }
+
+            List_move(list, cell, 0, err_code);
+
+            entry->group = 1;
+            if (cache->protected_last == 0) cache->protected_last = cell;
+
+            //* The least recently used protected entry goes back to probation (it is already next to it).
+            if (++cache->protected_count > cache->protected_capacity) {
+                cache->entries[cache->protected_last].group = 0;
+                cache->protected_last = list->buffer[cache->protected_last].prev;
+                --cache->protected_count;
+            }
+            return;
+        }
+        case LIST_CACHE_LFU: {
+            _ListCacheGroup* groups = cache->groups;
+            size_t group = entry->group;
+            size_t prev = groups[group].prev;
+            unsigned long long frequency = groups[group].frequency + 1;
+
+            if (groups[group].first == cell && groups[group].last == cell && (prev == 0 || groups[prev].frequency != frequency)) {
+                groups[group].frequency = frequency;
+                return;
+            }
+
+            //* Entry becomes the first one of the group with the next frequency.
+            bool has_target = prev != 0 && groups[prev].frequency == frequency;
+            list_position_t position = list->buffer[has_target ? groups[prev].first : groups[group].first].prev;
+
+            _ListCache_leave_group(cache, cell);
+            List_move(list, cell, position, err_code);
+
+            size_t target = has_target ? prev : _ListCache_take_group(cache, prev, frequency);
+            if (!has_target) groups[target].last = cell;
+            groups[target].first = cell;
+            entry->group = target;
+            return;
+        }
+        case LIST_CACHE_LRU:
+        default:
+            List_move(list, cell, 0, err_code);
+            return;
+    }
+}
+
+/**
+ * @brief Insert the value of the new entry in its place.
+ * 
+ * @param cache cache with a free entry
+ * @param value
+ * @param err_code variable to use as errno
+ * @return cell of the entry (0 on failure)
+ */
+static list_position_t _ListCache_insert(ListCache* const cache, const list_elem_t value, int* const err_code) {
+    List* list = &cache->list;
+    list_position_t cell = 0;
+
+    switch (cache->policy) {
+        case LIST_CACHE_SLRU:
+            cell = List_insert(list, value, cache->protected_last, err_code);
+            if (cell) cache->entries[cell].group = 0;
+            return cell;
+        case LIST_CACHE_LFU: {
+            _ListCacheGroup* groups = cache->groups;
+            size_t last = groups[0].prev;
+
+            if (last != 0 && groups[last].frequency == 1) {
+                cell = List_insert(list, value, list->buffer[groups[last].first].prev, err_code);
+                if (cell) groups[last].first = cell;
+            } else {
+                cell = List_insert(list, value, list->buffer->prev, err_code);
+                if (cell) {
+                    last = _ListCache_take_group(cache, last, 1);
+                    groups[last].first = groups[last].last = cell;
+                }
+            }
+
+            if (cell) cache->entries[cell].group = last;
+            return cell;
+        }
+        case LIST_CACHE_LRU:
+        default:
+            return List_insert(list, value, 0, err_code);
+    }
+}
+
+void ListCache_ctor(ListCache* const cache, const size_t capacity, const ListCachePolicy policy, int* const err_code) {
+    _LOG_FAIL_CHECK_(check_ptr(cache),                         "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(capacity > 0 && policy <= LIST_CACHE_LFU, "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    *cache = ListCache {};
+    cache->policy = policy;
+    cache->capacity = capacity;
+    cache->protected_capacity = capacity * LIST_CACHE_PROTECTED_PERCENT / 100;
+
+    //* Tables at most half full keep probe chains short.
+    size_t index_size = 2;
+    while (index_size < 2 * capacity) index_size *= 2;
+    cache->index_mask = index_size - 1;
+
+    int error = 0;
+    List_ctor(&cache->list, capacity + 2, &error);
+    _LOG_FAIL_CHECK_(error == 0, "error", ERROR_REPORTS, return, err_code, error);
+
+    List_set_checks(&cache->list, LIST_CHECK_PERIODIC, capacity);
+
+    cache->entries = (_ListCacheEntry*) calloc(capacity + 2, sizeof(*cache->entries));
+    cache->index = (list_position_t*) calloc(index_size, sizeof(*cache->index));
+    if (policy == LIST_CACHE_LFU) {
+        cache->groups = (_ListCacheGroup*) calloc(capacity + 2, sizeof(*cache->groups));
+        cache->used_groups = 1;
+    }
+
+    _LOG_FAIL_CHECK_(_ListCache_valid(cache), "error", ERROR_REPORTS, {
+        ListCache_dtor(cache);
+        return;
+    }, err_code, ENOMEM);
+}
+
+void ListCache_dtor(ListCache* const cache, int* const err_code) {
+    _LOG_FAIL_CHECK_(cache, "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    if (cache->list.buffer) List_dtor(&cache->list, err_code);
+
+    free(cache->entries);
+    free(cache->index);
+    free(cache->groups);
+
+    *cache = ListCache {};
+}
+
+bool ListCache_get(ListCache* const cache, const list_cache_key_t key, list_elem_t* const value, int* const err_code) {
+    _LOG_FAIL_CHECK_(_ListCache_valid(cache), "error", ERROR_REPORTS, return false, err_code, EFAULT);
+
+    list_position_t cell = cache->index[_ListCache_slot(cache, key)];
+    if (!cell) {
+        ++cache->misses;
+        return false;
+    }
+
+    ++cache->hits;
+    if (value) *value = _List_elem(&cache->list, cell);
+
+    _ListCache_touch(cache, cell, err_code);
+
+    return true;
+}
+
+void ListCache_put(ListCache* const cache, const list_cache_key_t key, const list_elem_t value, int* const err_code) {
+    _LOG_FAIL_CHECK_(_ListCache_valid(cache), "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    int error = 0;
+
+    list_position_t cell = cache->index[_ListCache_slot(cache, key)];
+    if (cell) {
+        List_set(&cache->list, cell, value, &error);
+        if (error == 0) _ListCache_touch(cache, cell, &error);
+
+        _LOG_FAIL_CHECK_(error == 0, "error", ERROR_REPORTS, return, err_code, error);
+        return;
+    }
+
+    if (cache->list.size == cache->capacity) ListCache_evict(cache, NULL, NULL, &error);
+    if (error == 0) cell = _ListCache_insert(cache, value, &error);
+
+    _LOG_FAIL_CHECK_(error == 0 && cell, "error", ERROR_REPORTS, return, err_code, error ? error : EAGAIN);
+
+    //* Eviction could shift index entries, so the slot is found again.
+    cache->entries[cell].key = key;
+    cache->index[_ListCache_slot(cache, key)] = cell;
+}
+
+bool ListCache_evict(ListCache* const cache, list_cache_key_t* const key, list_elem_t* const value, int* const err_code) {
+    _LOG_FAIL_CHECK_(_ListCache_valid(cache), "error", ERROR_REPORTS, return false, err_code, EFAULT);
+
+    List* list = &cache->list;
+    if (list->size == 0) return false;
+
+    list_position_t victim = list->buffer->prev;
+    list_cache_key_t victim_key = cache->entries[victim].key;
+
+    if (key) *key = victim_key;
+    if (value) *value = _List_elem(list, victim);
+
+    if (cache->policy == LIST_CACHE_LFU) _ListCache_leave_group(cache, victim);
+
+    //* Protected entries are only evicted when probation is empty, then the victim is the last of them.
+    if (cache->policy == LIST_CACHE_SLRU && cache->entries[victim].group) {
+        cache->protected_last = list->buffer[victim].prev;
+        --cache->protected_count;
+    }
+
+    _ListCache_erase_slot(cache, _ListCache_slot(cache, victim_key));
+    cache->entries[victim] = _ListCacheEntry {};
+
+    int error = 0;
+    List_pop(list, victim, &error);
+    _LOG_FAIL_CHECK_(error == 0, "error", ERROR_REPORTS, return false, err_code, error);
+
+    ++cache->evictions;
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,144 @@
+/**
+ * @file listcache_.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Fixed-capacity key-value cache built on listworks lists.
+ * @version 0.1
+ * @date 2022-11-25
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#ifndef LISTCACHE_H
+#define LISTCACHE_H
+
+#include <stdint.h>
+
+#include "listworks_.h"
+#include "list_config.h"
+
+//* Cache values are elements of its list, ordered from the most valuable entry (the head)
+//* to the eviction candidate (the tail). Hits reorder entries with List_move(), so they never allocate,
+//* and evictions free list cells for the next insertions. Keys of list cells live in a parallel array
+//* and an open addressing table (linear probing, no tombstones) maps keys to cells.
+//*
+//* LRU keeps entries in the order of use. SLRU splits the list into the protected segment (entries hit
+//* at least twice, at the head) and the probation one (entries used once, at the tail), so scans of new keys
+//* only push out each other. LFU keeps groups of entries with equal hit counts in descending count order,
+//* with the most recently used entries first in every group.
+//*
+//* The list runs periodic checks with the audit interval equal to the cache capacity,
+//* so every operation takes O(1) amortized time (see List_set_checks()).
+
+typedef uint64_t list_cache_key_t;
+
+enum ListCachePolicy {
+    LIST_CACHE_LRU,         // Evict the least recently used entry.
+    LIST_CACHE_SLRU,        // Segmented LRU: evict the least recently used entry of those hit only once.
+    LIST_CACHE_LFU,         // Evict the least frequently used entry (the least recently used one of equals).
+};
+
+static const char* const LIST_CACHE_POLICY_NAMES[] = {
+    "lru",
+    "slru",
+    "lfu",
+};
+
+/**
+ * @brief Key of the cache entry and its place in policy structures.
+ * 
+ */
+struct _ListCacheEntry {
+    list_cache_key_t key = 0;
+    size_t group = 0;                   // Frequency group (LFU) or 1 for entries of the protected segment (SLRU).
+};
+
+/**
+ * @brief Entries of LFU cache with the same hit count (they are adjacent in the list).
+ * 
+ */
+struct _ListCacheGroup {
+    unsigned long long frequency = 0;   // Number of uses of every entry.
+    list_position_t first = 0;          // Entry closest to the list head (the most recently used one).
+    list_position_t last = 0;
+    size_t prev = 0;                    // Group with greater frequency (0 for the first one).
+    size_t next = 0;                    // Group with smaller frequency (0 for the last one, free groups are stacked through it).
+};
+
+/**
+ * @brief Fixed-capacity cache.
+ * 
+ */
+struct ListCache {
+    List list = {};                     // Values from the most valuable entry to the eviction candidate.
+    ListCachePolicy policy = LIST_CACHE_LRU;
+    size_t capacity = 0;                // Max number of entries.
+    _ListCacheEntry* entries = NULL;    // Entry of every list cell.
+    list_position_t* index = NULL;      // Open addressing table of entry cells (0 for empty slots).
+    size_t index_mask = 0;              // Size of the table minus one (the size is a power of two).
+    _ListCacheGroup* groups = NULL;     // Frequency groups of LFU caches (group 0 links the first and the last group).
+    size_t used_groups = 0;             // Number of groups ever taken (including group 0).
+    size_t free_group = 0;              // First group of the free group stack (0 if it is empty).
+    list_position_t protected_last = 0; // Last entry of the protected segment of SLRU caches (0 if it is empty).
+    size_t protected_count = 0;
+    size_t protected_capacity = 0;      // Max number of protected entries.
+    unsigned long long hits = 0;
+    unsigned long long misses = 0;
+    unsigned long long evictions = 0;
+};
+
+/**
+ * @brief Initialize the cache.
+ * 
+ * @param cache cache to initialize
+ * @param capacity max number of entries
+ * @param policy eviction policy
+ * @param err_code variable to use as errno
+ */
+void ListCache_ctor(ListCache* const cache, const size_t capacity, const ListCachePolicy policy = LIST_CACHE_LRU,
+                    int* const err_code = NULL);
+
+/**
+ * @brief Destroy the cache.
+ * 
+ * @param cache cache to uninitialize
+ * @param err_code variable to use as errno
+ */
+void ListCache_dtor(ListCache* const cache, int* const err_code = NULL);
+
+/**
+ * @brief Look the key up and count the use of its entry.
+ * 
+ * @param cache
+ * @param key
+ * @param[out] value value of the entry (untouched on misses, can be NULL)
+ * @param err_code variable to use as errno
+ * @return true on hits
+ */
+bool ListCache_get(ListCache* const cache, const list_cache_key_t key, list_elem_t* const value, int* const err_code = NULL);
+
+/**
+ * @brief Set value of the key, evicting an entry if the cache is full.
+ * 
+ * @note Updates of present keys count as their use.
+ * 
+ * @param cache
+ * @param key
+ * @param value
+ * @param err_code variable to use as errno
+ */
+void ListCache_put(ListCache* const cache, const list_cache_key_t key, const list_elem_t value, int* const err_code = NULL);
+
+/**
+ * @brief Remove the entry the policy would evict next.
+ * 
+ * @param cache
+ * @param[out] key key of the removed entry (can be NULL)
+ * @param[out] value value of the removed entry (can be NULL)
+ * @param err_code variable to use as errno
+ * @return false if the cache is empty
+ */
+bool ListCache_evict(ListCache* const cache, list_cache_key_t* const key = NULL, list_elem_t* const value = NULL,
+                     int* const err_code = NULL);
+
+#endif
@@ -0,0 +1,405 @@
+/**
+ * @file listchunked.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief .cpp - style file for listworks chunk lists.
+ * @version 0.1
+ * @date 2022-11-21
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+//* Function headers are specified in the file listchunked_.h
+
+#ifndef LISTCHUNKED_HPP
+#define LISTCHUNKED_HPP
+
+#include "listchunked_.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+//* Underfull chunks are merged with neighbours if the result takes at most this many slots,
+//* so a merged chunk needs a quarter of its capacity of insertions to be split again.
+static const size_t LIST_CHUNK_MERGE_LIMIT = LIST_CHUNK_SLOTS * 3 / 4;
+
+static inline list_position_t _ChunkList_position(const list_position_t chunk, const size_t slot) {
+    return chunk * LIST_CHUNK_SLOTS + slot;
+}
+
+/**
+ * @brief Check list fields operations rely on.
+ * 
+ * @param list
+ * @return true if the list can be worked with
+ */
+static inline bool _ChunkList_valid(const ChunkList* const list) {
+    return list && list->chunks && list->used_chunks <= list->chunk_capacity;
+}
+
+/**
+ * @brief Check if the position belongs to an element of the list.
+ * 
+ * @param list
+ * @param position
+ * @return bool
+ */
+static inline bool _ChunkList_has_position(const ChunkList* const list, const list_position_t position) {
+    list_position_t chunk = position / LIST_CHUNK_SLOTS;
+    return chunk != 0 && chunk < list->used_chunks && position % LIST_CHUNK_SLOTS < list->chunks[chunk].count;
+}
+
+/**
+ * @brief Take unused chunk and link it after the specified one.
+ * 
+ * @param list
+ * @param after chunk to link the new one after
+ * @return index of the chunk (0 if the buffer could not grow)
+ */
+static list_position_t _ChunkList_take_chunk(ChunkList* const list, const list_position_t after) {
+    list_position_t chunk = list->free_chunk;
+
+    if (chunk) {
+        list->free_chunk = list->chunks[chunk].next;
+    } else {
+        if (list->used_chunks == list->chunk_capacity) {
+            size_t capacity = list->chunk_capacity * 2;
+            _ListChunk* chunks = (_ListChunk*) realloc(list->chunks, capacity * sizeof(*chunks));
+            if (!chunks) return 0;
+
+            list->chunks = chunks;
+            list->chunk_capacity = capacity;
+        }
+
+        chunk = list->used_chunks++;
+    }
+
+    _ListChunk* chunks = list->chunks;
+
+    chunks[chunk].count = 0;
+    chunks[chunk].prev = after;
+    chunks[chunk].next = chunks[after].next;
+    chunks[chunks[after].next].prev = chunk;
+    chunks[after].next = chunk;
+
+    return chunk;
+}
+
+/**
+ * @brief Unlink the chunk and put it on the free chunk stack.
+ * 
+ * @param list
+ * @param chunk
+ */
+static void _ChunkList_free_chunk(ChunkList* const list, const list_position_t chunk) {
+    _ListChunk* chunks = list->chunks;
+
+    chunks[chunks[chunk].prev].next = chunks[chunk].next;
+    chunks[chunks[chunk].next].prev = chunks[chunk].prev;
+
+    chunks[chunk].next = list->free_chunk;
+    chunks[chunk].prev = 0;
+    chunks[chunk].count = 0;
+    list->free_chunk = chunk;
+}
+
+/**
+ * @brief Move all elements of the source chunk to the end of the destination one and free the source.
+ * 
+ * @param list
+ * @param destination
+ * @param source chunk right after the destination one
+ */
+static void _ChunkList_merge(ChunkList* const list, const list_position_t destination, const list_position_t source) {
+    _ListChunk* chunks = list->chunks;
+
+    memcpy(chunks[destination].elems + chunks[destination].count, chunks[source].elems,
+           chunks[source].count * sizeof(list_elem_t));
+    chunks[destination].count += chunks[source].count;
+
+    _ChunkList_free_chunk(list, source);
+}
+
+void List_ctor(ChunkList* const list, size_t capacity, int* const err_code) {
+    _LOG_FAIL_CHECK_(check_ptr(list), "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    size_t chunk_capacity = capacity / LIST_CHUNK_SLOTS + 2;
+
+    list->chunks = (_ListChunk*) calloc(chunk_capacity, sizeof(*list->chunks));
+    _LOG_FAIL_CHECK_(list->chunks, "error", ERROR_REPORTS, return, err_code, ENOMEM);
+
+    list->chunk_capacity = chunk_capacity;
+    list->used_chunks = 1;
+    list->free_chunk = 0;
+    list->size = 0;
+}
+
+void List_dtor(ChunkList* const list, int* const err_code) {
+    _LOG_FAIL_CHECK_(_ChunkList_valid(list), "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    free(list->chunks);
+    *list = ChunkList {};
+}
+
+list_position_t List_insert(ChunkList* const list, const list_elem_t elem, const list_position_t position, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_INSERT);
+
+    _LOG_FAIL_CHECK_(_ChunkList_valid(list), "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(position == 0 || _ChunkList_has_position(list, position),
+                     "error", ERROR_REPORTS, return 0, err_code, EINVAL);
+
+    list_position_t chunk = list->chunks->next;
+    size_t slot = 0;
+
+    if (position != 0) {
+        chunk = position / LIST_CHUNK_SLOTS;
+        slot = position % LIST_CHUNK_SLOTS + 1;
+    }
+
+    if (chunk == 0) chunk = _ChunkList_take_chunk(list, 0);
+    _LOG_FAIL_CHECK_(chunk, "error", ERROR_REPORTS, return 0, err_code, ENOMEM);
+
+    if (list->chunks[chunk].count == LIST_CHUNK_SLOTS && slot == LIST_CHUNK_SLOTS) {
+        //* Appending to the full chunk: use the next one if it has room, start a new one otherwise,
+        //* so lists built by appending keep their chunks full.
+        list_position_t next = list->chunks[chunk].next;
+
+        chunk = next != 0 && list->chunks[next].count < LIST_CHUNK_SLOTS ? next : _ChunkList_take_chunk(list, chunk);
+        _LOG_FAIL_CHECK_(chunk, "error", ERROR_REPORTS, return 0, err_code, ENOMEM);
+        slot = 0;
+    } else if (list->chunks[chunk].count == LIST_CHUNK_SLOTS) {
+        list_position_t half = _ChunkList_take_chunk(list, chunk);
+        _LOG_FAIL_CHECK_(half, "error", ERROR_REPORTS, return 0, err_code, ENOMEM);
+
+        _ListChunk* chunks = list->chunks;
+        const size_t kept = LIST_CHUNK_SLOTS / 2;
+
+        memcpy(chunks[half].elems, chunks[chunk].elems + kept, (LIST_CHUNK_SLOTS - kept) * sizeof(list_elem_t));
+        chunks[half].count = LIST_CHUNK_SLOTS - kept;
+        chunks[chunk].count = kept;
+
+        if (slot > kept) {
+            chunk = half;
+            slot -= kept;
+        }
+    }
+
+    _ListChunk* target = list->chunks + chunk;
+
+    memmove(target->elems + slot + 1, target->elems + slot, (target->count - slot) * sizeof(list_elem_t));
+    target->elems[slot] = elem;
+    ++target->count;
+    ++list->size;
+
+    return _ChunkList_position(chunk, slot);
+}
+
+list_position_t List_find_position(ChunkList* const list, const int index, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_FIND_POSITION);
+
+    _LOG_FAIL_CHECK_(_ChunkList_valid(list), "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+
+    _LOG_FAIL_CHECK_((-(int)list->size <= index && index < (int)list->size) || list->size == 0, "error", ERROR_REPORTS, {
+        log_printf(ERROR_REPORTS, "error", "Requested index was %d with size %lld.\n", index, (long long) list->size);
+        return 0;
+    }, err_code, EFAULT);
+
+    if (list->size == 0) return 0;
+
+    _ListChunk* chunks = list->chunks;
+
+    if (index >= 0) {
+        size_t left = (size_t)index;
+        list_position_t chunk = chunks->next;
+
+        for (; left >= chunks[chunk].count; chunk = chunks[chunk].next) left -= chunks[chunk].count;
+
+        return _ChunkList_position(chunk, left);
+    }
+
+    size_t left = (size_t)(-(long long)index) - 1;
+    list_position_t chunk = chunks->prev;
+
+    for (; left >= chunks[chunk].count; chunk = chunks[chunk].prev) left -= chunks[chunk].count;
+
+    return _ChunkList_position(chunk, chunks[chunk].count - 1 - left);
+}
+
+list_elem_t List_get(ChunkList* const list, const list_position_t position, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_GET);
+
+    _LOG_FAIL_CHECK_(_ChunkList_valid(list),                  "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(_ChunkList_has_position(list, position), "error", ERROR_REPORTS, return 0, err_code, EINVAL);
+
+    return list->chunks[position / LIST_CHUNK_SLOTS].elems[position % LIST_CHUNK_SLOTS];
+}
+
+void List_pop(ChunkList* const list, const list_position_t position, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_POP);
+
+    _LOG_FAIL_CHECK_(_ChunkList_valid(list),                  "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(_ChunkList_has_position(list, position), "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    _ListChunk* chunks = list->chunks;
+    list_position_t chunk = position / LIST_CHUNK_SLOTS;
+    size_t slot = position % LIST_CHUNK_SLOTS;
+
+    _ListChunk* target = chunks + chunk;
+
+    memmove(target->elems + slot, target->elems + slot + 1, (target->count - slot - 1) * sizeof(list_elem_t));
+    --target->count;
+    --list->size;
+
+    if (target->count == 0) {
+        _ChunkList_free_chunk(list, chunk);
+        return;
+    }
+
+    if (target->count > LIST_CHUNK_SLOTS / 2) return;
+
+    list_position_t next = target->next;
+    list_position_t prev = target->prev;
+
+    if (next != 0 && target->count + chunks[next].count <= LIST_CHUNK_MERGE_LIMIT) {
+        _ChunkList_merge(list, chunk, next);
+    } else if (prev != 0 && chunks[prev].count + target->count <= LIST_CHUNK_MERGE_LIMIT) {
+        _ChunkList_merge(list, prev, chunk);
+    }
+}
+
+list_position_t List_find_value(ChunkList* const list, const list_elem_t value, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_SCAN);
+
+    _LOG_FAIL_CHECK_(_ChunkList_valid(list), "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+
+    _ListChunk* chunks = list->chunks;
+
+    for (list_position_t chunk = chunks->next; chunk != 0; chunk = chunks[chunk].next) {
+        for (size_t slot = 0; slot < chunks[chunk].count; ++slot) {
+            if (chunks[chunk].elems[slot] == value) return _ChunkList_position(chunk, slot);
+        }
+    }
+
+    return 0;
+}
+
+size_t List_count(ChunkList* const list, const list_elem_t value, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_SCAN);
+
+    _LOG_FAIL_CHECK_(_ChunkList_valid(list), "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+
+    _ListChunk* chunks = list->chunks;
+    size_t count = 0;
+
+    for (list_position_t chunk = chunks->next; chunk != 0; chunk = chunks[chunk].next) {
+        for (size_t slot = 0; slot < chunks[chunk].count; ++slot) count += chunks[chunk].elems[slot] == value;
+    }
+
+    return count;
+}
+
+void List_for_each(ChunkList* const list, list_visitor_t* visitor, void* ctx, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_TRAVERSE);
+
+    _LOG_FAIL_CHECK_(_ChunkList_valid(list), "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(visitor,                "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    _ListChunk* chunks = list->chunks;
+
+    for (list_position_t chunk = chunks->next; chunk != 0; chunk = chunks[chunk].next) {
+        for (size_t slot = 0; slot < chunks[chunk].count; ++slot) visitor(&chunks[chunk].elems[slot], ctx);
+    }
+}
+
+list_elem_t List_reduce(ChunkList* const list, list_reducer_t* reducer, const list_elem_t initial, void* ctx,
+                        int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_TRAVERSE);
+
+    _LOG_FAIL_CHECK_(_ChunkList_valid(list), "error", ERROR_REPORTS, return initial, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(reducer,                "error", ERROR_REPORTS, return initial, err_code, EINVAL);
+
+    _ListChunk* chunks = list->chunks;
+    list_elem_t result = initial;
+
+    for (list_position_t chunk = chunks->next; chunk != 0; chunk = chunks[chunk].next) {
+        for (size_t slot = 0; slot < chunks[chunk].count; ++slot) result = reducer(result, chunks[chunk].elems[slot], ctx);
+    }
+
+    return result;
+}
+
+list_report_t List_status(ChunkList* const list) {
+    _LIST_TRACE_(LIST_SPAN_STATUS);
+
+    _LOG_FAIL_CHECK_(list, "error", ERROR_REPORTS, return LIST_NULL, NULL, 0);
+
+    if (!check_ptr(list->chunks) || list->used_chunks > list->chunk_capacity) return LIST_NULL_CONTENT;
+
+    list_report_t report = 0;
+    _ListChunk* chunks = list->chunks;
+
+    size_t element_count = 0;
+    size_t chunk_count = 0;
+
+    for (list_position_t chunk = chunks->next; chunk != 0 && chunk_count < list->used_chunks; chunk = chunks[chunk].next) {
+        if (chunk >= list->used_chunks || chunks[chunks[chunk].next].prev != chunk) return report | LIST_INV_CONNECTIONS;
+        if (chunks[chunk].count == 0 || chunks[chunk].count > LIST_CHUNK_SLOTS) report |= LIST_INV_CONNECTIONS;
+
+        element_count += chunks[chunk].count;
+        ++chunk_count;
+    }
+
+    if (element_count != list->size) report |= LIST_BIG_SIZE;
+
+    size_t free_count = 0;
+    for (list_position_t chunk = list->free_chunk; chunk != 0 && free_count < list->used_chunks; chunk = chunks[chunk].next) {
+        if (chunk >= list->used_chunks) return report | LIST_INV_FREE;
+        ++free_count;
+    }
+
+    //* Every taken chunk but the sentinel is either linked into the list or stacked as free.
+    if (chunk_count + free_count + 1 != list->used_chunks) report |= LIST_INV_FREE;
+
+    return report;
+}
+
+void _List_dump(ChunkList* const list, const unsigned int importance, const int line, const char* func_name, const char* file_name) {
+    _log_printf(importance, LIST_DUMP_TAG, " ----- Chunk list dump in function %s of file %s (%lld): ----- \n",
+                func_name, file_name, (long long) line);
+
+    list_report_t status = List_status(list);
+
+    _log_printf(importance, LIST_DUMP_TAG, "Chunk list at %p:\n", list);
+
+    _log_printf(importance, LIST_DUMP_TAG, "\tStatus: %s\n", status ? "CORRUPT" : "OK");
+
+    for (int error_id = 0; error_id < (int)sizeof(LIST_STATUS_DESCR) / (int)sizeof(LIST_STATUS_DESCR[0]); ++error_id) {
+        if (status & (1 << error_id)) {
+            _log_printf(importance, LIST_DUMP_TAG, "\t\t%s\n", LIST_STATUS_DESCR[error_id]);
+        }
+    }
+
+    if (status & LIST_NULL) return;
+
+    _log_printf(importance, LIST_DUMP_TAG, "\tsize =           %lld,\n", (long long) list->size);
+    _log_printf(importance, LIST_DUMP_TAG, "\tslots per chunk = %lld,\n", (long long) LIST_CHUNK_SLOTS);
+    _log_printf(importance, LIST_DUMP_TAG, "\tused chunks =    %lld,\n", (long long) list->used_chunks);
+    _log_printf(importance, LIST_DUMP_TAG, "\tchunk capacity = %lld,\n", (long long) list->chunk_capacity);
+    _log_printf(importance, LIST_DUMP_TAG, "\tfree chunk =     %lld,\n", (long long) list->free_chunk);
+    _log_printf(importance, LIST_DUMP_TAG, "\tchunks at %p:\n", list->chunks);
+
+    if (status & LIST_NULL_CONTENT) return;
+
+    for (size_t id = 0; id < list->used_chunks; id++) {
+        const _ListChunk* chunk = list->chunks + id;
+        _log_printf(importance, LIST_DUMP_TAG, "\t\t[%5ld] count %lld, next [%lld], prev [%lld]\n", (long) id,
+                    (long long) chunk->count, (long long) chunk->next, (long long) chunk->prev);
+    }
+}
+
+void _List_dump_graph(ChunkList* const list, const unsigned int importance) {
+    SILENCE_UNUSED(list);
+    SILENCE_UNUSED(importance);
+}
+
+#endif
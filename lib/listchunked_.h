@@ -0,0 +1,187 @@
+/**
+ * @file listchunked_.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Unrolled (chunked) list storage with the listworks API.
+ * @version 0.1
+ * @date 2022-11-21
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#ifndef LISTCHUNKED_H
+#define LISTCHUNKED_H
+
+#include "listworks_.h"
+#include "list_config.h"
+
+//* Chunk lists keep up to LIST_CHUNK_SLOTS elements in every node, so scans run over plain arrays
+//* and insertions only move elements of one node. Full nodes are split in halves,
+//* underfull nodes are merged with their neighbours.
+//*
+//* Functions are overloads of the List_* ones, so code written for List works with ChunkList as well.
+//* Positions are (chunk, slot) pairs packed as chunk * LIST_CHUNK_SLOTS + slot (0 is still the place before the head).
+//* Unlike List positions they only stay valid until the next insertion or removal.
+
+//* Bytes taken by links and element count of the chunk.
+const size_t LIST_CHUNK_HEADER_SIZE = 2 * sizeof(list_position_t) + sizeof(size_t);
+//* Number of elements every chunk can hold.
+const size_t LIST_CHUNK_SLOTS = (LIST_CHUNK_SIZE - LIST_CHUNK_HEADER_SIZE) / sizeof(list_elem_t) > LIST_CHUNK_MIN_SLOTS ?
+                                (LIST_CHUNK_SIZE - LIST_CHUNK_HEADER_SIZE) / sizeof(list_elem_t) : LIST_CHUNK_MIN_SLOTS;
+
+/**
+ * @brief List node with a small array of elements.
+ * 
+ * @note Links are chunk indices (0 is the sentinel chunk), free chunks are stacked through next links.
+ */
+struct _ListChunk {
+    list_position_t next = 0;
+    list_position_t prev = 0;
+    size_t count = 0;
+    list_elem_t elems[LIST_CHUNK_SLOTS];
+};
+
+/**
+ * @brief Unrolled list data structure.
+ * 
+ */
+struct ChunkList {
+    _ListChunk* chunks = NULL;
+    size_t chunk_capacity = 0;          // Number of allocated chunks (the buffer grows when they run out).
+    size_t used_chunks = 0;             // Number of chunks ever taken (including the sentinel).
+    list_position_t free_chunk = 0;     // First chunk of the free chunk stack (0 if it is empty).
+    size_t size = 0;
+};
+
+/**
+ * @brief Initialize chunk list.
+ * 
+ * @param list list to initialize
+ * @param capacity number of elements to allocate chunks for (the list grows beyond it when needed)
+ * @param err_code variable to use as errno
+ */
+void List_ctor(ChunkList* const list, size_t capacity = 1024, int* const err_code = NULL);
+
+/**
+ * @brief Destroy the list.
+ * 
+ * @param list list to uninitialize
+ * @param err_code variable to use as errno
+ */
+void List_dtor(ChunkList* const list, int* const err_code = NULL);
+
+/**
+ * @brief Insert element into the list.
+ * 
+ * @param list
+ * @param elem element to insert
+ * @param position which element to insert after
+ * @param err_code variable to use as errno
+ * @return position of the inserted element
+ */
+list_position_t List_insert(ChunkList* const list, const list_elem_t elem, const list_position_t position, int* const err_code = NULL);
+
+/**
+ * @brief Find position of the index'th element in the list.
+ * 
+ * @note Walks chunks, not elements, so it takes O(size / LIST_CHUNK_SLOTS) time.
+ * 
+ * @param list
+ * @param index index of the element (negative to count from the tail)
+ * @param err_code variable to use as errno
+ * @return list_position_t
+ */
+list_position_t List_find_position(ChunkList* const list, const int index, int* const err_code = NULL);
+
+/**
+ * @brief Get element from the list at specified position.
+ * 
+ * @param list
+ * @param position position of the element
+ * @param err_code variable to use as errno
+ * @return list_elem_t
+ */
+list_elem_t List_get(ChunkList* const list, const list_position_t position, int* const err_code = NULL);
+
+/**
+ * @brief Remove element at specified position.
+ * 
+ * @param list
+ * @param position position of the element
+ * @param err_code variable to use as errno
+ */
+void List_pop(ChunkList* const list, const list_position_t position, int* const err_code = NULL);
+
+/**
+ * @brief Find position of the first element equal to the value.
+ * 
+ * @param list
+ * @param value value to search for
+ * @param err_code variable to use as errno
+ * @return position of the element or 0 if there is none
+ */
+list_position_t List_find_value(ChunkList* const list, const list_elem_t value, int* const err_code = NULL);
+
+/**
+ * @brief Count elements equal to the value.
+ * 
+ * @param list
+ * @param value value to count
+ * @param err_code variable to use as errno
+ * @return size_t
+ */
+size_t List_count(ChunkList* const list, const list_elem_t value, int* const err_code = NULL);
+
+/**
+ * @brief Apply visitor to every element of the list in list order.
+ * 
+ * @param list
+ * @param visitor function to apply
+ * @param ctx argument passed to every visitor call
+ * @param err_code variable to use as errno
+ */
+void List_for_each(ChunkList* const list, list_visitor_t* visitor, void* ctx, int* const err_code = NULL);
+
+/**
+ * @brief Fold list elements in list order.
+ * 
+ * @param list
+ * @param reducer function to combine elements with
+ * @param initial value to start folding from
+ * @param ctx argument passed to every reducer call
+ * @param err_code variable to use as errno
+ * @return list_elem_t
+ */
+list_elem_t List_reduce(ChunkList* const list, list_reducer_t* reducer, const list_elem_t initial, void* ctx,
+                        int* const err_code = NULL);
+
+/**
+ * @brief Get info about list as binary mask.
+ * 
+ * @note Walks all chunks, list operations only check list fields.
+ * 
+ * @param list
+ * @return list_report_t
+ */
+list_report_t List_status(ChunkList* const list);
+
+/**
+ * @brief [Should only be called by List_dump() macro] Dump the list into logs.
+ * 
+ * @param list
+ * @param importance message importance
+ * @param line line at which the call was at
+ * @param func_name name of the top-function
+ * @param file_name name of the file where invocation happened
+ */
+void _List_dump(ChunkList* const list, const unsigned int importance, const int line, const char* func_name, const char* file_name);
+
+/**
+ * @brief [Should only be called by List_dump() macro] Chunk lists have no graph images, does nothing.
+ * 
+ * @param list
+ * @param importance
+ */
+void _List_dump_graph(ChunkList* const list, const unsigned int importance);
+
+#endif
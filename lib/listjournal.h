@@ -0,0 +1,422 @@
+/**
+ * @file listjournal.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief .cpp - style file for listworks journal.
+ * @version 0.1
+ * @date 2022-11-14
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+//* Function headers are specified in the file listjournal_.h
+
+#ifndef LISTJOURNAL_HPP
+#define LISTJOURNAL_HPP
+
+#include "listjournal_.h"
+
+#include "listworks.h"
+
+/**
+ * @brief Build name of the journal file.
+ * 
+ * @param name buffer of LIST_FILE_NAME_SIZE bytes
+ * @param base_name
+ * @param extension
+ * @return false if the name does not fit
+ */
+static bool _ListJournal_name(char* const name, const char* base_name, const char* extension) {
+    return snprintf(name, LIST_FILE_NAME_SIZE, "%s%s", base_name, extension) < (int)LIST_FILE_NAME_SIZE;
+}
+
+static hash_t _ListJournal_header_hash(const _ListJournalHeader* const header) {
+    return get_simple_hash(header, &header->header_hash);
+}
+
+/**
+ * @brief Write the whole buffer into the file.
+ * 
+ * @return true on success, false on write error
+ */
+static bool _ListJournal_write_all(const int fd, const void* data, const size_t size) {
+    for (size_t offset = 0; offset < size;) {
+        ssize_t chunk = write(fd, (const char*) data + offset, size - offset);
+        if (chunk <= 0) return false;
+        offset += (size_t)chunk;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Read the whole buffer from the file.
+ * 
+ * @return true on success, false if the file ended earlier
+ */
+static bool _ListJournal_read_all(const int fd, void* data, const size_t size) {
+    for (size_t offset = 0; offset < size;) {
+        ssize_t chunk = read(fd, (char*) data + offset, size - offset);
+        if (chunk <= 0) return false;
+        offset += (size_t)chunk;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Append the value to the record group.
+ * 
+ */
+template <class T>
+static void _ListJournal_put(ListJournal* const journal, const T& value) {
+    memcpy(journal->group + journal->group_used, &value, sizeof(value));
+    journal->group_used += sizeof(value);
+}
+
+/**
+ * @brief Take the value from the record and move the record pointer past it.
+ * 
+ */
+template <class T>
+static T _ListJournal_take(const unsigned char** record) {
+    T value = {};
+    memcpy(&value, *record, sizeof(value));
+    *record += sizeof(value);
+    return value;
+}
+
+static void _ListJournal_observe(const ListEvent event, const list_position_t position, const list_elem_t* elem,
+                                 const list_position_t result, void* ctx) {
+    ListJournal* journal = (ListJournal*) ctx;
+    if (journal->error || event == LIST_EVENT_GET || event == LIST_EVENT_FIND_POSITION || event == LIST_EVENT_REMOVE) return;
+
+    //* Logs can not describe in-place changes and bulk removals, so the whole list is saved instead.
+    if (event == LIST_EVENT_MODIFY || event == LIST_EVENT_REMOVE_IF) {
+        ListJournal_checkpoint(journal, &journal->error);
+        return;
+    }
+
+    if (journal->group_used + LIST_JOURNAL_RECORD_SIZE > journal->group_capacity) {
+        ListJournal_commit(journal, &journal->error);
+        if (journal->error) return;
+    }
+
+    switch (event) {
+        case LIST_EVENT_INSERT:
+            _ListJournal_put(journal, (uint8_t) LIST_RECORD_INSERT);
+            _ListJournal_put(journal, (uint64_t) position);
+            _ListJournal_put(journal, *elem);
+            _ListJournal_put(journal, (uint64_t) result);
+            break;
+        case LIST_EVENT_POP:
+            _ListJournal_put(journal, (uint8_t) LIST_RECORD_POP);
+            _ListJournal_put(journal, (uint64_t) position);
+            break;
+        case LIST_EVENT_LINEARIZE:
+            _ListJournal_put(journal, (uint8_t) LIST_RECORD_LINEARIZE);
+            break;
+        case LIST_EVENT_SORT:
+            _ListJournal_put(journal, (uint8_t) LIST_RECORD_SORT);
+            break;
+        case LIST_EVENT_MOVE:
+            _ListJournal_put(journal, (uint8_t) LIST_RECORD_MOVE);
+            _ListJournal_put(journal, (uint64_t) result);
+            _ListJournal_put(journal, (uint64_t) position);
+            break;
+        case LIST_EVENT_SET:
+            _ListJournal_put(journal, (uint8_t) LIST_RECORD_SET);
+            _ListJournal_put(journal, (uint64_t) position);
+            _ListJournal_put(journal, *elem);
+            break;
+        case LIST_EVENT_REVERSE:
+            _ListJournal_put(journal, (uint8_t) LIST_RECORD_REVERSE);
+            break;
+        case LIST_EVENT_ROTATE:
+            _ListJournal_put(journal, (uint8_t) LIST_RECORD_ROTATE);
+            _ListJournal_put(journal, (uint64_t) position);
+            break;
+        case LIST_EVENT_MODIFY:
+        case LIST_EVENT_GET:
+        case LIST_EVENT_FIND_POSITION:
+        case LIST_EVENT_REMOVE:
+        case LIST_EVENT_REMOVE_IF:
+        default: return;
+    }
+
+    ++journal->group_count;
+    ++journal->records;
+
+    if (journal->checkpoint_interval && journal->records >= journal->checkpoint_interval) {
+        ListJournal_checkpoint(journal, &journal->error);
+    }
+}
+
+void ListJournal_ctor(ListJournal* const journal, List* const list, const char* base_name,
+                      const size_t checkpoint_interval, const size_t group_size, int* const err_code) {
+    _LOG_FAIL_CHECK_(check_ptr(journal),      "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(List_status(list) == 0,  "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(base_name,               "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(!_List_observer(list),   "error", ERROR_REPORTS, return, err_code, EBUSY);
+    _LOG_FAIL_CHECK_(_List_extras(list),      "error", ERROR_REPORTS, return, err_code, ENOMEM);
+
+    *journal = ListJournal {};
+    journal->list = list;
+    journal->checkpoint_interval = checkpoint_interval;
+
+    //* Temporary names used by checkpoints are 4 characters longer.
+    _LOG_FAIL_CHECK_(_ListJournal_name(journal->base_name, base_name, ".ckpt.tmp"),
+                     "error", ERROR_REPORTS, return, err_code, ENAMETOOLONG);
+    _ListJournal_name(journal->base_name, base_name, "");
+
+    journal->group_capacity = sizeof(_ListJournalBlock) + LIST_JOURNAL_RECORD_SIZE;
+    if (journal->group_capacity < group_size) journal->group_capacity = group_size;
+
+    journal->group = (unsigned char*) calloc(journal->group_capacity, 1);
+    _LOG_FAIL_CHECK_(journal->group, "error", ERROR_REPORTS, return, err_code, ENOMEM);
+
+    journal->group_used = sizeof(_ListJournalBlock);
+
+    int error = 0;
+    ListJournal_checkpoint(journal, &error);
+    _LOG_FAIL_CHECK_(error == 0, "error", ERROR_REPORTS, {
+        free(journal->group);
+        journal->group = NULL;
+        return;
+    }, err_code, error);
+
+    list->extras->observer = _ListJournal_observe;
+    list->extras->observer_ctx = journal;
+}
+
+void ListJournal_dtor(ListJournal* const journal, int* const err_code) {
+    _LOG_FAIL_CHECK_(check_ptr(journal), "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    _ListExtras* extras = journal->list ? journal->list->extras : NULL;
+    if (extras && extras->observer_ctx == journal) {
+        extras->observer = NULL;
+        extras->observer_ctx = NULL;
+    }
+
+    ListJournal_commit(journal, err_code);
+
+    if (journal->fd != -1) close(journal->fd);
+    free(journal->group);
+
+    *journal = ListJournal {};
+}
+
+void ListJournal_commit(ListJournal* const journal, int* const err_code) {
+    _LOG_FAIL_CHECK_(check_ptr(journal), "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(journal->error == 0, "error", ERROR_REPORTS, return, err_code, journal->error);
+
+    if (journal->group_count == 0) return;
+
+    _ListJournalBlock block = {};
+    block.size = (uint32_t)(journal->group_used - sizeof(block));
+    block.count = (uint32_t) journal->group_count;
+    block.checksum = get_simple_hash(&block, &block.checksum);
+    block.checksum = get_simple_hash(journal->group + sizeof(block), journal->group + journal->group_used, block.checksum);
+
+    memcpy(journal->group, &block, sizeof(block));
+
+    bool written = _ListJournal_write_all(journal->fd, journal->group, journal->group_used) && fdatasync(journal->fd) == 0;
+
+    journal->group_used = sizeof(block);
+    journal->group_count = 0;
+
+    _LOG_FAIL_CHECK_(written, "error", ERROR_REPORTS, {
+        journal->error = FILE_ERROR;
+        return;
+    }, err_code, FILE_ERROR);
+}
+
+void ListJournal_checkpoint(ListJournal* const journal, int* const err_code) {
+    _LOG_FAIL_CHECK_(check_ptr(journal), "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    char checkpoint_name[LIST_FILE_NAME_SIZE] = "";
+    char log_name[LIST_FILE_NAME_SIZE] = "";
+    char temp_name[LIST_FILE_NAME_SIZE] = "";
+    _LOG_FAIL_CHECK_(_ListJournal_name(checkpoint_name, journal->base_name, ".ckpt") &&
+                     _ListJournal_name(log_name, journal->base_name, ".wal") &&
+                     _ListJournal_name(temp_name, journal->base_name, ".wal.tmp"),
+                     "error", ERROR_REPORTS, return, err_code, ENAMETOOLONG);
+
+    //* Ids only have to differ from the ones of older logs, which may still be on the disk after a crash.
+    timespec moment = {};
+    clock_gettime(CLOCK_REALTIME, &moment);
+    uint64_t checkpoint = (uint64_t)moment.tv_sec * 1000000000ull + (uint64_t)moment.tv_nsec;
+    if (checkpoint <= journal->checkpoint) checkpoint = journal->checkpoint + 1;
+
+    //* Until the new log replaces the old one, its id does not match the checkpoint and it is ignored.
+    int error = 0;
+    _List_save(journal->list, checkpoint_name, checkpoint, &error);
+    _LOG_FAIL_CHECK_(error == 0, "error", ERROR_REPORTS, return, err_code, error);
+
+    journal->checkpoint = checkpoint;
+    journal->records = 0;
+    journal->group_used = sizeof(_ListJournalBlock);
+    journal->group_count = 0;
+
+    if (journal->fd != -1) close(journal->fd);
+    journal->fd = open(temp_name, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    _LOG_FAIL_CHECK_(journal->fd != -1, "error", ERROR_REPORTS, return, err_code, FILE_ERROR);
+
+    _ListJournalHeader header = {};
+    header.magic = LIST_JOURNAL_MAGIC;
+    header.version = LIST_JOURNAL_VERSION;
+    header.elem_size = sizeof(list_elem_t);
+    header.checkpoint = checkpoint;
+    header.header_hash = _ListJournal_header_hash(&header);
+
+    bool written = _ListJournal_write_all(journal->fd, &header, sizeof(header)) && fsync(journal->fd) == 0 &&
+                   rename(temp_name, log_name) == 0;
+
+    _LOG_FAIL_CHECK_(written, "error", ERROR_REPORTS, {
+        close(journal->fd);
+        journal->fd = -1;
+        unlink(temp_name);
+        return;
+    }, err_code, FILE_ERROR);
+}
+
+/**
+ * @brief Apply records of the block to the list.
+ * 
+ * @param list
+ * @param records
+ * @param block block header
+ * @return false if records do not match the list
+ */
+static bool _List_replay_block(List* const list, const unsigned char* records, const _ListJournalBlock* const block) {
+    const unsigned char* end = records + block->size;
+    int error = 0;
+
+    for (uint32_t id = 0; id < block->count && error == 0; ++id) {
+        if (records >= end) return false;
+
+        uint8_t type = _ListJournal_take<uint8_t>(&records);
+        size_t size = type == LIST_RECORD_INSERT ? LIST_JOURNAL_RECORD_SIZE - 1 :
+                      type == LIST_RECORD_POP    ? sizeof(uint64_t) :
+                      type == LIST_RECORD_ROTATE ? sizeof(uint64_t) :
+                      type == LIST_RECORD_MOVE   ? 2 * sizeof(uint64_t) :
+                      type == LIST_RECORD_SET    ? sizeof(uint64_t) + sizeof(list_elem_t) : 0;
+        if ((size_t)(end - records) < size) return false;
+
+        switch (type) {
+            case LIST_RECORD_INSERT: {
+                list_position_t position = _ListJournal_take<uint64_t>(&records);
+                list_elem_t elem = _ListJournal_take<list_elem_t>(&records);
+                list_position_t result = _ListJournal_take<uint64_t>(&records);
+
+                if (position >= list->capacity || List_insert(list, elem, position, &error) != result) return false;
+                break;
+            }
+            case LIST_RECORD_POP: {
+                list_position_t position = _ListJournal_take<uint64_t>(&records);
+
+                if (position == 0 || position >= list->capacity || !_List_is_occupied(list, position)) return false;
+                List_pop(list, position, &error);
+                break;
+            }
+            case LIST_RECORD_MOVE: {
+                list_position_t cell = _ListJournal_take<uint64_t>(&records);
+                list_position_t position = _ListJournal_take<uint64_t>(&records);
+
+                if (cell == 0 || cell >= list->capacity || position >= list->capacity || !_List_is_occupied(list, cell))
+                    return false;
+                List_move(list, cell, position, &error);
+                break;
+            }
+            case LIST_RECORD_SET: {
+                list_position_t position = _ListJournal_take<uint64_t>(&records);
+                list_elem_t elem = _ListJournal_take<list_elem_t>(&records);
+
+                if (position == 0 || position >= list->capacity || !_List_is_occupied(list, position)) return false;
+                List_set(list, position, elem, &error);
+                break;
+            }
+            case LIST_RECORD_LINEARIZE:
+                List_linearize(list, &error);
+                break;
+            case LIST_RECORD_REVERSE:
+                List_reverse(list, &error);
+                break;
+            case LIST_RECORD_ROTATE: {
+                uint64_t steps = _ListJournal_take<uint64_t>(&records);
+
+                if (steps == 0 || steps >= list->size) return false;
+                List_rotate(list, (int) steps, &error);
+                break;
+            }
+#ifndef LIST_NO_ARITHMETIC
+            case LIST_RECORD_SORT:
+                List_sort(list, &error);
+                break;
+#endif
+            default: return false;
+        }
+    }
+
+    return error == 0 && records == end;
+}
+
+list_report_t List_recover(List* const list, const char* base_name, int* const err_code) {
+    _LOG_FAIL_CHECK_(check_ptr(list), "error", ERROR_REPORTS, return LIST_NULL, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(base_name,       "error", ERROR_REPORTS, return LIST_INV_FILE, err_code, EFAULT);
+
+    char checkpoint_name[LIST_FILE_NAME_SIZE] = "";
+    char log_name[LIST_FILE_NAME_SIZE] = "";
+    _LOG_FAIL_CHECK_(_ListJournal_name(checkpoint_name, base_name, ".ckpt") && _ListJournal_name(log_name, base_name, ".wal"),
+                     "error", ERROR_REPORTS, return LIST_INV_FILE, err_code, ENAMETOOLONG);
+
+    uint64_t checkpoint = 0;
+    list_report_t report = _List_load(list, checkpoint_name, &checkpoint, err_code);
+    if (report) return report;
+
+    int fd = open(log_name, O_RDONLY);
+    if (fd == -1) return 0;
+
+    _ListJournalHeader header = {};
+    bool matches = _ListJournal_read_all(fd, &header, sizeof(header)) &&
+                   header.magic == LIST_JOURNAL_MAGIC && header.version == LIST_JOURNAL_VERSION &&
+                   header.elem_size == sizeof(list_elem_t) && header.checkpoint == checkpoint &&
+                   header.header_hash == _ListJournal_header_hash(&header);
+
+    unsigned char* records = NULL;
+    size_t records_capacity = 0;
+    bool consistent = true;
+
+    _ListJournalBlock block = {};
+    while (matches && consistent && _ListJournal_read_all(fd, &block, sizeof(block))) {
+        if (block.size > records_capacity) {
+            unsigned char* new_records = (unsigned char*) realloc(records, block.size);
+            if (!new_records) {
+                consistent = false;
+                break;
+            }
+            records = new_records;
+            records_capacity = block.size;
+        }
+
+        //* Blocks that did not reach the disk completely were not committed, the log ends before them.
+        if (!_ListJournal_read_all(fd, records, block.size)) break;
+
+        hash_t checksum = get_simple_hash(&block, &block.checksum);
+        if (get_simple_hash(records, records + block.size, checksum) != block.checksum) break;
+
+        consistent = _List_replay_block(list, records, &block);
+    }
+
+    free(records);
+    close(fd);
+
+    _LOG_FAIL_CHECK_(consistent, "error", ERROR_REPORTS, {
+        List_dtor(list);
+        return LIST_INV_FILE;
+    }, err_code, EILSEQ);
+
+    return 0;
+}
+
+#endif
@@ -0,0 +1,144 @@
+/**
+ * @file listjournal_.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Write-ahead operation journal for listworks lists.
+ * @version 0.1
+ * @date 2022-11-14
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#ifndef LISTJOURNAL_H
+#define LISTJOURNAL_H
+
+#include "listworks_.h"
+#include "list_config.h"
+
+//* Journal of the list consists of two files:
+//*   <base>.ckpt - list file (see List_save()) with the checkpoint id as its tag,
+//*   <base>.wal  - _ListJournalHeader with the same checkpoint id followed by record blocks.
+//* Every block is a _ListJournalBlock followed by packed records:
+//*   insert    - [type][position][element][resulting position],
+//*   pop       - [type][position],
+//*   linearize - [type],
+//*   sort      - [type],
+//*   move      - [type][moved position][position],
+//*   set       - [type][position][element],
+//*   reverse   - [type],
+//*   rotate    - [type][steps].
+//* Blocks are appended and synced as a whole, so a torn block can only be the last one.
+
+enum _ListJournalRecordType {
+    LIST_RECORD_INSERT    = 1,
+    LIST_RECORD_POP       = 2,
+    LIST_RECORD_LINEARIZE = 3,
+    LIST_RECORD_SORT      = 4,
+    LIST_RECORD_MOVE      = 5,
+    LIST_RECORD_SET       = 6,
+    LIST_RECORD_REVERSE   = 7,
+    LIST_RECORD_ROTATE    = 8,
+};
+
+//* Max size of one record.
+const size_t LIST_JOURNAL_RECORD_SIZE = 1 + sizeof(uint64_t) + sizeof(list_elem_t) + sizeof(uint64_t);
+
+/**
+ * @brief Header of the log file.
+ * 
+ */
+struct _ListJournalHeader {
+    uint64_t magic = 0;
+    uint32_t version = 0;
+    uint32_t elem_size = 0;
+    uint64_t checkpoint = 0;    // Id of the checkpoint the log continues.
+    hash_t header_hash = 0;     // Hash of all the fields above.
+};
+
+/**
+ * @brief Header of the group of records.
+ * 
+ */
+struct _ListJournalBlock {
+    uint32_t size = 0;          // Size of the records in bytes.
+    uint32_t count = 0;         // Number of records.
+    hash_t checksum = 0;        // Hash of the fields above and the records.
+};
+
+/**
+ * @brief Journal recording changes of the list.
+ * 
+ */
+struct ListJournal {
+    List* list = NULL;
+    int fd = -1;                        // Log file.
+    char base_name[LIST_FILE_NAME_SIZE] = "";
+
+    unsigned char* group = NULL;        // Block being filled (starts with space for _ListJournalBlock).
+    size_t group_used = 0;
+    size_t group_capacity = 0;
+    size_t group_count = 0;             // Number of records in the block.
+
+    size_t records = 0;                 // Records logged since the last checkpoint.
+    size_t checkpoint_interval = 0;     // Number of records to take checkpoints after (0 to never take them automatically).
+    uint64_t checkpoint = 0;            // Id of the last checkpoint.
+
+    int error = 0;                      // First error met while logging (list changes can not report it).
+};
+
+/**
+ * @brief Start journaling the list.
+ * 
+ * @note Takes an initial checkpoint. Records reach the disk in groups, so a crash
+ *       loses changes made after the last ListJournal_commit() or group overflow.
+ *       In-place modification of elements (List_for_each()) and List_remove_if() trigger a checkpoint.
+ * 
+ * @param journal journal to initialize
+ * @param list list to watch (must not have another observer)
+ * @param base_name name prefix of journal files
+ * @param checkpoint_interval number of records to take checkpoints after (0 to never take them automatically)
+ * @param group_size size of the group commit buffer in bytes
+ * @param err_code variable to use as errno
+ */
+void ListJournal_ctor(ListJournal* const journal, List* const list, const char* base_name,
+                      const size_t checkpoint_interval = 0, const size_t group_size = LIST_JOURNAL_GROUP_SIZE,
+                      int* const err_code = NULL);
+
+/**
+ * @brief Commit buffered records and stop journaling.
+ * 
+ * @param journal
+ * @param err_code variable to use as errno
+ */
+void ListJournal_dtor(ListJournal* const journal, int* const err_code = NULL);
+
+/**
+ * @brief Write buffered records into the log and wait for them to reach the disk.
+ * 
+ * @param journal
+ * @param err_code variable to use as errno
+ */
+void ListJournal_commit(ListJournal* const journal, int* const err_code = NULL);
+
+/**
+ * @brief Save the whole list and start a new empty log.
+ * 
+ * @param journal
+ * @param err_code variable to use as errno
+ */
+void ListJournal_checkpoint(ListJournal* const journal, int* const err_code = NULL);
+
+/**
+ * @brief Initialize list with the state recorded by the journal.
+ * 
+ * @note Loads the last checkpoint and replays the log over it, so positions of the
+ *       elements are the same as they were in the journaled list. The torn last block is ignored.
+ * 
+ * @param list list to initialize
+ * @param base_name name prefix of journal files
+ * @param err_code variable to use as errno (EILSEQ if the log does not match the checkpoint)
+ * @return list_report_t problems found in the checkpoint (list is left uninitialized if it is not zero)
+ */
+list_report_t List_recover(List* const list, const char* base_name, int* const err_code = NULL);
+
+#endif
@@ -0,0 +1,224 @@
+/**
+ * @file listpolicy.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief .cpp - style file for listworks linearization policies.
+ * @version 0.1
+ * @date 2022-11-20
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+//* Function headers are specified in the file listpolicy_.h
+
+#ifndef LISTPOLICY_HPP
+#define LISTPOLICY_HPP
+
+#include "listpolicy_.h"
+
+#include <stdlib.h>
+
+/**
+ * @brief Get cell the element of the ordered part should lie in.
+ * 
+ * @param list
+ * @param index index of the element
+ * @return list_position_t
+ */
+static inline list_position_t _List_run_cell(const List* const list, const size_t index) {
+    return (list->policy->run_start - 1 + index) % (list->capacity - 1) + 1;
+}
+
+void List_set_policy(List* const list, const ListPolicyConfig* const config, int* const err_code) {
+    _LOG_FAIL_CHECK_(check_ptr(list), "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    if (!config) {
+        free(list->policy);
+        list->policy = NULL;
+        return;
+    }
+
+    _LOG_FAIL_CHECK_(config->mode <= LIST_LINEARIZE_ADAPTIVE,     "error", ERROR_REPORTS, return, err_code, EINVAL);
+    _LOG_FAIL_CHECK_(0 <= config->decay && config->decay <= 1,    "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    if (!list->policy) {
+        list->policy = (_ListPolicy*) calloc(1, sizeof(*list->policy));
+        _LOG_FAIL_CHECK_(list->policy, "error", ERROR_REPORTS, return, err_code, ENOMEM);
+    }
+
+    //* Nothing is known about the order of non-linearized lists yet.
+    *list->policy = _ListPolicy {};
+    list->policy->config = *config;
+}
+
+size_t List_policy_linearize_count(const List* const list) {
+    return list && list->policy ? list->policy->linearize_count : 0;
+}
+
+static void _List_policy_update(List* const list, const list_position_t cell, const bool insertion) {
+    _ListPolicy* policy = list->policy;
+
+    if (list->linearized) {
+        //* Rotated elements lie before the head, so the run ends with the block.
+        policy->run_start = list->buffer->next;
+        policy->run_length = list->size - list->rotation;
+        policy->rebuilding = false;
+        policy->waste = 0;
+    }
+
+    policy->waste *= policy->config.decay;
+
+    if (policy->run_length == 0) return;
+
+    if (cell == 0) {
+        policy->run_length = 0;
+        return;
+    }
+
+    size_t ring = list->capacity - 1;
+    size_t index = (cell + ring - policy->run_start) % ring;
+
+    if (index >= policy->run_length) return;
+
+    if (insertion) {
+        policy->run_length = index + 1;
+    } else if (index == 0) {
+        policy->run_start = policy->run_start % ring + 1;
+        --policy->run_length;
+    } else {
+        policy->run_length = index;
+    }
+}
+
+/**
+ * @brief Put next elements of the list in place.
+ * 
+ * @note Makes the list linearized once all elements are in place.
+ * 
+ * @param list non-empty list with the policy
+ * @param budget max number of elements to process
+ */
+static void _List_policy_step(List* const list, size_t budget) {
+    _ListPolicy* policy = list->policy;
+    _ListCell* buffer = list->buffer;
+
+    if (policy->run_length == 0) policy->run_start = buffer->next;
+
+    list_position_t last = policy->run_length ? _List_run_cell(list, policy->run_length - 1) : 0;
+    size_t ring = list->capacity - 1;
+
+    for (; budget > 0 && policy->run_length < list->size; --budget) {
+        list_position_t element = buffer[last].next;
+        list_position_t target = _List_run_cell(list, policy->run_length);
+
+        //* Target cell is either free or holds one of the elements after the ordered part.
+        //* Lazy cells are linked into the free cell ring first, so the list stays valid between steps.
+        if (element != target) {
+            if (_List_is_lazy(list, target)) _List_materialize(list, (target + ring - list->lazy_begin) % ring + 1);
+
+            bool target_free = !_List_is_occupied(list, target);
+            list_position_t changed[6] = { element, buffer[element].prev, buffer[element].next,
+                                           target,  buffer[target].prev,  buffer[target].next };
+
+            //* Free target takes the place of the element between the same neighbors.
+            _List_checksum_cells(list, changed, target_free ? 3 : 6, false);
+
+            if (target_free) {
+                _List_mark_cell(list, target, true);
+                _List_mark_cell(list, element, false);
+                changed[0] = target;
+            }
+
+            _List_swap_cells(buffer, element, target);
+            _List_checksum_cells(list, changed, target_free ? 3 : 6, true);
+            if (list->sorted) _List_sorted_swap(list, element, target);
+            if (list->first_empty == target) list->first_empty = element;
+        }
+
+        last = target;
+        ++policy->run_length;
+    }
+
+    if (policy->run_length < list->size) return;
+
+    //* Free cells are the ones after the last element, they make the lazy region.
+    list->first_empty = 0;
+    list->lazy_begin = _List_run_cell(list, list->size % ring);
+    list->lazy_count = ring - list->size;
+    list->linearized = true;
+    policy->rebuilding = false;
+
+    _LIST_COUNT_(list, LIST_COUNTER_LINEARIZE, 1);
+}
+
+static void _List_policy_prepare(List* const list) {
+    _ListPolicy* policy = list->policy;
+
+    if (policy->rebuilding) {
+        _List_policy_step(list, policy->config.step_budget);
+        return;
+    }
+
+    if (policy->config.mode == LIST_LINEARIZE_NEVER) return;
+
+    double rebuild_cost = policy->config.move_cost * (double)(list->size - policy->run_length) +
+                          (double)(list->capacity - list->size);
+
+    if (policy->config.mode == LIST_LINEARIZE_ADAPTIVE && policy->waste < rebuild_cost) return;
+
+    policy->waste = 0;
+    ++policy->linearize_count;
+
+    if (policy->config.step_budget == 0 || _List_observer(list)) {
+        List_linearize(list);
+        return;
+    }
+
+    policy->rebuilding = true;
+    _List_policy_step(list, policy->config.step_budget);
+}
+
+static list_position_t _List_policy_find(List* const list, const int index) {
+    _ListPolicy* policy = list->policy;
+    _ListCell* buffer = list->buffer;
+
+    size_t target = index >= 0 ? (size_t)index : list->size - (size_t)(-(long long)index);
+
+    if (target < policy->run_length) {
+        _LIST_COUNT_(list, LIST_COUNTER_FAST_PATH, 1);
+        return _List_run_cell(list, target);
+    }
+
+    //* Walk from the last ordered element or from the tail, whichever is closer.
+    size_t forward_steps = target + 1 - policy->run_length;
+    size_t backward_steps = list->size - target;
+
+    list_position_t current = policy->run_length ? _List_run_cell(list, policy->run_length - 1) : 0;
+    size_t scattered_steps = 0;
+
+    if (forward_steps <= backward_steps) {
+        for (size_t step = 0; step < forward_steps; ++step) {
+            list_position_t next = buffer[current].next;
+            if (next != current + 1) ++scattered_steps;
+            current = next;
+        }
+    } else {
+        current = 0;
+        for (size_t step = 0; step < backward_steps; ++step) {
+            list_position_t prev = buffer[current].prev;
+            if (prev + 1 != current) ++scattered_steps;
+            current = prev;
+        }
+    }
+
+    size_t steps = forward_steps <= backward_steps ? forward_steps : backward_steps;
+
+    _LIST_COUNT_(list, LIST_COUNTER_SLOW_PATH, 1);
+    _LIST_COUNT_(list, LIST_COUNTER_FIND_STEPS, (unsigned long long)steps);
+
+    policy->waste += (double)steps + (policy->config.scattered_step_cost - 1) * (double)scattered_steps;
+
+    return current;
+}
+
+#endif
@@ -0,0 +1,103 @@
+/**
+ * @file listpolicy_.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Automatic linearization policies for listworks lists.
+ * @version 0.1
+ * @date 2022-11-20
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#ifndef LISTPOLICY_H
+#define LISTPOLICY_H
+
+#include "listworks_.h"
+
+//* With a policy attached the list remembers how many of its first elements still lie in consecutive cells
+//* after it stops being linearized, so List_find_position() gets them without following links
+//* and walks to the rest from the last of them.
+//*
+//* Policies linearize lists (completely or step by step) inside List_find_position() before looking up the position,
+//* so positions returned by earlier calls may lead to other elements after it.
+
+enum ListLinearizeMode {
+    LIST_LINEARIZE_NEVER,       // Leave List_linearize() calls to the user.
+    LIST_LINEARIZE_ALWAYS,      // Linearize before every lookup in the non-linearized list.
+    LIST_LINEARIZE_ADAPTIVE,    // Linearize when lookups wasted more than linearization would cost.
+};
+
+/**
+ * @brief Parameters of the linearization policy.
+ * 
+ * @note Costs are measured in sequential link steps (following a link to the next cell of the buffer).
+ */
+struct ListPolicyConfig {
+    ListLinearizeMode mode = LIST_LINEARIZE_ADAPTIVE;
+    size_t step_budget = 0;             // Max elements put in place per lookup (0 to linearize the whole list at once).
+    double move_cost = 8;               // Cost of putting one element in place.
+    double scattered_step_cost = 4;     // Cost of following a link to a distant cell.
+    double decay = 0.99;                // Part of the wasted lookup cost remembered after every list modification.
+};
+
+/**
+ * @brief Policy state attached to the list.
+ * 
+ */
+struct _ListPolicy {
+    ListPolicyConfig config = {};
+
+    list_position_t run_start = 0;      // Cell of the first element.
+    size_t run_length = 0;              // Number of first elements lying in consecutive cells starting with run_start.
+
+    double waste = 0;                   // Decayed cost of lookups that had to follow links.
+    bool rebuilding = false;            // Incremental linearization is in progress.
+    size_t linearize_count = 0;         // Number of linearizations started by the policy.
+};
+
+/**
+ * @brief Attach linearization policy to the list (resets state of the previous one).
+ * 
+ * @note Lists with observers (list journals) are always linearized at once,
+ *       as observers can only replay complete linearizations.
+ * 
+ * @param list
+ * @param config policy parameters (NULL to detach the policy)
+ * @param err_code variable to use as errno
+ */
+void List_set_policy(List* const list, const ListPolicyConfig* const config, int* const err_code = NULL);
+
+/**
+ * @brief Get number of linearizations the policy of the list has started.
+ * 
+ * @param list
+ * @return size_t (0 if the list has no policy)
+ */
+size_t List_policy_linearize_count(const List* const list);
+
+/**
+ * @brief Update the ordered part of the list before the operation makes it non-linearized.
+ * 
+ * @param list list with the policy
+ * @param cell cell the element is inserted after or the popped cell
+ * @param insertion true for insertions, false for pops
+ */
+static void _List_policy_update(List* const list, const list_position_t cell, const bool insertion);
+
+/**
+ * @brief Continue (or start if it is time to) linearization of the non-linearized list.
+ * 
+ * @param list non-empty list with the policy
+ */
+static void _List_policy_prepare(List* const list);
+
+/**
+ * @brief Find position of the element in the non-linearized list using its ordered part.
+ * 
+ * @param list non-empty list with the policy
+ * @param index valid index of the element
+ * @return list_position_t
+ */
+static list_position_t _List_policy_find(List* const list, const int index);
+
+#endif
@@ -19,6 +19,9 @@ enum ListStatus {
     LIST_NULL_CONTENT =     1 << 2,
     LIST_INV_FREE =         1 << 3,
     LIST_INV_CONNECTIONS =  1 << 4,
+    LIST_INV_FILE =         1 << 5,
+    LIST_INV_ORDER =        1 << 6,
+    LIST_INV_CHECKSUM =     1 << 7,
 };
 
 static const char* const LIST_STATUS_DESCR[] = {
@@ -27,6 +30,9 @@ static const char* const LIST_STATUS_DESCR[] = {
     "List buffer pointer was invalid.",
     "List pointer to the first empty cell was invalid.",
     "List element connections were invalid.",
+    "List file header was invalid or the file was not closed properly.",
+    "Sorted list elements or their skip index were out of order.",
+    "List links or contents did not match the list checksum.",
 };
 
 #endif
\ No newline at end of file
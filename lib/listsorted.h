@@ -0,0 +1,467 @@
+/**
+ * @file listsorted.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief .cpp - style file for listworks sorting and sorted container mode.
+ * @version 0.1
+ * @date 2022-11-24
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+//* Function headers are specified in the file listsorted_.h
+
+#ifndef LISTSORTED_HPP
+#define LISTSORTED_HPP
+
+#include "listsorted_.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Take unused node of the skip index.
+ * 
+ * @param index
+ * @return node id (0 if there is no memory for it)
+ */
+static size_t _List_skip_take_node(_ListSkipIndex* const index) {
+    size_t node = index->free_node;
+
+    if (node != 0) {
+        index->free_node = index->nodes[node].next[0];
+    } else {
+        if (index->used_nodes == index->node_capacity) {
+            size_t capacity = index->node_capacity * 2;
+            _ListSkipNode* nodes = (_ListSkipNode*) realloc(index->nodes, capacity * sizeof(*nodes));
+            if (!nodes) return 0;
+
+            index->nodes = nodes;
+            index->node_capacity = capacity;
+        }
+
+        node = index->used_nodes++;
+    }
+
+    index->nodes[node] = _ListSkipNode {};
+    return node;
+}
+
+#ifndef LIST_NO_ARITHMETIC
+
+/**
+ * @brief Merge two sorted chains of cells linked through their next links.
+ * 
+ * @note Elements of the first chain go first among equal ones.
+ * 
+ * @param list
+ * @param first first cell of the chain of older elements (chains end with 0)
+ * @param second first cell of the chain of newer elements
+ * @return first cell of the merged chain
+ */
+static list_position_t _List_merge_runs(List* const list, list_position_t first, list_position_t second) {
+    _ListCell* buffer = list->buffer;
+    list_position_t head = 0;
+    list_position_t* tail_link = &head;
+
+    while (first != 0 && second != 0) {
+        if (_List_elem(list, second) < _List_elem(list, first)) {
+            *tail_link = second;
+            tail_link = &buffer[second].next;
+            second = buffer[second].next;
+        } else {
+            *tail_link = first;
+            tail_link = &buffer[first].next;
+            first = buffer[first].next;
+        }
+    }
+
+    *tail_link = first != 0 ? first : second;
+    return head;
+}
+
+/**
+ * @brief Make next links of the reversed list lead in its order.
+ * 
+ * @note Linearized lists swap elements of the opposite cells instead, so they stay linearized.
+ * 
+ * @param list reversed list
+ */
+static void _List_straighten(List* const list) {
+    _ListCell* buffer = list->buffer;
+
+    if (list->linearized) {
+        for (size_t pair = 0; pair < list->size / 2; ++pair) {
+            std::swap(buffer[_List_linear_cell(list, pair)].content, buffer[_List_linear_cell(list, list->size - 1 - pair)].content);
+        }
+    } else {
+        list_position_t cell = 0;
+        do {
+            std::swap(buffer[cell].next, buffer[cell].prev);
+            cell = buffer[cell].prev;
+        } while (cell != 0);
+
+        if (list->policy) _List_policy_update(list, 0, true);
+    }
+
+    list->reversed = false;
+    _List_checksum_rebuild(list);
+}
+
+/**
+ * @brief Sort the list links and rebuild the skip index if the order changed.
+ * 
+ * @note Reversed lists are straightened first, as merges follow next links.
+ * 
+ * @param list valid list
+ * @return true if the order or the cells of elements changed
+ */
+static bool _List_sort(List* const list) {
+    _ListCell* buffer = list->buffer;
+
+    bool straightened = list->reversed;
+    if (straightened) _List_straighten(list);
+
+    bool sorted = true;
+    for (list_position_t cell = buffer->next; sorted && cell != 0 && buffer[cell].next != 0; cell = buffer[cell].next) {
+        if (_List_elem(list, buffer[cell].next) < _List_elem(list, cell)) sorted = false;
+    }
+
+    if (sorted) {
+        if (straightened && list->sorted) _List_sorted_rebuild(list);
+        return straightened;
+    }
+
+    //* Runs work like a binary counter: run i is either empty or holds 2^i elements, all of them older
+    //* than elements of the runs below, so merging older runs first keeps the sort stable.
+    list_position_t runs[LIST_SORT_RUNS] = {};
+    size_t run_count = 0;
+
+    list_position_t cell = buffer->next;
+    while (cell != 0) {
+        list_position_t next = buffer[cell].next;
+        buffer[cell].next = 0;
+
+        list_position_t run = cell;
+        size_t run_id = 0;
+        for (; run_id < run_count && runs[run_id] != 0; ++run_id) {
+            run = _List_merge_runs(list, runs[run_id], run);
+            runs[run_id] = 0;
+        }
+
+        runs[run_id] = run;
+        if (run_id == run_count) ++run_count;
+
+        cell = next;
+    }
+
+    list_position_t head = 0;
+    for (size_t run_id = 0; run_id < run_count; ++run_id) {
+        if (runs[run_id] != 0) head = _List_merge_runs(list, runs[run_id], head);
+    }
+
+    //* Merges only follow next links, so prev links are restored afterwards.
+    list_position_t prev = 0;
+    buffer->next = head;
+    for (cell = head; cell != 0; cell = buffer[cell].next) {
+        buffer[cell].prev = prev;
+        prev = cell;
+    }
+    buffer->prev = prev;
+    _List_checksum_rebuild(list);
+
+    if (list->linearized) _LIST_COUNT_(list, LIST_COUNTER_DELINEARIZE, 1);
+    if (list->policy) _List_policy_update(list, 0, true);
+    list->linearized = false;
+    list->rotation = 0;
+
+    if (list->sorted) _List_sorted_rebuild(list);
+
+    return true;
+}
+
+/**
+ * @brief Pick number of express levels for the new node of the skip index.
+ * 
+ * @param index
+ * @return size_t (0 for three elements out of four)
+ */
+static size_t _List_skip_levels(_ListSkipIndex* const index) {
+    uint64_t random = index->random;
+    random ^= random << 13;
+    random ^= random >> 7;
+    random ^= random << 17;
+    index->random = random;
+
+    size_t levels = 0;
+    for (; levels < LIST_SKIP_LEVELS && (random & 3) == 0; random >>= 2) ++levels;
+
+    return levels;
+}
+
+/**
+ * @brief Find the last cell of the sorted list holding element less than the value (or not greater than it).
+ * 
+ * @param list sorted list
+ * @param value
+ * @param inclusive true to find the last element not greater than the value
+ * @param[out] path last node before the found cell on every level (may be NULL)
+ * @return list_position_t (0 if there is no such element)
+ */
+static list_position_t _List_sorted_find(const List* const list, const list_elem_t value, const bool inclusive,
+                                         size_t* const path) {
+    const _ListSkipIndex* index = list->sorted;
+    const _ListCell* buffer = list->buffer;
+
+    size_t node = 0;
+    for (size_t level = index->levels; level-- > 0;) {
+        for (size_t next = index->nodes[node].next[level]; next != 0; next = index->nodes[node].next[level]) {
+            const list_elem_t& elem = _List_elem(list, index->nodes[next].cell);
+            if (inclusive ? value < elem : !(elem < value)) break;
+            node = next;
+        }
+
+        if (path) path[level] = node;
+    }
+
+    list_position_t cell = index->nodes[node].cell;
+    for (list_position_t next = buffer[cell].next; next != 0; next = buffer[cell].next) {
+        if (inclusive ? value < _List_elem(list, next) : !(_List_elem(list, next) < value)) break;
+        cell = next;
+    }
+
+    return cell;
+}
+
+void List_sort(List* const list, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_SORT);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    if (!_List_sort(list)) return;
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return, err_code, EAGAIN);
+    _List_notify(list, LIST_EVENT_SORT);
+}
+
+void List_set_sorted(List* const list, const bool enable, int* const err_code) {
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    if (!enable) {
+        if (!list->sorted) return;
+
+        _List_sorted_dtor(list);
+        return;
+    }
+
+    if (list->sorted) return;
+
+    _ListSkipIndex* index = (_ListSkipIndex*) calloc(1, sizeof(*index));
+    _LOG_FAIL_CHECK_(index, "error", ERROR_REPORTS, return, err_code, ENOMEM);
+
+    index->node_capacity = 64;
+    index->nodes = (_ListSkipNode*) calloc(index->node_capacity, sizeof(*index->nodes));
+    index->node_of = (size_t*) calloc(list->capacity, sizeof(*index->node_of));
+    index->random = 0x9E3779B97F4A7C15;
+
+    _LOG_FAIL_CHECK_(index->nodes && index->node_of, "error", ERROR_REPORTS, {
+        free(index->nodes);
+        free(index->node_of);
+        free(index);
+        return;
+    }, err_code, ENOMEM);
+
+    list->sorted = index;
+
+    //* Already sorted lists keep their order, so only the index is built for them.
+    if (_List_sort(list)) _List_notify(list, LIST_EVENT_SORT);
+    else                  _List_sorted_rebuild(list);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return, err_code, EAGAIN);
+}
+
+list_position_t List_insert_sorted(List* const list, const list_elem_t elem, int* const err_code) {
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(list->sorted,            "error", ERROR_REPORTS, return 0, err_code, EINVAL);
+
+    size_t path[LIST_SKIP_LEVELS] = {};
+    list_position_t cell = List_insert(list, elem, _List_sorted_find(list, elem, true, path), err_code);
+    if (cell == 0) return 0;
+
+    _ListSkipIndex* index = list->sorted;
+    size_t levels = _List_skip_levels(index);
+    if (levels == 0) return cell;
+
+    //* Elements left without nodes only make lookups a bit longer.
+    size_t node = _List_skip_take_node(index);
+    if (node == 0) return cell;
+
+    _ListSkipNode* nodes = index->nodes;
+    nodes[node].cell = cell;
+    nodes[node].levels = levels;
+
+    for (size_t level = 0; level < levels; ++level) {
+        nodes[node].next[level] = nodes[path[level]].next[level];
+        nodes[path[level]].next[level] = node;
+    }
+
+    index->node_of[cell] = node;
+    if (index->levels < levels) index->levels = levels;
+
+    return cell;
+}
+
+list_position_t List_lower_bound(List* const list, const list_elem_t value, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_FIND_POSITION);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(list->sorted,            "error", ERROR_REPORTS, return 0, err_code, EINVAL);
+
+    return list->buffer[_List_sorted_find(list, value, false, NULL)].next;
+}
+
+static bool _List_sorted_fits(const List* const list, const list_elem_t elem, const list_position_t position) {
+    const _ListCell* buffer = list->buffer;
+    list_position_t next = buffer[position].next;
+
+    return (position == 0 || !(elem < _List_elem(list, position))) && (next == 0 || !(_List_elem(list, next) < elem));
+}
+
+static void _List_sorted_pop(List* const list, const list_position_t cell) {
+    _ListSkipIndex* index = list->sorted;
+    size_t node = index->node_of[cell];
+    if (node == 0) return;
+
+    //* The search stops before all elements equal to the popped one, the node is among them on every level.
+    size_t path[LIST_SKIP_LEVELS] = {};
+    _List_sorted_find(list, _List_elem(list, cell), false, path);
+
+    _ListSkipNode* nodes = index->nodes;
+    for (size_t level = 0; level < nodes[node].levels; ++level) {
+        size_t prev = path[level];
+        while (nodes[prev].next[level] != node) prev = nodes[prev].next[level];
+        nodes[prev].next[level] = nodes[node].next[level];
+    }
+
+    while (index->levels > 0 && nodes[0].next[index->levels - 1] == 0) --index->levels;
+
+    nodes[node].next[0] = index->free_node;
+    index->free_node = node;
+    index->node_of[cell] = 0;
+}
+
+static void _List_sorted_restore(List* const list) {
+    _List_sort(list);
+}
+
+static bool _List_sorted_check(const List* const list) {
+    const _ListSkipIndex* index = list->sorted;
+    const _ListCell* buffer = list->buffer;
+
+    size_t steps = 0;
+    for (list_position_t cell = buffer->next; cell != 0 && buffer[cell].next != 0; cell = buffer[cell].next) {
+        if (++steps > list->size || _List_elem(list, buffer[cell].next) < _List_elem(list, cell)) return false;
+    }
+
+    if (index->levels > LIST_SKIP_LEVELS) return false;
+
+    for (size_t level = 0; level < index->levels; ++level) {
+        list_position_t prev_cell = 0;
+        steps = 0;
+
+        for (size_t node = index->nodes[0].next[level]; node != 0; node = index->nodes[node].next[level]) {
+            if (node >= index->used_nodes || ++steps > list->size) return false;
+
+            const _ListSkipNode* current = &index->nodes[node];
+            if (current->levels <= level || current->cell == 0 || current->cell >= list->capacity ||
+                index->node_of[current->cell] != node || !_List_is_occupied(list, current->cell)) return false;
+
+            if (prev_cell != 0 && _List_elem(list, current->cell) < _List_elem(list, prev_cell)) return false;
+            prev_cell = current->cell;
+        }
+    }
+
+    return true;
+}
+
+#else
+
+static bool _List_sorted_fits(const List* const list, const list_elem_t elem, const list_position_t position) {
+    SILENCE_UNUSED(list);
+    SILENCE_UNUSED(elem);
+    SILENCE_UNUSED(position);
+    return true;
+}
+
+static void _List_sorted_pop(List* const list, const list_position_t cell) {
+    SILENCE_UNUSED(list);
+    SILENCE_UNUSED(cell);
+}
+
+static void _List_sorted_restore(List* const list) {
+    SILENCE_UNUSED(list);
+}
+
+static bool _List_sorted_check(const List* const list) {
+    SILENCE_UNUSED(list);
+    return true;
+}
+
+#endif
+
+static void _List_sorted_dtor(List* const list) {
+    if (!list->sorted) return;
+
+    free(list->sorted->nodes);
+    free(list->sorted->node_of);
+    free(list->sorted);
+    list->sorted = NULL;
+}
+
+static void _List_sorted_swap(List* const list, const list_position_t alpha, const list_position_t beta) {
+    _ListSkipIndex* index = list->sorted;
+
+    size_t alpha_node = index->node_of[alpha];
+    index->node_of[alpha] = index->node_of[beta];
+    index->node_of[beta] = alpha_node;
+
+    if (index->node_of[alpha] != 0) index->nodes[index->node_of[alpha]].cell = alpha;
+    if (index->node_of[beta] != 0)  index->nodes[index->node_of[beta]].cell = beta;
+}
+
+static void _List_sorted_rebuild(List* const list) {
+    _ListSkipIndex* index = list->sorted;
+
+    memset(index->node_of, 0, list->capacity * sizeof(*index->node_of));
+    index->nodes[0] = _ListSkipNode {};
+    index->used_nodes = 1;
+    index->free_node = 0;
+    index->levels = 0;
+
+    size_t tails[LIST_SKIP_LEVELS] = {};
+    size_t number = 0;
+
+    //* Every 4th element gets a node on the first level, every 16th on the second and so on.
+    for (list_position_t cell = list->buffer->next; cell != 0; cell = list->buffer[cell].next) {
+        size_t levels = 0;
+        for (size_t rest = ++number; levels < LIST_SKIP_LEVELS && rest % 4 == 0; rest /= 4) ++levels;
+
+        if (levels == 0) continue;
+
+        size_t node = _List_skip_take_node(index);
+        if (node == 0) return;
+
+        index->nodes[node].cell = cell;
+        index->nodes[node].levels = levels;
+
+        for (size_t level = 0; level < levels; ++level) {
+            index->nodes[tails[level]].next[level] = node;
+            tails[level] = node;
+        }
+
+        index->node_of[cell] = node;
+        if (index->levels < levels) index->levels = levels;
+    }
+}
+
+#endif
@@ -0,0 +1,160 @@
+/**
+ * @file listsorted_.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Sorting and sorted container mode for listworks lists.
+ * @version 0.1
+ * @date 2022-11-24
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#ifndef LISTSORTED_H
+#define LISTSORTED_H
+
+#include "listworks_.h"
+
+//* Sorted lists keep their elements in non-decreasing order and a skip index over them:
+//* express levels of nodes pointing to list cells (one of every 4 elements on the first level,
+//* one of every 16 on the second and so on), with the list links themselves as the bottom level.
+//* Lookups go down the levels and finish with a few list steps, so they take O(log n) expected time.
+//*
+//* Plain List_insert() calls that would break the order are refused, and elements changed by List_for_each()
+//* are sorted again afterwards. Files and streams do not keep the index, List_set_sorted() builds it again.
+
+//* Max number of express levels of skip indices (enough for 4^12 elements).
+const size_t LIST_SKIP_LEVELS = 12;
+
+//* Number of sorted runs merge sort keeps at once (run i holds 2^i elements).
+const size_t LIST_SORT_RUNS = 64;
+
+/**
+ * @brief Node of the skip index.
+ * 
+ */
+struct _ListSkipNode {
+    list_position_t cell = 0;               // Cell of the indexed element (0 for the head node).
+    size_t levels = 0;                      // Number of express levels the node is linked into.
+    size_t next[LIST_SKIP_LEVELS] = {};     // Next node on every level (0 at the end, free nodes are stacked through next[0]).
+};
+
+/**
+ * @brief Skip index attached to the sorted list.
+ * 
+ */
+struct _ListSkipIndex {
+    _ListSkipNode* nodes = NULL;            // Node 0 is the head linked into every level.
+    size_t node_capacity = 0;
+    size_t used_nodes = 0;                  // Number of nodes ever taken (including the head).
+    size_t free_node = 0;                   // First node of the free node stack (0 if it is empty).
+    size_t* node_of = NULL;                 // Node of every list cell (0 for cells without one).
+    size_t levels = 0;                      // Number of levels holding nodes.
+    uint64_t random = 0;                    // State of the generator of node heights.
+};
+
+#ifndef LIST_NO_ARITHMETIC
+
+/**
+ * @brief Sort list elements in non-decreasing order.
+ * 
+ * @note Stable merge sort over the links (O(n log n) comparisons, no allocations).
+ *       Elements stay in their cells, so the list stops being linearized unless it was already sorted.
+ *       Reversed lists are straightened first (linearized ones swap elements of the opposite cells).
+ * 
+ * @param list
+ * @param err_code variable to use as errno
+ */
+void List_sort(List* const list, int* const err_code = NULL);
+
+/**
+ * @brief Turn sorted container mode of the list on or off.
+ * 
+ * @note Turning it on sorts the list and builds its skip index (about 40 bytes per element and 8 bytes per cell).
+ * 
+ * @param list
+ * @param enable
+ * @param err_code variable to use as errno
+ */
+void List_set_sorted(List* const list, const bool enable, int* const err_code = NULL);
+
+/**
+ * @brief Insert element into the sorted list keeping it sorted.
+ * 
+ * @note Element is placed after elements equal to it.
+ * 
+ * @param list list in sorted container mode
+ * @param elem element to insert
+ * @param err_code variable to use as errno
+ * @return position of the inserted element
+ */
+list_position_t List_insert_sorted(List* const list, const list_elem_t elem, int* const err_code = NULL);
+
+/**
+ * @brief Find the first element of the sorted list not less than the value.
+ * 
+ * @param list list in sorted container mode
+ * @param value value to search for
+ * @param err_code variable to use as errno
+ * @return position of the element (0 if all elements are less than the value)
+ */
+list_position_t List_lower_bound(List* const list, const list_elem_t value, int* const err_code = NULL);
+
+#endif
+
+/**
+ * @brief Free the skip index of the list (does nothing for lists without one).
+ * 
+ * @param list
+ */
+static void _List_sorted_dtor(List* const list);
+
+/**
+ * @brief Check that the element can be inserted after the position without breaking the order.
+ * 
+ * @param list sorted list
+ * @param elem
+ * @param position
+ * @return true if the list stays sorted
+ */
+static bool _List_sorted_fits(const List* const list, const list_elem_t elem, const list_position_t position);
+
+/**
+ * @brief Remove node of the element from the skip index before the element is popped.
+ * 
+ * @param list sorted list
+ * @param cell cell of the element
+ */
+static void _List_sorted_pop(List* const list, const list_position_t cell);
+
+/**
+ * @brief Exchange index nodes of two cells after their contents were swapped.
+ * 
+ * @param list sorted list
+ * @param alpha
+ * @param beta
+ */
+static void _List_sorted_swap(List* const list, const list_position_t alpha, const list_position_t beta);
+
+/**
+ * @brief Rebuild the skip index after elements were moved to other cells.
+ * 
+ * @param list sorted list
+ */
+static void _List_sorted_rebuild(List* const list);
+
+/**
+ * @brief Sort the list again after its elements were changed in place.
+ * 
+ * @param list sorted list
+ */
+static void _List_sorted_restore(List* const list);
+
+/**
+ * @brief Check order of the elements and consistency of the skip index.
+ * 
+ * @param list sorted list with valid links
+ * @return true if both are fine
+ */
+static bool _List_sorted_check(const List* const list);
+
+#endif
@@ -0,0 +1,321 @@
+/**
+ * @file liststatic.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief .cpp - style file for listworks static lists.
+ * @version 0.1
+ * @date 2022-11-27
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+//* Function headers are specified in the file liststatic_.h
+
+#ifndef LISTSTATIC_HPP
+#define LISTSTATIC_HPP
+
+#include "liststatic_.h"
+
+/**
+ * @brief Get cell the specified number of steps after the cell in the ring of cells [1, capacity).
+ * 
+ * @param cell non-sentinel cell
+ * @param offset
+ * @return list_position_t
+ */
+template <size_t capacity>
+static constexpr list_position_t _StaticList_ring_cell(const list_position_t cell, const size_t offset) {
+    return (cell - 1 + offset) % (capacity - 1) + 1;
+}
+
+/**
+ * @brief Check if the cell holds an element.
+ * 
+ * @param list
+ * @param cell cell of the list
+ * @return true if it is not the sentinel or a free cell
+ */
+template <size_t capacity>
+static constexpr bool _StaticList_is_occupied(const StaticList<capacity>* const list, const list_position_t cell) {
+    return cell != 0 && list->cells[cell].content != LIST_ELEM_POISON;
+}
+
+/**
+ * @brief Check if the cell lies in the lazy region of the list.
+ * 
+ * @param list
+ * @param cell cell of the list
+ * @return true if the cell is free and not stacked
+ */
+template <size_t capacity>
+static constexpr bool _StaticList_is_lazy(const StaticList<capacity>* const list, const list_position_t cell) {
+    return cell != 0 && (cell + (capacity - 1) - list->lazy_begin) % (capacity - 1) < list->lazy_count;
+}
+
+/**
+ * @brief Take cell from the lazy region.
+ * 
+ * @param list list with non-empty lazy region
+ * @param last true to take the last cell of the region, false to take the first one
+ * @return list_position_t
+ */
+template <size_t capacity>
+static constexpr list_position_t _StaticList_take_lazy_cell(StaticList<capacity>* const list, const bool last) {
+    list_position_t cell = last ? _StaticList_ring_cell<capacity>(list->lazy_begin, list->lazy_count - 1) : list->lazy_begin;
+
+    if (!last) list->lazy_begin = _StaticList_ring_cell<capacity>(list->lazy_begin, 1);
+    --list->lazy_count;
+
+    return cell;
+}
+
+/**
+ * @brief Check list fields and links of the sentinel in O(1) time.
+ * 
+ * @param list
+ * @return list_report_t
+ */
+template <size_t capacity>
+static constexpr list_report_t _StaticList_check_fields(const StaticList<capacity>* const list) {
+    if (!list) return LIST_NULL;
+
+    list_report_t report = 0;
+
+    if (list->size >= capacity) report |= LIST_BIG_SIZE;
+
+    if (list->lazy_begin == 0 || list->lazy_begin >= capacity || list->lazy_count >= capacity) return report | LIST_INV_FREE;
+    if (list->first_empty >= capacity || (list->linearized && list->first_empty != 0)) report |= LIST_INV_FREE;
+
+    const _ListStaticCell* cells = list->cells;
+    if (cells->next >= capacity || cells->prev >= capacity) return report | LIST_INV_CONNECTIONS;
+
+    if (cells[cells->next].prev != 0 || cells[cells->prev].next != 0 ||
+        (cells->next == 0) != (list->size == 0)) report |= LIST_INV_CONNECTIONS;
+
+    return report;
+}
+
+/**
+ * @brief Exchange places of two cells keeping both of them in their rings (see _List_swap_cells()).
+ * 
+ * @param cells
+ * @param alpha
+ * @param beta
+ */
+static constexpr void _StaticList_swap_cells(_ListStaticCell* const cells, const list_position_t alpha, const list_position_t beta) {
+    _ListStaticCell alpha_copy = cells[alpha];
+    cells[alpha] = cells[beta];
+    cells[beta] = alpha_copy;
+
+    const list_position_t swapped[2] = { alpha, beta };
+
+    for (list_position_t cell : swapped) {
+        list_position_t* links[2] = { &cells[cell].next, &cells[cell].prev };
+        for (list_position_t* link : links) {
+            if      (*link == alpha) *link = beta;
+            else if (*link == beta)  *link = alpha;
+        }
+    }
+
+    for (list_position_t cell : swapped) {
+        cells[cells[cell].next].prev = cell;
+        cells[cells[cell].prev].next = cell;
+    }
+}
+
+template <size_t capacity>
+constexpr void List_ctor(StaticList<capacity>* const list, int* const err_code) {
+    _LOG_FAIL_CHECK_(list, "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    for (_ListStaticCell& cell : list->cells) cell = _ListStaticCell {};
+
+    list->first_empty = 0;
+    list->lazy_begin = 1;
+    list->lazy_count = capacity - 1;
+    list->size = 0;
+    list->linearized = true;
+}
+
+template <size_t capacity>
+constexpr list_position_t List_insert(StaticList<capacity>* const list, const list_elem_t elem, const list_position_t position,
+                                      int* const err_code) {
+    _LOG_FAIL_CHECK_(_StaticList_check_fields(list) == 0, "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(position == 0 || (position < capacity && _StaticList_is_occupied(list, position)),
+                     "error", ERROR_REPORTS, return 0, err_code, EINVAL);
+    _LOG_FAIL_CHECK_(elem != LIST_ELEM_POISON,            "error", ERROR_REPORTS, return 0, err_code, EINVAL);
+    _LOG_FAIL_CHECK_(list->size + 1 < capacity,           "error", ERROR_REPORTS, return 0, err_code, ENOMEM);
+
+    _ListStaticCell* cells = list->cells;
+    list_position_t cell = 0;
+
+    //* Cells are taken the way List_insert() takes them, so both lists give the same positions.
+    if (list->linearized && (position == 0 || position == cells->prev)) {
+        cell = _StaticList_take_lazy_cell(list, position != cells->prev);
+    } else {
+        list->linearized = false;
+
+        if (list->first_empty) {
+            cell = list->first_empty;
+            list->first_empty = cells[cell].next;
+        } else {
+            cell = _StaticList_take_lazy_cell(list, false);
+        }
+    }
+
+    list_position_t next_nbor = cells[position].next;
+
+    cells[cell].content = elem;
+    cells[cell].next = next_nbor;
+    cells[cell].prev = position;
+    cells[position].next = cell;
+    cells[next_nbor].prev = cell;
+
+    ++list->size;
+
+    _LOG_FAIL_CHECK_(List_status(list) == 0, "error", ERROR_REPORTS, return 0, err_code, EAGAIN);
+
+    return cell;
+}
+
+template <size_t capacity>
+constexpr void List_pop(StaticList<capacity>* const list, const list_position_t position, int* const err_code) {
+    _LOG_FAIL_CHECK_(_StaticList_check_fields(list) == 0, "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(position < capacity,                 "error", ERROR_REPORTS, return, err_code, EINVAL);
+    _LOG_FAIL_CHECK_(list->size > 0,                      "error", ERROR_REPORTS, return, err_code, ENOENT);
+
+    _LOG_FAIL_CHECK_(_StaticList_is_occupied(list, position), "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    _ListStaticCell* cells = list->cells;
+    _ListStaticCell* cell = cells + position;
+
+    cells[cell->prev].next = cell->next;
+    cells[cell->next].prev = cell->prev;
+
+    //* Cells freed at the ends of linearized lists join the lazy region (the tail one goes before it).
+    if (list->linearized && (cell->next == 0 || cell->prev == 0)) {
+        if (cell->next == 0 || list->lazy_count == 0) list->lazy_begin = position;
+        ++list->lazy_count;
+    } else {
+        list->linearized = false;
+
+        cell->next = list->first_empty;
+        list->first_empty = position;
+    }
+
+    cell->content = LIST_ELEM_POISON;
+    --list->size;
+
+    _LOG_FAIL_CHECK_(List_status(list) == 0, "error", ERROR_REPORTS, return, err_code, EAGAIN);
+}
+
+template <size_t capacity>
+constexpr list_elem_t List_get(const StaticList<capacity>* const list, const list_position_t position, int* const err_code) {
+    _LOG_FAIL_CHECK_(_StaticList_check_fields(list) == 0, "error", ERROR_REPORTS, return LIST_ELEM_POISON, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(position < capacity && _StaticList_is_occupied(list, position),
+                     "error", ERROR_REPORTS, return LIST_ELEM_POISON, err_code, EINVAL);
+
+    return list->cells[position].content;
+}
+
+template <size_t capacity>
+constexpr list_position_t List_find_position(const StaticList<capacity>* const list, const int index, int* const err_code) {
+    _LOG_FAIL_CHECK_(_StaticList_check_fields(list) == 0, "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+
+    _LOG_FAIL_CHECK_((-(int)list->size <= index && index < (int)list->size) || list->size == 0,
+                     "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+
+    if (list->size == 0) return 0;
+
+    const _ListStaticCell* cells = list->cells;
+
+    if (list->linearized) {
+        list_position_t count_start = index >= 0 ? cells->next : cells->prev;
+        size_t offset = index >= 0 ? (size_t)index : capacity - 1 - (size_t)(-index - 1);
+
+        return _StaticList_ring_cell<capacity>(count_start, offset % (capacity - 1));
+    }
+
+    list_position_t current = index >= 0 ? cells->next : cells->prev;
+    int steps = index >= 0 ? index : -index - 1;
+
+    for (int step = 0; step < steps; ++step) current = index >= 0 ? cells[current].next : cells[current].prev;
+
+    return current;
+}
+
+template <size_t capacity>
+constexpr void List_linearize(StaticList<capacity>* const list, int* const err_code) {
+    _LOG_FAIL_CHECK_(List_status(list) == 0, "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    _ListStaticCell* cells = list->cells;
+    list_position_t cell = cells->next;
+    size_t index = 0;
+
+    //* Elements go to cells [1, size] one by one, swapping with elements that hold their cells,
+    //* free cells they are moved into are never needed again (see List_linearize()).
+    while (cell != 0) {
+        list_position_t target_spot = (index++) + 1;
+
+        if (cell != target_spot) {
+            if (_StaticList_is_occupied(list, target_spot)) {
+                _StaticList_swap_cells(cells, cell, target_spot);
+            } else {
+                cells[target_spot] = cells[cell];
+                cells[cells[target_spot].next].prev = target_spot;
+                cells[cells[target_spot].prev].next = target_spot;
+                cells[cell].content = LIST_ELEM_POISON;
+            }
+        }
+
+        cell = cells[target_spot].next;
+    }
+
+    cells[0].next = list->size ? 1 : 0;
+    cells[0].prev = list->size;
+    cells[1].prev = 0;
+    cells[list->size].next = 0;
+
+    list->first_empty = 0;
+    list->lazy_begin = list->size + 1 < capacity ? list->size + 1 : 1;
+    list->lazy_count = capacity - 1 - list->size;
+    list->linearized = true;
+
+    _LOG_FAIL_CHECK_(List_status(list) == 0, "error", ERROR_REPORTS, return, err_code, EAGAIN);
+}
+
+template <size_t capacity>
+constexpr list_report_t List_status(const StaticList<capacity>* const list) {
+    list_report_t report = _StaticList_check_fields(list);
+    if (report) return report;
+
+    const _ListStaticCell* cells = list->cells;
+
+    //* Element ring: linked both ways, no free cells, index arithmetic holds for linearized lists.
+    size_t index = 0;
+    list_position_t cell = cells->next;
+
+    for (; cell != 0 && index < capacity; cell = cells[cell].next, ++index) {
+        list_position_t next = cells[cell].next;
+
+        if (next >= capacity || cells[next].prev != cell || !_StaticList_is_occupied(list, cell) ||
+            _StaticList_is_lazy(list, cell)) return report | LIST_INV_CONNECTIONS;
+
+        if (list->linearized && cell != _StaticList_ring_cell<capacity>(cells->next, index)) report |= LIST_INV_CONNECTIONS;
+    }
+
+    if (cell != 0 || index != list->size) report |= LIST_INV_CONNECTIONS;
+
+    //* Stacked free cells and the lazy region hold all other cells.
+    size_t free_cells = 0;
+
+    for (cell = list->first_empty; cell != 0 && free_cells < capacity; cell = cells[cell].next, ++free_cells) {
+        if (cell >= capacity || _StaticList_is_occupied(list, cell) || _StaticList_is_lazy(list, cell))
+            return report | LIST_INV_FREE;
+    }
+
+    if (cell != 0 || free_cells + list->lazy_count + list->size + 1 != capacity) report |= LIST_INV_FREE;
+
+    return report;
+}
+
+#endif
@@ -0,0 +1,131 @@
+/**
+ * @file liststatic_.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Fixed-capacity lists with inline cells usable in constant expressions.
+ * @version 0.1
+ * @date 2022-11-27
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#ifndef LISTSTATIC_H
+#define LISTSTATIC_H
+
+#include "listworks_.h"
+
+//* Static lists keep their cells in the object, so they never allocate and have nothing to destroy.
+//* Every operation is constexpr: lists built by constexpr functions can be stored in constexpr variables
+//* (read-only data), and lookups of such lists can be evaluated at compile time as well.
+//*
+//* Functions are overloads of the List_* ones with the same position semantics: cell 0 is the sentinel,
+//* positions are cell indices, and linearized lists find positions by index arithmetic.
+//* Free cells are stacked through their next links or lie in the lazy region (as in List).
+//*
+//* Constant evaluation needs literal elements and LIST_ELEM_POISON usable in constant expressions
+//* (integral constants or constexpr variables). Failed checks call the logger, so they are compile errors there.
+
+/**
+ * @brief Static list cell.
+ * 
+ * @note Free cells are poisoned, so the content tells if the cell holds an element.
+ */
+struct _ListStaticCell {
+    list_elem_t content = LIST_ELEM_POISON;
+    list_position_t next = 0;
+    list_position_t prev = 0;
+};
+
+/**
+ * @brief Fixed-capacity list data structure (a default-initialized one is an empty list).
+ * 
+ * @tparam capacity max number of elements the list can hold +1 empty element
+ */
+template <size_t capacity>
+struct StaticList {
+    static_assert(capacity > 1, "Static lists need space for the sentinel and an element.");
+
+    //* Named constant, as GCC 12 fails to fold `capacity - 1` in default member initializers during constant evaluation.
+    static constexpr size_t ring = capacity - 1; // Number of cells besides the sentinel.
+
+    _ListStaticCell cells[capacity];
+    list_position_t first_empty = 0;        // First cell of the free cell stack (0 if it is empty).
+    list_position_t lazy_begin = 1;         // First cell of the lazy region.
+    size_t lazy_count = ring;               // Number of cells in the lazy region.
+    size_t size = 0;
+    bool linearized = true;
+};
+
+/**
+ * @brief Initialize the static list (make it empty).
+ * 
+ * @param list list to initialize
+ * @param err_code variable to use as errno
+ */
+template <size_t capacity>
+constexpr void List_ctor(StaticList<capacity>* const list, int* const err_code = NULL);
+
+/**
+ * @brief Insert element into the list.
+ * 
+ * @param list
+ * @param elem element to insert
+ * @param position which element to insert after
+ * @param err_code variable to use as errno
+ * @return position of the inserted element (0 on failure)
+ */
+template <size_t capacity>
+constexpr list_position_t List_insert(StaticList<capacity>* const list, const list_elem_t elem, const list_position_t position,
+                                      int* const err_code = NULL);
+
+/**
+ * @brief Remove element from the list.
+ * 
+ * @param list
+ * @param position position of the element
+ * @param err_code variable to use as errno
+ */
+template <size_t capacity>
+constexpr void List_pop(StaticList<capacity>* const list, const list_position_t position, int* const err_code = NULL);
+
+/**
+ * @brief Get element at the position.
+ * 
+ * @param list
+ * @param position position of the element
+ * @param err_code variable to use as errno
+ * @return the element (LIST_ELEM_POISON on failure)
+ */
+template <size_t capacity>
+constexpr list_elem_t List_get(const StaticList<capacity>* const list, const list_position_t position, int* const err_code = NULL);
+
+/**
+ * @brief Find position of the element by its index.
+ * 
+ * @param list
+ * @param index index of the element (negative ones count from the tail)
+ * @param err_code variable to use as errno
+ * @return position of the element (0 for empty lists or on failure)
+ */
+template <size_t capacity>
+constexpr list_position_t List_find_position(const StaticList<capacity>* const list, const int index, int* const err_code = NULL);
+
+/**
+ * @brief Put elements in cells [1, size] in their order.
+ * 
+ * @param list
+ * @param err_code variable to use as errno
+ */
+template <size_t capacity>
+constexpr void List_linearize(StaticList<capacity>* const list, int* const err_code = NULL);
+
+/**
+ * @brief Check the list.
+ * 
+ * @param list
+ * @return list_report_t
+ */
+template <size_t capacity>
+constexpr list_report_t List_status(const StaticList<capacity>* const list);
+
+#endif
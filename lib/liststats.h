@@ -0,0 +1,204 @@
+/**
+ * @file liststats.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief .cpp - style file for listworks operation counters.
+ * @version 0.1
+ * @date 2022-11-16
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+//* Function headers are specified in the file liststats_.h
+
+#ifndef LISTSTATS_HPP
+#define LISTSTATS_HPP
+
+#include "liststats_.h"
+
+#include <stdlib.h>
+#include <atomic>
+
+static _ListExtras* _List_extras(List* const list);
+
+//* Counters are only written by their own threads (unless shards are shared), and are read while
+//* lists are in use, so they are accessed with relaxed atomics that compile to plain loads and stores.
+
+static inline unsigned long long _List_stats_load(const unsigned long long* counter) {
+    return __atomic_load_n(counter, __ATOMIC_RELAXED);
+}
+
+static inline void _List_stats_store(unsigned long long* counter, const unsigned long long value) {
+    __atomic_store_n(counter, value, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Get statistics block of the list, attaching it if there is none.
+ * 
+ * @param list
+ * @return _ListStatsBlock* (NULL if it could not be allocated)
+ */
+static _ListStatsBlock* _List_stats_block(List* const list) {
+    _ListExtras* extras = _List_extras(list);
+    if (!extras) return NULL;
+
+    _ListStatsBlock* block = __atomic_load_n(&extras->stats, __ATOMIC_ACQUIRE);
+    if (block) return block;
+
+    size_t block_size = (sizeof(_ListStatsBlock) + alignof(_ListStatsBlock) - 1) / alignof(_ListStatsBlock) * alignof(_ListStatsBlock);
+    block = (_ListStatsBlock*) aligned_alloc(alignof(_ListStatsBlock), block_size);
+    if (!block) return NULL;
+
+    *block = _ListStatsBlock {};
+    for (size_t id = 0; id < LIST_STATS_SHARD_COUNT; ++id) block->shards[id].peak_size = list->size;
+
+    _ListStatsBlock* expected = NULL;
+    if (!__atomic_compare_exchange_n(&extras->stats, &expected, block, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        free(block);
+        return expected;
+    }
+
+    return block;
+}
+
+/**
+ * @brief Get counter shard of the calling thread.
+ * 
+ * @param list
+ * @return _ListStatsShard*
+ */
+static inline _ListStatsShard* _List_stats_shard(List* const list) {
+    static std::atomic<size_t> thread_count(0);
+    static thread_local size_t thread_id = thread_count.fetch_add(1, std::memory_order_relaxed);
+
+    _ListStatsBlock* block = _List_stats_block(list);
+    return block ? &block->shards[thread_id % LIST_STATS_SHARD_COUNT] : NULL;
+}
+
+static inline void _List_stats_add(List* const list, const ListCounter counter, const unsigned long long amount) {
+    _ListStatsShard* shard = _List_stats_shard(list);
+    if (!shard) return;
+
+    _List_stats_store(&shard->counters[counter], _List_stats_load(&shard->counters[counter]) + amount);
+
+    _ListStatsBlock* block = list->extras->stats;
+    if (counter >= LIST_COUNTER_OPERATION_COUNT || block->export_period == 0) return;
+
+    unsigned long long until_export = _List_stats_load(&shard->until_export);
+    if (until_export > 1) {
+        _List_stats_store(&shard->until_export, until_export - 1);
+        return;
+    }
+
+    _List_stats_store(&shard->until_export, block->export_period);
+    if (until_export == 1) List_print_stats(list, block->export_stream, block->export_format);
+}
+
+static inline void _List_stats_peak(List* const list) {
+    _ListStatsShard* shard = _List_stats_shard(list);
+    if (shard && _List_stats_load(&shard->peak_size) < list->size) _List_stats_store(&shard->peak_size, list->size);
+}
+
+void List_get_stats(List* const list, ListStats* const stats, int* const err_code) {
+    _LOG_FAIL_CHECK_(check_ptr(list),  "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(check_ptr(stats), "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    *stats = ListStats {};
+    stats->size = list->size;
+    stats->capacity = list->capacity;
+    //* Every cell but the sentinel is either occupied, lazy or in the free ring.
+    stats->lazy_cells = list->lazy_count;
+    stats->free_cells = list->capacity > list->size + list->lazy_count ? list->capacity - list->size - list->lazy_count - 1 : 0;
+    stats->peak_size = list->size;
+    stats->linearized = list->linearized;
+
+    _ListExtras* extras = __atomic_load_n(&list->extras, __ATOMIC_ACQUIRE);
+    _ListStatsBlock* block = extras ? __atomic_load_n(&extras->stats, __ATOMIC_ACQUIRE) : NULL;
+    if (!block) return;
+
+    for (size_t shard_id = 0; shard_id < LIST_STATS_SHARD_COUNT; ++shard_id) {
+        _ListStatsShard* shard = &block->shards[shard_id];
+
+        for (size_t counter = 0; counter < LIST_COUNTER_COUNT; ++counter) {
+            stats->counters[counter] += _List_stats_load(&shard->counters[counter]);
+        }
+
+        size_t peak_size = (size_t)_List_stats_load(&shard->peak_size);
+        if (stats->peak_size < peak_size) stats->peak_size = peak_size;
+    }
+}
+
+void List_reset_stats(List* const list, int* const err_code) {
+    _LOG_FAIL_CHECK_(check_ptr(list), "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    _ListExtras* extras = __atomic_load_n(&list->extras, __ATOMIC_ACQUIRE);
+    _ListStatsBlock* block = extras ? __atomic_load_n(&extras->stats, __ATOMIC_ACQUIRE) : NULL;
+    if (!block) return;
+
+    for (size_t shard_id = 0; shard_id < LIST_STATS_SHARD_COUNT; ++shard_id) {
+        _ListStatsShard* shard = &block->shards[shard_id];
+
+        for (size_t counter = 0; counter < LIST_COUNTER_COUNT; ++counter) _List_stats_store(&shard->counters[counter], 0);
+        _List_stats_store(&shard->peak_size, list->size);
+    }
+}
+
+void ListStats_print(const ListStats* const stats, FILE* stream, const ListStatsFormat format) {
+    _LOG_FAIL_CHECK_(check_ptr(stats), "error", ERROR_REPORTS, return, NULL, 0);
+    _LOG_FAIL_CHECK_(stream,           "error", ERROR_REPORTS, return, NULL, 0);
+
+    //* Statistics of different threads should not interleave.
+    flockfile(stream);
+
+    if (format == LIST_STATS_JSON) {
+        fprintf(stream, "{\"size\": %lu, \"capacity\": %lu, \"free_cells\": %lu, \"lazy_cells\": %lu, \"peak_size\": %lu, "
+                        "\"linearized\": %s, \"counters\": {",
+                (unsigned long) stats->size, (unsigned long) stats->capacity, (unsigned long) stats->free_cells,
+                (unsigned long) stats->lazy_cells, (unsigned long) stats->peak_size, stats->linearized ? "true" : "false");
+
+        for (size_t counter = 0; counter < LIST_COUNTER_COUNT; ++counter) {
+            fprintf(stream, "%s\"%s\": %llu", counter ? ", " : "", LIST_COUNTER_NAMES[counter], stats->counters[counter]);
+        }
+
+        fprintf(stream, "}}\n");
+    } else {
+        fprintf(stream, "List statistics:\n");
+        fprintf(stream, "\t%-14s = %lu\n", "size", (unsigned long) stats->size);
+        fprintf(stream, "\t%-14s = %lu\n", "capacity", (unsigned long) stats->capacity);
+        fprintf(stream, "\t%-14s = %lu\n", "free_cells", (unsigned long) stats->free_cells);
+        fprintf(stream, "\t%-14s = %lu\n", "lazy_cells", (unsigned long) stats->lazy_cells);
+        fprintf(stream, "\t%-14s = %lu\n", "peak_size", (unsigned long) stats->peak_size);
+        fprintf(stream, "\t%-14s = %d\n", "linearized", stats->linearized);
+
+        for (size_t counter = 0; counter < LIST_COUNTER_COUNT; ++counter) {
+            fprintf(stream, "\t%-14s = %llu\n", LIST_COUNTER_NAMES[counter], stats->counters[counter]);
+        }
+    }
+
+    funlockfile(stream);
+}
+
+void List_print_stats(List* const list, FILE* stream, const ListStatsFormat format, int* const err_code) {
+    ListStats stats = {};
+    List_get_stats(list, &stats, err_code);
+    ListStats_print(&stats, stream, format);
+}
+
+void List_export_stats_every(List* const list, FILE* stream, const ListStatsFormat format, const size_t period,
+                             int* const err_code) {
+    _LOG_FAIL_CHECK_(check_ptr(list),     "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(stream || !period,   "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    _ListStatsBlock* block = _List_stats_block(list);
+    _LOG_FAIL_CHECK_(block, "error", ERROR_REPORTS, return, err_code, ENOMEM);
+
+    block->export_stream = stream;
+    block->export_format = format;
+    block->export_period = period;
+
+    for (size_t shard_id = 0; shard_id < LIST_STATS_SHARD_COUNT; ++shard_id) {
+        _List_stats_store(&block->shards[shard_id].until_export, period);
+    }
+}
+
+#endif
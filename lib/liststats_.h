@@ -0,0 +1,176 @@
+/**
+ * @file liststats_.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Operation counters for listworks lists.
+ * @version 0.1
+ * @date 2022-11-16
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#ifndef LISTSTATS_H
+#define LISTSTATS_H
+
+#include <stdio.h>
+
+#include "listworks_.h"
+#include "list_config.h"
+
+//* Define LIST_STATS before the library include to compile counters into list operations.
+//* Without it counters stay zero and only size-related fields of the statistics are filled.
+
+enum ListCounter {
+    //* Operations (every call of the respective function).
+    LIST_COUNTER_INSERT,
+    LIST_COUNTER_POP,
+    LIST_COUNTER_GET,
+    LIST_COUNTER_FIND_POSITION,
+    LIST_COUNTER_SCAN,              // List_find_value(), List_count(), List_min(), List_max() and List_sum().
+    LIST_COUNTER_TRAVERSE,          // List_for_each() and List_reduce().
+    LIST_COUNTER_LINEARIZE,
+
+    LIST_COUNTER_OPERATION_COUNT,
+
+    //* Events inside operations.
+    LIST_COUNTER_FAST_PATH = LIST_COUNTER_OPERATION_COUNT,  // Operations that used linearized list shortcuts.
+    LIST_COUNTER_SLOW_PATH,         // Operations that had to follow links.
+    LIST_COUNTER_FIND_STEPS,        // Links followed by List_find_position().
+    LIST_COUNTER_DELINEARIZE,       // Operations that made linearized list non-linearized.
+
+    LIST_COUNTER_COUNT,
+};
+
+static const char* const LIST_COUNTER_NAMES[] = {
+    "insert",
+    "pop",
+    "get",
+    "find_position",
+    "scan",
+    "traverse",
+    "linearize",
+    "fast_path",
+    "slow_path",
+    "find_steps",
+    "delinearize",
+};
+
+static_assert(sizeof(LIST_COUNTER_NAMES) / sizeof(*LIST_COUNTER_NAMES) == LIST_COUNTER_COUNT, "Not every list counter has a name.");
+
+enum ListStatsFormat {
+    LIST_STATS_TEXT,
+    LIST_STATS_JSON,    // Single line JSON object.
+};
+
+/**
+ * @brief Counters of one thread (threads get shards by their ids, so unrelated threads may share them).
+ * 
+ */
+struct alignas(64) _ListStatsShard {
+    unsigned long long counters[LIST_COUNTER_COUNT] = {};
+    unsigned long long peak_size = 0;
+    unsigned long long until_export = 0;    // Operations left before the next periodic export.
+};
+
+/**
+ * @brief Statistics storage attached to the list on first use.
+ * 
+ */
+struct _ListStatsBlock {
+    _ListStatsShard shards[LIST_STATS_SHARD_COUNT] = {};
+
+    FILE* export_stream = NULL;
+    ListStatsFormat export_format = LIST_STATS_TEXT;
+    size_t export_period = 0;               // Number of operations (per thread) between exports, 0 to disable.
+};
+
+/**
+ * @brief Merged statistics of the list.
+ * 
+ */
+struct ListStats {
+    unsigned long long counters[LIST_COUNTER_COUNT] = {};
+    size_t size = 0;
+    size_t capacity = 0;
+    size_t free_cells = 0;      // Depth of the free cell ring (cells freed by pops).
+    size_t lazy_cells = 0;      // Cells of the lazy region (never used since the construction or growth).
+    size_t peak_size = 0;       // Max size the list had since the last reset (or since the statistics were attached).
+    bool linearized = false;
+};
+
+/**
+ * @brief Collect statistics of the list.
+ * 
+ * @param list
+ * @param[out] stats
+ * @param err_code variable to use as errno
+ */
+void List_get_stats(List* const list, ListStats* const stats, int* const err_code = NULL);
+
+/**
+ * @brief Reset counters of the list.
+ * 
+ * @param list
+ * @param err_code variable to use as errno
+ */
+void List_reset_stats(List* const list, int* const err_code = NULL);
+
+/**
+ * @brief Print collected statistics.
+ * 
+ * @param stats
+ * @param stream stream to print to
+ * @param format
+ */
+void ListStats_print(const ListStats* const stats, FILE* stream, const ListStatsFormat format = LIST_STATS_TEXT);
+
+/**
+ * @brief Print statistics of the list.
+ * 
+ * @param list
+ * @param stream stream to print to
+ * @param format
+ * @param err_code variable to use as errno
+ */
+void List_print_stats(List* const list, FILE* stream, const ListStatsFormat format = LIST_STATS_TEXT, int* const err_code = NULL);
+
+/**
+ * @brief Print statistics of the list periodically.
+ * 
+ * @note Statistics are printed by the thread that completes every period'th operation of its own,
+ *       so the list must not be modified concurrently with it (as with any other list change).
+ * 
+ * @param list
+ * @param stream stream to print to
+ * @param format
+ * @param period number of operations between prints (0 to stop printing)
+ * @param err_code variable to use as errno
+ */
+void List_export_stats_every(List* const list, FILE* stream, const ListStatsFormat format, const size_t period,
+                             int* const err_code = NULL);
+
+/**
+ * @brief Add amount to the counter of the list.
+ * 
+ * @param list
+ * @param counter
+ * @param amount
+ */
+static inline void _List_stats_add(List* const list, const ListCounter counter, const unsigned long long amount = 1);
+
+/**
+ * @brief Remember current list size if it is the biggest one yet.
+ * 
+ * @param list
+ */
+static inline void _List_stats_peak(List* const list);
+
+#ifdef LIST_STATS
+#define _LIST_COUNT_(list, counter, amount) _List_stats_add(list, counter, amount)
+#define _LIST_TRACK_PEAK_(list) _List_stats_peak(list)
+#else
+#define _LIST_COUNT_(list, counter, amount) do {} while (0)
+#define _LIST_TRACK_PEAK_(list) do {} while (0)
+#endif
+
+#endif
@@ -0,0 +1,282 @@
+/**
+ * @file liststream.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief .cpp - style file for listworks stream format.
+ * @version 0.1
+ * @date 2022-11-12
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+//* Function headers are specified in the file liststream_.h
+
+#ifndef LISTSTREAM_HPP
+#define LISTSTREAM_HPP
+
+#include "liststream_.h"
+
+#include <limits.h>
+#include <sys/uio.h>
+
+#include "listworks.h"
+
+static_assert(sizeof(_ListCell) <= LIST_STREAM_MAX_STRIDE, "List cells are too big for the stream format.");
+static_assert(sizeof(_ListStreamHeader) <= LIST_STREAM_MAX_STRIDE, "Stream header does not fit into reader buffer.");
+
+/**
+ * @brief Write all the data described by io vectors (which get modified in the process).
+ * 
+ * @param fd file descriptor to write to
+ * @param vectors io vectors
+ * @param count number of io vectors
+ * @return true on success, false on write error
+ */
+static bool _List_write_all(const int fd, iovec* vectors, int count) {
+    while (count > 0) {
+        ssize_t written = writev(fd, vectors, count < IOV_MAX ? count : IOV_MAX);
+        if (written < 0) return false;
+
+        size_t left = (size_t) written;
+        while (count > 0 && left >= vectors->iov_len) {
+            left -= vectors->iov_len;
+            ++vectors;
+            --count;
+        }
+
+        if (count > 0) {
+            vectors->iov_base = (char*) vectors->iov_base + left;
+            vectors->iov_len -= left;
+        }
+    }
+
+    return true;
+}
+
+void List_export(List* const list, const int fd, const bool zero_copy, int* const err_code) {
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0,                          "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(std::is_trivially_copyable<list_elem_t>::value, "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    _ListCell* buffer = list->buffer;
+    list_position_t _ListCell::* forward = _List_forward(list);
+
+    //* Cells of reversed lists lie in the opposite order, so their elements are copied.
+    bool direct = zero_copy && list->linearized && !list->reversed && !LIST_INDIRECT;
+
+    _ListStreamHeader header = {};
+    header.magic = LIST_STREAM_MAGIC;
+    header.version = LIST_STREAM_VERSION;
+    header.elem_size = sizeof(list_elem_t);
+    header.stride = direct ? sizeof(_ListCell) : sizeof(list_elem_t);
+    header.count = list->size;
+    header.checksum = SIMPLE_HASH_SEED;
+
+    for (list_position_t cell = buffer->*forward; cell != 0; cell = buffer[cell].*forward) {
+        const list_elem_t* elem = &_List_elem(list, cell);
+        header.checksum = get_simple_hash(elem, elem + 1, header.checksum);
+    }
+
+    iovec vectors[6] = {
+        { &header, sizeof(header) },
+        { (void*) &LIST_ELEM_POISON, sizeof(LIST_ELEM_POISON) },
+    };
+
+    if (direct) {
+        list_position_t firsts[4] = {};
+        size_t counts[4] = {};
+        size_t run_count = list->size ? _List_linear_runs(list, firsts, counts) : 0;
+
+        for (size_t run = 0; run < run_count; ++run) vectors[2 + run] = { buffer + firsts[run], counts[run] * sizeof(_ListCell) };
+
+        _LOG_FAIL_CHECK_(_List_write_all(fd, vectors, 2 + (int) run_count), "error", ERROR_REPORTS, return, err_code, FILE_ERROR);
+        return;
+    }
+
+    _LOG_FAIL_CHECK_(_List_write_all(fd, vectors, 2), "error", ERROR_REPORTS, return, err_code, FILE_ERROR);
+
+    const size_t chunk_capacity = LIST_STREAM_CHUNK_SIZE / sizeof(list_elem_t) + 1;
+    list_elem_t* chunk = (list_elem_t*) calloc(chunk_capacity, sizeof(*chunk));
+    _LOG_FAIL_CHECK_(chunk, "error", ERROR_REPORTS, return, err_code, ENOMEM);
+
+    size_t chunk_size = 0;
+    bool written = true;
+
+    for (list_position_t cell = buffer->*forward; written && cell != 0; cell = buffer[cell].*forward) {
+        chunk[chunk_size++] = _List_elem(list, cell);
+
+        if (chunk_size == chunk_capacity || buffer[cell].*forward == 0) {
+            iovec vector = { chunk, chunk_size * sizeof(*chunk) };
+            written = _List_write_all(fd, &vector, 1);
+            chunk_size = 0;
+        }
+    }
+
+    free(chunk);
+
+    _LOG_FAIL_CHECK_(written, "error", ERROR_REPORTS, return, err_code, FILE_ERROR);
+}
+
+void List_import(List* const list, const int fd, const size_t capacity, int* const err_code) {
+    _LOG_FAIL_CHECK_(check_ptr(list), "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    char* chunk = (char*) calloc(LIST_STREAM_CHUNK_SIZE, sizeof(*chunk));
+    _LOG_FAIL_CHECK_(chunk, "error", ERROR_REPORTS, return, err_code, ENOMEM);
+
+    ListStreamReader reader = {};
+    ListStreamReader_ctor(&reader, list, capacity);
+
+    int status = 0;
+    ssize_t chunk_size = 0;
+
+    while (status == 0 && (chunk_size = read(fd, chunk, LIST_STREAM_CHUNK_SIZE)) > 0) {
+        ListStreamReader_feed(&reader, chunk, (size_t) chunk_size, &status);
+    }
+
+    free(chunk);
+
+    _LOG_FAIL_CHECK_(status == 0 && chunk_size == 0, "error", ERROR_REPORTS, {
+        if (reader.stage != LIST_STREAM_HEADER && reader.stage != LIST_STREAM_POISON) List_dtor(list);
+        return;
+    }, err_code, status ? status : FILE_ERROR);
+
+    ListStreamReader_finish(&reader, err_code);
+}
+
+void ListStreamReader_ctor(ListStreamReader* const reader, List* const list, const size_t capacity) {
+    *reader = ListStreamReader {};
+    reader->list = list;
+    reader->min_capacity = capacity;
+}
+
+/**
+ * @brief Move bytes from the chunk to the pending buffer until it holds the specified amount.
+ * 
+ * @param reader
+ * @param data chunk data
+ * @param size chunk size
+ * @param required number of bytes the pending buffer should hold
+ * @return number of bytes taken from the chunk
+ */
+static size_t _ListStreamReader_accumulate(ListStreamReader* const reader, const unsigned char* data,
+                                           const size_t size, const size_t required) {
+    size_t taken = required - reader->pending_size;
+    if (taken > size) taken = size;
+
+    memcpy(reader->pending + reader->pending_size, data, taken);
+    reader->pending_size += taken;
+
+    return taken;
+}
+
+/**
+ * @brief Put next element from the record into the list (cells are linked in index order).
+ * 
+ * @param reader
+ * @param record record start
+ */
+static inline void _ListStreamReader_store(ListStreamReader* const reader, const unsigned char* record) {
+    _ListCell* cell = &reader->list->buffer[++reader->received];
+    cell->next = reader->received + 1;
+    cell->prev = reader->received - 1;
+
+    list_elem_t* target = _List_claim(reader->list, reader->received);
+    memcpy((void*) target, record, sizeof(*target));
+    reader->checksum = get_simple_hash(target, target + 1, reader->checksum);
+}
+
+size_t ListStreamReader_feed(ListStreamReader* const reader, const void* data, const size_t size, int* const err_code) {
+    _LOG_FAIL_CHECK_(reader && (data || size == 0), "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(reader->stage != LIST_STREAM_DONE || size == 0, "error", ERROR_REPORTS, return 0, err_code, EINVAL);
+
+    const unsigned char* bytes = (const unsigned char*) data;
+    _ListStreamHeader* header = &reader->header;
+    size_t consumed = 0;
+
+    while (consumed < size && reader->stage != LIST_STREAM_DONE) {
+        switch (reader->stage) {
+            case LIST_STREAM_HEADER: {
+                consumed += _ListStreamReader_accumulate(reader, bytes + consumed, size - consumed, sizeof(*header));
+                if (reader->pending_size < sizeof(*header)) break;
+
+                memcpy(header, reader->pending, sizeof(*header));
+                reader->pending_size = 0;
+
+                _LOG_FAIL_CHECK_(header->magic == LIST_STREAM_MAGIC && header->version == LIST_STREAM_VERSION &&
+                                 header->elem_size == sizeof(list_elem_t) && std::is_trivially_copyable<list_elem_t>::value &&
+                                 header->elem_size <= header->stride && header->stride <= LIST_STREAM_MAX_STRIDE &&
+                                 header->count < (uint64_t)-1,
+                                 "error", ERROR_REPORTS, return consumed, err_code, EINVAL);
+
+                reader->stage = LIST_STREAM_POISON;
+                break;
+            }
+            case LIST_STREAM_POISON: {
+                consumed += _ListStreamReader_accumulate(reader, bytes + consumed, size - consumed, sizeof(list_elem_t));
+                if (reader->pending_size < sizeof(list_elem_t)) break;
+
+                reader->pending_size = 0;
+
+                _LOG_FAIL_CHECK_(memcmp(reader->pending, &LIST_ELEM_POISON, sizeof(LIST_ELEM_POISON)) == 0,
+                                 "error", ERROR_REPORTS, return consumed, err_code, EINVAL);
+
+                size_t capacity = header->count + 1;
+                List_ctor(reader->list, capacity > reader->min_capacity ? capacity : reader->min_capacity, err_code);
+                _LOG_FAIL_CHECK_(reader->list->buffer, "error", ERROR_REPORTS, return consumed, err_code, ENOMEM);
+
+                reader->stage = header->count ? LIST_STREAM_PAYLOAD : LIST_STREAM_DONE;
+                break;
+            }
+            case LIST_STREAM_PAYLOAD: {
+                if (reader->pending_size) {
+                    consumed += _ListStreamReader_accumulate(reader, bytes + consumed, size - consumed, header->stride);
+                    if (reader->pending_size < header->stride) break;
+
+                    _ListStreamReader_store(reader, reader->pending);
+                    reader->pending_size = 0;
+                }
+
+                //* Whole records are read right from the chunk.
+                size_t records = (size - consumed) / header->stride;
+                if (records > header->count - reader->received) records = header->count - reader->received;
+
+                for (size_t id = 0; id < records; ++id, consumed += header->stride) {
+                    _ListStreamReader_store(reader, bytes + consumed);
+                }
+
+                if (reader->received < header->count && consumed < size) {
+                    consumed += _ListStreamReader_accumulate(reader, bytes + consumed, size - consumed, header->stride);
+                }
+
+                if (reader->received == header->count) reader->stage = LIST_STREAM_DONE;
+                break;
+            }
+            case LIST_STREAM_DONE:
+            default:
+                break;
+        }
+    }
+
+    return consumed;
+}
+
+void ListStreamReader_finish(ListStreamReader* const reader, int* const err_code) {
+    _LOG_FAIL_CHECK_(reader, "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    List* list = reader->list;
+    bool has_list = reader->stage == LIST_STREAM_PAYLOAD || reader->stage == LIST_STREAM_DONE;
+
+    _LOG_FAIL_CHECK_(reader->stage == LIST_STREAM_DONE && reader->checksum == reader->header.checksum,
+                     "error", ERROR_REPORTS, {
+        if (has_list) List_dtor(list);
+        return;
+    }, err_code, EBADMSG);
+
+    list->size = reader->received;
+    _List_close_linear_rings(list, list->buffer);
+    list->linearized = true;
+    _List_checksum_rebuild(list);
+
+    _LOG_FAIL_CHECK_(List_status(list) == 0, "error", ERROR_REPORTS, return, err_code, EAGAIN);
+}
+
+#endif
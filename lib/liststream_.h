@@ -0,0 +1,117 @@
+/**
+ * @file liststream_.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Binary stream format for listworks lists.
+ * @version 0.1
+ * @date 2022-11-12
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#ifndef LISTSTREAM_H
+#define LISTSTREAM_H
+
+#include <sys/types.h>
+
+#include "listworks_.h"
+#include "list_config.h"
+
+//* Stream layout:
+//*   _ListStreamHeader,
+//*   elem_size bytes of the poison value,
+//*   count records, stride bytes each, every record starts with the element.
+//* Records are exactly elem_size bytes long unless the stream was written with the zero-copy path,
+//* in which case they are whole list cells.
+
+/**
+ * @brief Fixed part of the stream header.
+ * 
+ */
+struct _ListStreamHeader {
+    uint64_t magic = 0;
+    uint32_t version = 0;
+    uint32_t elem_size = 0;
+    uint32_t stride = 0;
+    uint32_t reserved = 0;
+    uint64_t count = 0;
+    hash_t checksum = 0;    // get_simple_hash() of element bytes in list order.
+};
+
+enum ListStreamStage {
+    LIST_STREAM_HEADER,
+    LIST_STREAM_POISON,
+    LIST_STREAM_PAYLOAD,
+    LIST_STREAM_DONE,
+};
+
+/**
+ * @brief Reader that builds the list from stream chunks as they arrive.
+ * 
+ */
+struct ListStreamReader {
+    List* list = NULL;
+    size_t min_capacity = 0;
+
+    ListStreamStage stage = LIST_STREAM_HEADER;
+    _ListStreamHeader header = {};
+
+    unsigned char pending[LIST_STREAM_MAX_STRIDE] = {};  // Bytes of the unfinished header or record.
+    size_t pending_size = 0;
+
+    size_t received = 0;                // Number of elements read.
+    hash_t checksum = SIMPLE_HASH_SEED; // Checksum of the elements read.
+};
+
+/**
+ * @brief Write list into the file descriptor.
+ * 
+ * @note Elements are written byte by byte, so lists of non-trivially copyable elements are refused.
+ * 
+ * @param list
+ * @param fd file descriptor to write to
+ * @param zero_copy true to write linearized (not reversed) lists right from the buffer with writev()
+ *                  (records then include cell links, which makes the stream bigger, ignored for LIST_INDIRECT elements)
+ * @param err_code variable to use as errno
+ */
+void List_export(List* const list, const int fd, const bool zero_copy = false, int* const err_code = NULL);
+
+/**
+ * @brief Initialize list with the content of the stream.
+ * 
+ * @param list list to initialize
+ * @param fd file descriptor to read from
+ * @param capacity minimal capacity of the list (0 to fit elements exactly)
+ * @param err_code variable to use as errno
+ */
+void List_import(List* const list, const int fd, const size_t capacity = 0, int* const err_code = NULL);
+
+/**
+ * @brief Initialize stream reader.
+ * 
+ * @param reader
+ * @param list list to initialize once the stream header arrives
+ * @param capacity minimal capacity of the list (0 to fit elements exactly)
+ */
+void ListStreamReader_ctor(ListStreamReader* const reader, List* const list, const size_t capacity = 0);
+
+/**
+ * @brief Process next chunk of the stream.
+ * 
+ * @param reader
+ * @param data chunk start
+ * @param size chunk size in bytes
+ * @param err_code variable to use as errno
+ * @return number of bytes consumed (less than size only after the stream end or on error)
+ */
+size_t ListStreamReader_feed(ListStreamReader* const reader, const void* data, const size_t size, int* const err_code = NULL);
+
+/**
+ * @brief Finish reading, check the stream checksum and make the list usable.
+ * 
+ * @param reader
+ * @param err_code variable to use as errno
+ */
+void ListStreamReader_finish(ListStreamReader* const reader, int* const err_code = NULL);
+
+#endif
@@ -0,0 +1,563 @@
+/**
+ * @file listworkload.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief .cpp - style file for listworks workload traces.
+ * @version 0.1
+ * @date 2022-11-28
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+//* Function headers are specified in the file listworkload_.h
+
+#ifndef LISTWORKLOAD_HPP
+#define LISTWORKLOAD_HPP
+
+#include "listworkload_.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <type_traits>
+
+#include "listworks.h"
+
+/**
+ * @brief Build name of the checkpoint file of the trace.
+ * 
+ * @param name buffer of LIST_FILE_NAME_SIZE bytes
+ * @param file_name name of the trace
+ * @return false if the name does not fit
+ */
+static bool _ListWorkload_checkpoint_name(char* const name, const char* file_name) {
+    return snprintf(name, LIST_FILE_NAME_SIZE, "%s.ckpt", file_name) < (int)LIST_FILE_NAME_SIZE;
+}
+
+static hash_t _ListWorkload_header_hash(const _ListWorkloadHeader* const header) {
+    return get_simple_hash(header, &header->header_hash);
+}
+
+/**
+ * @brief Append LEB128 varint to the recorder buffer.
+ * 
+ */
+static void _ListRecorder_put_varint(ListRecorder* const recorder, uint64_t value) {
+    do {
+        recorder->buffer[recorder->used++] = (unsigned char)((value & 0x7F) | (value > 0x7F ? 0x80 : 0));
+        value >>= 7;
+    } while (value);
+}
+
+/**
+ * @brief Append the value to the recorder buffer byte by byte.
+ * 
+ */
+template <class T>
+static void _ListRecorder_put(ListRecorder* const recorder, const T& value) {
+    memcpy(recorder->buffer + recorder->used, &value, sizeof(value));
+    recorder->used += sizeof(value);
+}
+
+static void _ListRecorder_observe(const ListEvent event, const list_position_t position, const list_elem_t* elem,
+                                  const list_position_t result, void* ctx) {
+    ListRecorder* recorder = (ListRecorder*) ctx;
+    if (recorder->error) return;
+
+    if (recorder->used + LIST_WORKLOAD_RECORD_SIZE > LIST_WORKLOAD_BUFFER_SIZE) {
+        ListRecorder_flush(recorder, &recorder->error);
+        if (recorder->error) return;
+    }
+
+    switch (event) {
+        case LIST_EVENT_INSERT:
+            _ListRecorder_put(recorder, (uint8_t) LIST_CALL_INSERT);
+            _ListRecorder_put_varint(recorder, position);
+            _ListRecorder_put(recorder, *elem);
+            _ListRecorder_put_varint(recorder, result);
+            break;
+        case LIST_EVENT_POP:
+            _ListRecorder_put(recorder, (uint8_t) LIST_CALL_POP);
+            _ListRecorder_put_varint(recorder, position);
+            break;
+        case LIST_EVENT_LINEARIZE:
+            _ListRecorder_put(recorder, (uint8_t) LIST_CALL_LINEARIZE);
+            break;
+        case LIST_EVENT_MODIFY: {
+            //* Visitors are not recorded, so new values of the elements are.
+            const List* list = recorder->list;
+            _ListRecorder_put(recorder, (uint8_t) LIST_CALL_MODIFY);
+            _ListRecorder_put_varint(recorder, list->size);
+
+            for (list_position_t cell = list->buffer->next; cell != 0; cell = list->buffer[cell].next) {
+                if (recorder->used + sizeof(list_elem_t) > LIST_WORKLOAD_BUFFER_SIZE) {
+                    ListRecorder_flush(recorder, &recorder->error);
+                    if (recorder->error) return;
+                }
+                _ListRecorder_put(recorder, _List_elem(list, cell));
+            }
+            break;
+        }
+        case LIST_EVENT_SORT:
+            _ListRecorder_put(recorder, (uint8_t) LIST_CALL_SORT);
+            break;
+        case LIST_EVENT_MOVE:
+            _ListRecorder_put(recorder, (uint8_t) LIST_CALL_MOVE);
+            _ListRecorder_put_varint(recorder, result);
+            _ListRecorder_put_varint(recorder, position);
+            break;
+        case LIST_EVENT_SET:
+            _ListRecorder_put(recorder, (uint8_t) LIST_CALL_SET);
+            _ListRecorder_put_varint(recorder, position);
+            _ListRecorder_put(recorder, *elem);
+            break;
+        case LIST_EVENT_GET:
+            _ListRecorder_put(recorder, (uint8_t) LIST_CALL_GET);
+            _ListRecorder_put_varint(recorder, position);
+            break;
+        case LIST_EVENT_FIND_POSITION: {
+            //* Zigzag encoding keeps indices counted from the tail short.
+            long long index = (long long)position;
+            _ListRecorder_put(recorder, (uint8_t) LIST_CALL_FIND_POSITION);
+            _ListRecorder_put_varint(recorder, (uint64_t)index << 1 ^ (uint64_t)(index >> 63));
+            _ListRecorder_put_varint(recorder, result);
+            break;
+        }
+        case LIST_EVENT_REMOVE:
+            //* Gaps are shifted by one, as 0 ends the record.
+            if (!recorder->removing) {
+                _ListRecorder_put(recorder, (uint8_t) LIST_CALL_REMOVE_IF);
+                recorder->removing = true;
+                recorder->remove_index = 0;
+            }
+            _ListRecorder_put_varint(recorder, position - recorder->remove_index + 1);
+            recorder->remove_index = position + 1;
+            return;
+        case LIST_EVENT_REMOVE_IF:
+            if (!recorder->removing) _ListRecorder_put(recorder, (uint8_t) LIST_CALL_REMOVE_IF);
+            _ListRecorder_put_varint(recorder, 0);
+            recorder->removing = false;
+            break;
+        case LIST_EVENT_REVERSE:
+            _ListRecorder_put(recorder, (uint8_t) LIST_CALL_REVERSE);
+            break;
+        case LIST_EVENT_ROTATE:
+            _ListRecorder_put(recorder, (uint8_t) LIST_CALL_ROTATE);
+            _ListRecorder_put_varint(recorder, position);
+            break;
+        default: return;
+    }
+
+    ++recorder->calls;
+}
+
+void ListRecorder_ctor(ListRecorder* const recorder, List* const list, const char* file_name, int* const err_code) {
+    _LOG_FAIL_CHECK_(check_ptr(recorder),                               "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(List_status(list) == 0,                            "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(file_name,                                         "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(!_List_observer(list),                             "error", ERROR_REPORTS, return, err_code, EBUSY);
+    _LOG_FAIL_CHECK_(_List_extras(list),                                "error", ERROR_REPORTS, return, err_code, ENOMEM);
+    _LOG_FAIL_CHECK_(std::is_trivially_copyable<list_elem_t>::value,    "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    *recorder = ListRecorder {};
+    recorder->list = list;
+
+    _ListWorkloadHeader header = {};
+    header.magic = LIST_WORKLOAD_MAGIC;
+    header.version = LIST_WORKLOAD_VERSION;
+    header.elem_size = sizeof(list_elem_t);
+    header.capacity = list->capacity;
+    header.flags = list->growable ? LIST_WORKLOAD_GROWABLE : 0;
+
+    //* Empty lists with used cells hand them out in another order than new ones, so they are saved as well (as reversed ones).
+    bool fresh = list->size == 0 && list->first_empty == 0 && list->lazy_begin == 1 && list->lazy_count == list->capacity - 1 &&
+                 !list->reversed;
+    if (!fresh) {
+        char checkpoint_name[LIST_FILE_NAME_SIZE] = "";
+        _LOG_FAIL_CHECK_(_ListWorkload_checkpoint_name(checkpoint_name, file_name),
+                         "error", ERROR_REPORTS, return, err_code, ENAMETOOLONG);
+
+        int error = 0;
+        List_save(list, checkpoint_name, &error);
+        _LOG_FAIL_CHECK_(error == 0, "error", ERROR_REPORTS, return, err_code, error);
+
+        header.flags |= LIST_WORKLOAD_CHECKPOINT;
+    }
+
+    header.header_hash = _ListWorkload_header_hash(&header);
+
+    recorder->buffer = (unsigned char*) calloc(LIST_WORKLOAD_BUFFER_SIZE, 1);
+    _LOG_FAIL_CHECK_(recorder->buffer, "error", ERROR_REPORTS, return, err_code, ENOMEM);
+
+    recorder->fd = open(file_name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    _LOG_FAIL_CHECK_(recorder->fd != -1, "error", ERROR_REPORTS, {
+        ListRecorder_dtor(recorder);
+        return;
+    }, err_code, FILE_ERROR);
+
+    _ListRecorder_put(recorder, header);
+
+    list->extras->observer = _ListRecorder_observe;
+    list->extras->observer_ctx = recorder;
+}
+
+void ListRecorder_dtor(ListRecorder* const recorder, int* const err_code) {
+    _LOG_FAIL_CHECK_(check_ptr(recorder), "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    _ListExtras* extras = recorder->list ? recorder->list->extras : NULL;
+    if (extras && extras->observer_ctx == recorder) {
+        extras->observer = NULL;
+        extras->observer_ctx = NULL;
+    }
+
+    if (recorder->fd != -1) {
+        ListRecorder_flush(recorder, err_code);
+        close(recorder->fd);
+    }
+
+    free(recorder->buffer);
+
+    *recorder = ListRecorder {};
+}
+
+void ListRecorder_dtor_void(ListRecorder* const recorder) { ListRecorder_dtor(recorder, NULL); }
+
+void ListRecorder_flush(ListRecorder* const recorder, int* const err_code) {
+    _LOG_FAIL_CHECK_(check_ptr(recorder),  "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(recorder->error == 0, "error", ERROR_REPORTS, return, err_code, recorder->error);
+
+    bool written = true;
+    for (size_t offset = 0; offset < recorder->used && written;) {
+        ssize_t chunk = write(recorder->fd, recorder->buffer + offset, recorder->used - offset);
+        written = chunk > 0;
+        if (written) offset += (size_t)chunk;
+    }
+
+    recorder->used = 0;
+
+    _LOG_FAIL_CHECK_(written, "error", ERROR_REPORTS, {
+        recorder->error = FILE_ERROR;
+        return;
+    }, err_code, FILE_ERROR);
+}
+
+/**
+ * @brief Read the whole file into memory.
+ * 
+ * @param file_name
+ * @param[out] size size of the file
+ * @param err_code variable to use as errno
+ * @return contents of the file (NULL on failure)
+ */
+static unsigned char* _ListWorkload_read(const char* file_name, size_t* const size, int* const err_code) {
+    int fd = open(file_name, O_RDONLY);
+    _LOG_FAIL_CHECK_(fd != -1, "error", ERROR_REPORTS, return NULL, err_code, FILE_ERROR);
+
+    struct stat file_stat = {};
+    bool read_all = fstat(fd, &file_stat) == 0;
+
+    *size = read_all ? (size_t)file_stat.st_size : 0;
+    unsigned char* data = read_all ? (unsigned char*) malloc(*size + 1) : NULL;
+
+    read_all = data != NULL;
+    for (size_t offset = 0; offset < *size && read_all;) {
+        ssize_t chunk = read(fd, data + offset, *size - offset);
+        read_all = chunk > 0;
+        if (read_all) offset += (size_t)chunk;
+    }
+
+    close(fd);
+
+    _LOG_FAIL_CHECK_(read_all, "error", ERROR_REPORTS, {
+        free(data);
+        return NULL;
+    }, err_code, FILE_ERROR);
+
+    return data;
+}
+
+/**
+ * @brief Initialize list with the state the trace was recorded from.
+ * 
+ * @param list list to initialize
+ * @param file_name name of the trace
+ * @param header header of the trace
+ * @param options
+ * @param err_code variable to use as errno
+ */
+static void _ListWorkload_open_list(List* const list, const char* file_name, const _ListWorkloadHeader* const header,
+                                    const ListReplayOptions* const options, int* const err_code) {
+    bool growable = header->flags & LIST_WORKLOAD_GROWABLE;
+    _LOG_FAIL_CHECK_(!growable || !options->mapped_file, "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    int error = 0;
+
+    if (header->flags & LIST_WORKLOAD_CHECKPOINT) {
+        char checkpoint_name[LIST_FILE_NAME_SIZE] = "";
+        _LOG_FAIL_CHECK_(_ListWorkload_checkpoint_name(checkpoint_name, file_name),
+                         "error", ERROR_REPORTS, return, err_code, ENAMETOOLONG);
+
+        list_report_t report = List_load(list, checkpoint_name, &error);
+        _LOG_FAIL_CHECK_(report == 0 && error == 0, "error", ERROR_REPORTS, return, err_code, error ? error : EILSEQ);
+    } else {
+        List_ctor_with(list, (size_t)header->capacity, &options->pages, &error);
+        _LOG_FAIL_CHECK_(error == 0, "error", ERROR_REPORTS, return, err_code, error);
+    }
+
+    list->growable = growable;
+    if (!options->mapped_file) return;
+
+    List_save(list, options->mapped_file, &error);
+    List_dtor(list);
+    _LOG_FAIL_CHECK_(error == 0, "error", ERROR_REPORTS, return, err_code, error);
+
+    list_report_t report = List_open_mapped(list, options->mapped_file, false, &error);
+    _LOG_FAIL_CHECK_(report == 0 && error == 0, "error", ERROR_REPORTS, return, err_code, error ? error : EILSEQ);
+}
+
+/**
+ * @brief Take LEB128 varint from the record and move the record pointer past it.
+ * 
+ * @return false if the trace ends inside the varint
+ */
+static bool _ListWorkload_take_varint(const unsigned char** record, const unsigned char* const end, uint64_t* const value) {
+    *value = 0;
+
+    for (unsigned shift = 0; *record < end && shift < 64; shift += 7) {
+        unsigned char byte = *(*record)++;
+        *value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+
+    return false;
+}
+
+//* Layouts of records by call type: number of varints and whether the element follows the first one.
+//* Records of List_for_each() calls are followed by the elements, ones of List_remove_if() calls by gaps ending with 0.
+static const unsigned char LIST_WORKLOAD_VARINTS[] = { 0, 2, 1, 0, 1, 0, 2, 1, 1, 2, 0, 0, 1 };
+static const bool LIST_WORKLOAD_HAS_ELEM[]         = { 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0 };
+
+//* Latency trace spans of replayed calls.
+static const ListTraceSpan LIST_WORKLOAD_SPANS[] = {
+    LIST_SPAN_COUNT, LIST_SPAN_INSERT, LIST_SPAN_POP, LIST_SPAN_LINEARIZE, LIST_SPAN_TRAVERSE,
+    LIST_SPAN_SORT, LIST_SPAN_MOVE, LIST_SPAN_MOVE, LIST_SPAN_GET, LIST_SPAN_FIND_POSITION, LIST_SPAN_POP,
+    LIST_SPAN_MOVE, LIST_SPAN_MOVE,
+};
+
+//* Visitor writing recorded values into the elements (ctx points to the pointer to the next value).
+static void _ListWorkload_assign(list_elem_t* elem, void* ctx) {
+    const unsigned char** values = (const unsigned char**) ctx;
+    memcpy((void*) elem, *values, sizeof(*elem));
+    *values += sizeof(*elem);
+}
+
+/**
+ * @brief State of the predicate removing recorded elements.
+ * 
+ */
+struct _ListWorkloadRemoval {
+    const unsigned char* gaps = NULL;   // Gap before the next removed element (checked before the replay).
+    const unsigned char* end = NULL;
+    size_t checked = 0;                 // Number of elements checked by the predicate.
+    size_t next = 0;                    // Number of elements up to the next removed one (0 if there are none).
+};
+
+static bool _ListWorkload_removed(const list_elem_t* elem, void* ctx) {
+    SILENCE_UNUSED(elem);
+    _ListWorkloadRemoval* removal = (_ListWorkloadRemoval*) ctx;
+
+    if (++removal->checked != removal->next) return false;
+
+    uint64_t gap = 0;
+    _ListWorkload_take_varint(&removal->gaps, removal->end, &gap);
+    removal->next = gap ? removal->next + gap : 0;
+
+    return true;
+}
+
+/**
+ * @brief Replay the next call of the trace.
+ * 
+ * @param list
+ * @param record pointer to the record (moved past it)
+ * @param end end of the trace
+ * @param options
+ * @param report report to count the call in
+ * @param err_code variable to use as errno (EILSEQ if the call does not match the list)
+ * @return false if the trace ended or the replay has to stop
+ */
+static bool _ListWorkload_replay_call(List* const list, const unsigned char** record, const unsigned char* const end,
+                                      const ListReplayOptions* const options, ListReplayReport* const report,
+                                      int* const err_code) {
+    uint8_t type = **record;
+    if (type < LIST_CALL_INSERT || type > LIST_CALL_ROTATE) {
+        _LOG_FAIL_CHECK_(false, "error", ERROR_REPORTS, return false, err_code, EILSEQ);
+    }
+
+    //* Records torn by a crash of the recording program end the trace.
+    ++*record;
+    uint64_t args[2] = {};
+    list_elem_t elem = LIST_ELEM_POISON;
+
+    for (unsigned char arg = 0; arg < LIST_WORKLOAD_VARINTS[type]; ++arg) {
+        if (!_ListWorkload_take_varint(record, end, args + arg)) return false;
+
+        if (arg == 0 && LIST_WORKLOAD_HAS_ELEM[type]) {
+            if ((size_t)(end - *record) < sizeof(elem)) return false;
+            memcpy((void*) &elem, *record, sizeof(elem));
+            *record += sizeof(elem);
+        }
+    }
+
+    list_position_t position = args[0];
+    bool valid = true;
+
+    //* Positions are checked like List_recover() does, so broken traces stop the replay instead of crashing it.
+    if (type == LIST_CALL_POP || type == LIST_CALL_SET || type == LIST_CALL_MOVE)
+        valid = position != 0 && position < list->capacity && _List_is_occupied(list, position);
+    if (type == LIST_CALL_INSERT || type == LIST_CALL_GET)
+        valid = position < list->capacity;
+    if (type == LIST_CALL_MOVE)
+        valid = valid && args[1] < list->capacity;
+    if (type == LIST_CALL_MODIFY)
+        valid = position == list->size;
+    if (type == LIST_CALL_ROTATE)
+        valid = position != 0 && position < list->size;
+
+    //* Gaps of removal records are read twice: here to check them and count removals, then by the predicate.
+    _ListWorkloadRemoval removal = {};
+
+    if (type == LIST_CALL_REMOVE_IF) {
+        uint64_t gap = 0;
+        if (!_ListWorkload_take_varint(record, end, &gap)) return false;
+
+        removal.gaps = *record;
+        removal.end = end;
+        removal.next = gap;
+
+        for (uint64_t next = gap; gap != 0; next += gap) {
+            valid = valid && next <= list->size;
+            ++args[1];
+            if (!_ListWorkload_take_varint(record, end, &gap)) return false;
+        }
+    }
+
+    _LOG_FAIL_CHECK_(valid, "error", ERROR_REPORTS, return false, err_code, EILSEQ);
+
+    const unsigned char* values = *record;
+    if (type == LIST_CALL_MODIFY) {
+        if ((size_t)(end - *record) / sizeof(list_elem_t) < position) return false;
+        *record += position * sizeof(list_elem_t);
+    }
+
+    int error = 0;
+    list_position_t result = args[1];
+    list_position_t returned = result;
+
+    uint64_t start = latency_trace_now();
+
+    switch (type) {
+        case LIST_CALL_INSERT:        returned = List_insert(list, elem, position, &error); break;
+        case LIST_CALL_POP:           List_pop(list, position, &error); break;
+        case LIST_CALL_LINEARIZE:     List_linearize(list, &error); break;
+        case LIST_CALL_MODIFY:        List_for_each(list, _ListWorkload_assign, &values, NULL, &error); break;
+#ifndef LIST_NO_ARITHMETIC
+        case LIST_CALL_SORT:          List_sort(list, &error); break;
+#endif
+        case LIST_CALL_MOVE:          List_move(list, position, args[1], &error); break;
+        case LIST_CALL_SET:           List_set(list, position, elem, &error); break;
+        case LIST_CALL_GET:           List_get(list, position, &error); break;
+        case LIST_CALL_FIND_POSITION:
+            returned = List_find_position(list, (int)((long long)(position >> 1) ^ -(long long)(position & 1)), &error);
+            break;
+        case LIST_CALL_REMOVE_IF:     returned = List_remove_if(list, _ListWorkload_removed, &removal, &error); break;
+        case LIST_CALL_REVERSE:       List_reverse(list, &error); break;
+        case LIST_CALL_ROTATE:        List_rotate(list, (int) position, &error); break;
+        default: error = EINVAL; break;
+    }
+
+    LatencyTrace_record(LIST_WORKLOAD_SPANS[type], start, latency_trace_now());
+
+    _LOG_FAIL_CHECK_(error == 0, "error", ERROR_REPORTS, return false, err_code, error);
+
+    ++report->calls;
+    if (returned != result) {
+        ++report->mismatches;
+        _LOG_FAIL_CHECK_(!options->check_results, "error", ERROR_REPORTS, return false, err_code, EILSEQ);
+    }
+
+    return true;
+}
+
+void List_replay(const char* file_name, const ListReplayOptions* const options, ListReplayReport* const report,
+                 int* const err_code) {
+    _LOG_FAIL_CHECK_(file_name,                                         "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(check_ptr(report),                                 "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(std::is_trivially_copyable<list_elem_t>::value,    "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    static const ListReplayOptions default_options = {};
+    const ListReplayOptions* replay_options = options ? options : &default_options;
+
+    *report = ListReplayReport {};
+
+    int error = 0;
+    size_t trace_size = 0;
+    unsigned char* trace = _ListWorkload_read(file_name, &trace_size, &error);
+    _LOG_FAIL_CHECK_(error == 0, "error", ERROR_REPORTS, return, err_code, error);
+
+    _ListWorkloadHeader header = {};
+    if (trace_size >= sizeof(header)) memcpy(&header, trace, sizeof(header));
+
+    _LOG_FAIL_CHECK_(trace_size >= sizeof(header) && header.magic == LIST_WORKLOAD_MAGIC &&
+                     header.version == LIST_WORKLOAD_VERSION && header.elem_size == sizeof(list_elem_t) &&
+                     header.header_hash == _ListWorkload_header_hash(&header), "error", ERROR_REPORTS, {
+        free(trace);
+        return;
+    }, err_code, EINVAL);
+
+    List list = {};
+    _ListWorkload_open_list(&list, file_name, &header, replay_options, &error);
+    if (error == 0) List_set_checks(&list, replay_options->check_mode, replay_options->audit_interval, &error);
+
+    _LOG_FAIL_CHECK_(error == 0, "error", ERROR_REPORTS, {
+        if (list.buffer) List_dtor(&list);
+        free(trace);
+        return;
+    }, err_code, error);
+
+    //* Calls are timed by the replay, so tracing is started only to reset the histograms
+    //* and stopped at once to keep LIST_TRACE scopes of the calls from measuring them again.
+    LatencyTrace_start();
+    LatencyTrace_stop();
+
+    const unsigned char* record = trace + sizeof(header);
+    const unsigned char* end = trace + trace_size;
+
+    timespec start = {}, finish = {};
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    while (record < end && _ListWorkload_replay_call(&list, &record, end, replay_options, report, &error)) {}
+
+    clock_gettime(CLOCK_MONOTONIC, &finish);
+    report->seconds = (double)(finish.tv_sec - start.tv_sec) + (double)(finish.tv_nsec - start.tv_nsec) * 1e-9;
+    report->size = list.size;
+
+    List_dtor(&list);
+    free(trace);
+
+    _LOG_FAIL_CHECK_(error == 0, "error", ERROR_REPORTS, return, err_code, error);
+}
+
+void List_print_replay(const ListReplayReport* const report, FILE* const stream) {
+    _LOG_FAIL_CHECK_(report && stream, "error", ERROR_REPORTS, return, NULL, EFAULT);
+
+    fprintf(stream, "Replayed %zu calls in %.3lf ms (%.0lf calls per second), %zu mismatches, %zu elements left.\n",
+            report->calls, report->seconds * 1e3, report->seconds > 0 ? (double)report->calls / report->seconds : 0.0,
+            report->mismatches, report->size);
+
+    LatencyTrace_print(stream, LIST_SPAN_NAMES, LIST_SPAN_COUNT);
+}
+
+#endif
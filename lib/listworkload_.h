@@ -0,0 +1,176 @@
+/**
+ * @file listworkload_.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Recording list calls into workload traces and replaying them.
+ * @version 0.1
+ * @date 2022-11-28
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#ifndef LISTWORKLOAD_H
+#define LISTWORKLOAD_H
+
+#include <stdio.h>
+
+#include "listworks_.h"
+#include "list_config.h"
+
+//* Workload trace is a _ListWorkloadHeader followed by call records:
+//*   insert        - [type][position][element][resulting position],
+//*   pop           - [type][position],
+//*   linearize     - [type],
+//*   modify        - [type][size][elements in their order],
+//*   sort          - [type],
+//*   move          - [type][moved position][position],
+//*   set           - [type][position][element],
+//*   get           - [type][position],
+//*   find position - [type][index][resulting position],
+//*   remove if     - [type][gaps before removed elements + 1][0],
+//*   reverse       - [type],
+//*   rotate        - [type][steps].
+//* Positions are LEB128 varints, indices are zigzag-encoded ones, elements are written byte by byte.
+//* Lists that are not fresh when recording starts are saved to <trace>.ckpt (see List_save()),
+//* so replays start from the same cells and get the same positions.
+
+enum _ListWorkloadCall {
+    LIST_CALL_INSERT        = 1,
+    LIST_CALL_POP           = 2,
+    LIST_CALL_LINEARIZE     = 3,
+    LIST_CALL_MODIFY        = 4,
+    LIST_CALL_SORT          = 5,
+    LIST_CALL_MOVE          = 6,
+    LIST_CALL_SET           = 7,
+    LIST_CALL_GET           = 8,
+    LIST_CALL_FIND_POSITION = 9,
+    LIST_CALL_REMOVE_IF     = 10,
+    LIST_CALL_REVERSE       = 11,
+    LIST_CALL_ROTATE        = 12,
+};
+
+//* Max size of one record (type, two varints and an element).
+const size_t LIST_WORKLOAD_RECORD_SIZE = 1 + 2 * 10 + sizeof(list_elem_t);
+
+enum _ListWorkloadFlags {
+    LIST_WORKLOAD_CHECKPOINT = 1,   // Replays start from <trace>.ckpt instead of an empty list.
+    LIST_WORKLOAD_GROWABLE   = 2,   // List doubles its buffer when it fills up (see List_ctor_small()).
+};
+
+/**
+ * @brief Header of the trace file.
+ * 
+ */
+struct _ListWorkloadHeader {
+    uint64_t magic = 0;
+    uint32_t version = 0;
+    uint32_t elem_size = 0;
+    uint64_t capacity = 0;      // Capacity of the list when recording started.
+    uint32_t flags = 0;
+    uint32_t reserved = 0;
+    hash_t header_hash = 0;     // Hash of all the fields above.
+};
+
+/**
+ * @brief Recorder writing calls made on the list into the trace.
+ * 
+ */
+struct ListRecorder {
+    List* list = NULL;
+    int fd = -1;                        // Trace file.
+
+    unsigned char* buffer = NULL;       // Records not written yet.
+    size_t used = 0;
+
+    size_t calls = 0;                   // Number of recorded calls.
+    int error = 0;                      // First error met while recording (list calls can not report it).
+
+    bool removing = false;              // List_remove_if() record is being written.
+    size_t remove_index = 0;            // Index after the last element it removed.
+};
+
+/**
+ * @brief Start recording calls made on the list.
+ * 
+ * @note Records are what list observers see: changes of the list, List_get() and List_find_position() calls.
+ *       List_remove_if() calls are recorded with indices of the removed elements, so replays do not need the predicate.
+ *       Other lookups, failed calls and configuration (checks, policies, sorted mode) are not recorded.
+ *       Linearizations the policy starts are recorded as List_linearize() calls.
+ * 
+ * @param recorder recorder to initialize
+ * @param list list to watch (must not have another observer)
+ * @param file_name name of the trace file to (over)write
+ * @param err_code variable to use as errno
+ */
+void ListRecorder_ctor(ListRecorder* const recorder, List* const list, const char* file_name, int* const err_code = NULL);
+
+/**
+ * @brief Write buffered records and stop recording.
+ * 
+ * @param recorder
+ * @param err_code variable to use as errno
+ */
+void ListRecorder_dtor(ListRecorder* const recorder, int* const err_code = NULL);
+
+/**
+ * @brief Destroy the recorder (for the allocation tracker).
+ * 
+ * @param recorder
+ */
+void ListRecorder_dtor_void(ListRecorder* const recorder);
+
+/**
+ * @brief Write buffered records into the trace.
+ * 
+ * @param recorder
+ * @param err_code variable to use as errno
+ */
+void ListRecorder_flush(ListRecorder* const recorder, int* const err_code = NULL);
+
+/**
+ * @brief How traces are replayed.
+ * 
+ */
+struct ListReplayOptions {
+    ListCheckMode check_mode = LIST_CHECK_FULL;     // Checks the replayed list runs (see List_set_checks()).
+    size_t audit_interval = 0;
+    bool check_results = true;                      // Stop at the first call returning another position than the recorded one.
+    PageAllocOptions pages = {};                    // Way to allocate buffers of lists replayed from the empty state.
+    const char* mapped_file = NULL;                 // List file to keep the replayed list in (NULL to keep it in memory).
+};
+
+/**
+ * @brief Results of the replay.
+ * 
+ * @note Latencies of the calls are collected by the latency tracer under list spans (see LatencyTrace_print()).
+ */
+struct ListReplayReport {
+    size_t calls = 0;               // Number of replayed calls.
+    size_t mismatches = 0;          // Calls that returned other positions than the recorded ones.
+    size_t size = 0;                // Size of the list after the replay.
+    double seconds = 0;             // Time the replay took (loading the trace excluded).
+};
+
+/**
+ * @brief Replay the trace on a new list.
+ * 
+ * @note The trace is read into memory first, so reading the file does not affect the measurements.
+ *       Latency trace is restarted, and calls are timed by the replay alone (LIST_TRACE is not needed).
+ * 
+ * @param file_name name of the trace file
+ * @param options way to replay the trace (NULL for the default one)
+ * @param[out] report results of the replay
+ * @param err_code variable to use as errno (EILSEQ if the trace does not match the replayed list)
+ */
+void List_replay(const char* file_name, const ListReplayOptions* const options, ListReplayReport* const report,
+                 int* const err_code = NULL);
+
+/**
+ * @brief Print throughput and latency percentiles of the replay.
+ * 
+ * @param report results of the replay
+ * @param stream stream to print to
+ */
+void List_print_replay(const ListReplayReport* const report, FILE* const stream);
+
+#endif
@@ -16,250 +16,2826 @@
 
 #include "listworks_.h"
 
+#include <new>
+#include <cmath>
+#include <utility>
 #include <time.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "list_config.h"
+#include "liststats.h"
+#include "listsorted_.h"
 
 _ListCell* _List_ptr_by_index(List* list, size_t index, int id);
 
-void List_ctor(List* list, size_t capacity, int* const err_code) {
+static void _List_unmap(List* const list, int* const err_code);
+static void _List_swap_cells(_ListCell* const buffer, const list_position_t alpha, const list_position_t beta);
+static void _List_materialize(List* const list, const size_t count);
+
+/**
+ * @brief Get cell the specified number of steps after the cell in the ring of cells [1, capacity).
+ * 
+ * @param list
+ * @param cell non-sentinel cell
+ * @param offset
+ * @return list_position_t
+ */
+static inline list_position_t _List_ring_cell(const List* const list, const list_position_t cell, const size_t offset) {
+    return (cell - 1 + offset) % (list->capacity - 1) + 1;
+}
+
+/**
+ * @brief Get the first of the consecutive cells holding elements of the linearized list.
+ * 
+ * @param list non-empty linearized list
+ * @return cell rotation cells before buffer->next
+ */
+static inline list_position_t _List_linear_base(const List* const list) {
+    return _List_ring_cell(list, list->buffer->next, list->capacity - 1 - list->rotation);
+}
+
+/**
+ * @brief Find the index'th element of the linearized list (counting along next links) by index arithmetic.
+ * 
+ * @param list non-empty linearized list
+ * @param index index of the element in [0, size)
+ * @return list_position_t
+ */
+static inline list_position_t _List_linear_cell(const List* const list, const size_t index) {
+    size_t offset = list->rotation + index;
+    if (offset >= list->size) offset -= list->size;
+
+    return _List_ring_cell(list, _List_linear_base(list), offset);
+}
+
+/**
+ * @brief Get the link leading to the next element in list order.
+ * 
+ * @param list
+ * @return member pointer to next link (prev link for reversed lists)
+ */
+static inline list_position_t _ListCell::* _List_forward(const List* const list) {
+    return list->reversed ? &_ListCell::prev : &_ListCell::next;
+}
+
+/**
+ * @brief Get the link leading to the previous element in list order.
+ * 
+ * @param list
+ * @return member pointer to prev link (next link for reversed lists)
+ */
+static inline list_position_t _ListCell::* _List_backward(const List* const list) {
+    return list->reversed ? &_ListCell::next : &_ListCell::prev;
+}
+
+/**
+ * @brief Get the cell the element inserted after the position is linked after (see List_reverse()).
+ * 
+ * @param list
+ * @param position position in list order
+ * @return list_position_t
+ */
+static inline list_position_t _List_anchor(const List* const list, const list_position_t position) {
+    return list->reversed ? list->buffer[position].prev : position;
+}
+
+/**
+ * @brief Check if the cell lies in the lazy region of the list.
+ * 
+ * @param list
+ * @param cell cell of the list buffer
+ * @return true if contents and links of the cell are not set
+ */
+static inline bool _List_is_lazy(const List* const list, const list_position_t cell) {
+    size_t ring = list->capacity - 1;
+    return cell != 0 && (cell + ring - list->lazy_begin) % ring < list->lazy_count;
+}
+
+/**
+ * @brief Check if the list keeps its cells in the SmallList holding it.
+ * 
+ * @param list
+ * @return true if the buffer must not be freed
+ */
+static inline bool _List_is_inline(const List* const list) {
+    return list->inline_buffer;
+}
+
+/**
+ * @brief Get number of bytes allocated for cells and payload of the list.
+ * 
+ * @param list
+ * @param cells number of cells to count (the capacity for the whole allocation)
+ * @return size_t
+ */
+static inline size_t _List_allocated_size(const List* const list, const size_t cells) {
+    size_t size = _List_is_inline(list) ? 0 : cells * sizeof(*list->buffer);
+    if (LIST_INDIRECT) size += cells * (sizeof(*list->payload) + sizeof(*list->free_slots));
+
+    return size;
+}
+
+/**
+ * @brief Take cell from the lazy region.
+ * 
+ * @param list list with non-empty lazy region
+ * @param last true to take the last cell of the region, false to take the first one
+ * @return list_position_t
+ */
+static inline list_position_t _List_take_lazy_cell(List* const list, const bool last) {
+    list_position_t cell = last ? _List_ring_cell(list, list->lazy_begin, list->lazy_count - 1) : list->lazy_begin;
+
+    if (!last) list->lazy_begin = _List_ring_cell(list, list->lazy_begin, 1);
+    --list->lazy_count;
+
+    return cell;
+}
+
+//* Overloads for both kinds of cell contents: elements themselves and handles of their payload slab slots.
+
+static inline list_elem_t* _List_payload(list_elem_t*, list_elem_t& content) { return &content; }
+static inline const list_elem_t* _List_payload(const list_elem_t*, const list_elem_t& content) { return &content; }
+static inline list_elem_t* _List_payload(list_elem_t* payload, const _ListHandle& handle) { return payload + handle.slot; }
+
+static inline bool _List_has_payload(const list_elem_t& content) { return content != LIST_ELEM_POISON; }
+static inline bool _List_has_payload(const _ListHandle& handle) { return handle.slot != 0; }
+
+static inline list_elem_t* _List_claim_payload(List* const, list_elem_t& content) { return &content; }
+static inline list_elem_t* _List_claim_payload(List* const list, _ListHandle& handle) {
+    handle.slot = list->free_slot_count ? list->free_slots[--list->free_slot_count] : list->used_slots++;
+    return list->payload + handle.slot;
+}
+
+static inline void _List_release_payload(List* const, list_elem_t& content) { content = LIST_ELEM_POISON; }
+static inline void _List_release_payload(List* const list, _ListHandle& handle) {
+    list->payload[handle.slot].~list_elem_t();
+    list->free_slots[list->free_slot_count++] = handle.slot;
+    handle = _ListHandle {};
+}
+
+static inline void _List_relocate_payload(list_elem_t*, list_elem_t*, const list_elem_t&) {}
+static inline void _List_relocate_payload(list_elem_t* target, list_elem_t* source, const _ListHandle& handle) {
+    new (target + handle.slot) list_elem_t(std::move(source[handle.slot]));
+    source[handle.slot].~list_elem_t();
+}
+
+/**
+ * @brief Get element of the cell.
+ * 
+ * @param list
+ * @param cell cell holding an element (or the sentinel)
+ * @return list_elem_t&
+ */
+static inline list_elem_t& _List_elem(const List* const list, const list_position_t cell) {
+    return *_List_payload(list->payload, list->buffer[cell].content);
+}
+
+/**
+ * @brief Get storage for the element of the free cell (elements of LIST_INDIRECT types get a slab slot).
+ * 
+ * @param list
+ * @param cell free cell
+ * @return uninitialized storage
+ */
+static inline list_elem_t* _List_claim(List* const list, const list_position_t cell) {
+    return _List_claim_payload(list, list->buffer[cell].content);
+}
+
+/**
+ * @brief Destroy element of the cell, leaving the cell empty.
+ * 
+ * @param list
+ * @param cell cell holding an element
+ */
+static inline void _List_release(List* const list, const list_position_t cell) {
+    _List_release_payload(list, list->buffer[cell].content);
+}
+
+//* Number of cells covered by one word of occupancy bitmaps.
+static const size_t LIST_OCCUPANCY_WORD_BITS = 64;
+
+static inline size_t _List_occupancy_words(const size_t capacity) {
+    return (capacity + LIST_OCCUPANCY_WORD_BITS - 1) / LIST_OCCUPANCY_WORD_BITS;
+}
+
+/**
+ * @brief Check if the cell holds an element.
+ * 
+ * @param list
+ * @param cell cell of the list buffer
+ * @return bool
+ */
+static inline bool _List_is_occupied(const List* const list, const list_position_t cell) {
+    if (list->occupancy) return (list->occupancy[cell / LIST_OCCUPANCY_WORD_BITS] >> (cell % LIST_OCCUPANCY_WORD_BITS)) & 1;
+    return !_List_is_lazy(list, cell) && _List_has_payload(list->buffer[cell].content);
+}
+
+/**
+ * @brief Set occupancy bit of the cell (does nothing for lists without the bitmap).
+ * 
+ * @param list
+ * @param cell
+ * @param occupied
+ */
+static inline void _List_mark_cell(List* const list, const list_position_t cell, const bool occupied) {
+    if (!list->occupancy) return;
+
+    uint64_t bit = (uint64_t)1 << (cell % LIST_OCCUPANCY_WORD_BITS);
+    if (occupied) list->occupancy[cell / LIST_OCCUPANCY_WORD_BITS] |= bit;
+    else          list->occupancy[cell / LIST_OCCUPANCY_WORD_BITS] &= ~bit;
+}
+
+/**
+ * @brief Find the next cell holding an element in buffer order.
+ * 
+ * @param list list with the occupancy bitmap
+ * @param cell cell to search after (0 to search from the start)
+ * @return list_position_t (0 if there are none)
+ */
+static inline list_position_t _List_next_occupied(const List* const list, const list_position_t cell) {
+    size_t start = cell + 1;
+    size_t word_id = start / LIST_OCCUPANCY_WORD_BITS;
+    size_t word_count = _List_occupancy_words(list->capacity);
+
+    if (word_id >= word_count) return 0;
+
+    uint64_t word = list->occupancy[word_id] & (~(uint64_t)0 << (start % LIST_OCCUPANCY_WORD_BITS));
+    while (word == 0) {
+        if (++word_id == word_count) return 0;
+        word = list->occupancy[word_id];
+    }
+
+    return word_id * LIST_OCCUPANCY_WORD_BITS + (size_t)__builtin_ctzll(word);
+}
+
+/**
+ * @brief Hash the cell index, links and contents.
+ * 
+ * @param list
+ * @param cell
+ * @return hash_t
+ */
+static inline hash_t _List_cell_checksum(const List* const list, const list_position_t cell) {
+    const _ListCell* data = list->buffer + cell;
+    const uint64_t links[3] = { cell, data->next, data->prev };
+
+    //* Only handles of LIST_INDIRECT elements are hashed, so checksums cost the same for elements of any size.
+    return get_simple_hash(&data->content, &data->content + 1, get_simple_hash(links, links + 3));
+}
+
+/**
+ * @brief Add hashes of the cells to the list checksum or remove them from it.
+ * 
+ * @note Repeated cells are counted once.
+ * 
+ * @param list
+ * @param cells sentinel or element cells changed by the operation
+ * @param count number of cells
+ * @param add true to add hashes, false to remove them
+ */
+static void _List_checksum_cells(List* const list, const list_position_t* const cells, const size_t count, const bool add) {
+    _ListExtras* extras = list->extras;
+    if (!extras) return;
+
+    for (size_t id = 0; id < count; ++id) {
+        bool repeated = false;
+        for (size_t other = 0; other < id; ++other) repeated |= cells[other] == cells[id];
+
+        if (repeated) continue;
+
+        hash_t hash = _List_cell_checksum(list, cells[id]);
+        extras->checksum = add ? extras->checksum + hash : extras->checksum - hash;
+    }
+}
+
+/**
+ * @brief Calculate the checksum of the sentinel and the elements from scratch.
+ * 
+ * @param list
+ * @return hash_t
+ */
+static hash_t _List_checksum_walk(const List* const list) {
+    hash_t checksum = _List_cell_checksum(list, 0);
+
+    size_t steps = 0;
+    for (list_position_t cell = list->buffer->next; cell != 0 && cell < list->capacity && steps < list->size;
+         cell = list->buffer[cell].next, ++steps) {
+        checksum += _List_cell_checksum(list, cell);
+    }
+
+    return checksum;
+}
+
+/**
+ * @brief Recalculate the list checksum after the links or contents were changed all over the list.
+ * 
+ * @param list list with valid links
+ */
+static inline void _List_checksum_rebuild(List* const list) {
+    if (list->extras) list->extras->checksum = _List_checksum_walk(list);
+}
+
+/**
+ * @brief Get the block of rarely used fields of the list, attaching it if there is none.
+ * 
+ * @note New blocks start with the checksum of the list as it is. Threads of List_for_each() may attach
+ *       the block (for counters) while elements change, but the checksum is rebuilt after them.
+ * 
+ * @param list list with valid links
+ * @return _ListExtras* (NULL if it could not be allocated)
+ */
+static _ListExtras* _List_extras(List* const list) {
+    _ListExtras* extras = __atomic_load_n(&list->extras, __ATOMIC_ACQUIRE);
+    if (extras) return extras;
+
+    extras = (_ListExtras*) calloc(1, sizeof(*extras));
+    if (!extras) return NULL;
+
+    *extras = _ListExtras {};
+    extras->checksum = _List_checksum_walk(list);
+
+    _ListExtras* expected = NULL;
+    if (!__atomic_compare_exchange_n(&list->extras, &expected, extras, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        free(extras);
+        return expected;
+    }
+
+    return extras;
+}
+
+/**
+ * @brief Check list fields and links of the sentinel in O(1) time.
+ * 
+ * @param list
+ * @param probe_buffer true to check the buffer with check_ptr() (takes a few system calls), false to only check it for NULL
+ * @return list_report_t
+ */
+static list_report_t _List_check_fields(const List* const list, const bool probe_buffer) {
+    list_report_t report = 0;
+
+    if (list->size >= list->capacity) report |= LIST_BIG_SIZE;
+    if (probe_buffer ? !check_ptr(list->buffer) : !list->buffer) return report | LIST_NULL_CONTENT;
+
+    if (list->capacity < 2 || list->lazy_begin == 0 || list->lazy_begin >= list->capacity ||
+        list->lazy_count >= list->capacity) return report | LIST_INV_FREE;
+
+    if (list->first_empty >= list->capacity || (list->linearized && list->first_empty != 0)) report |= LIST_INV_FREE;
+    if (list->rotation && (!list->linearized || list->rotation >= list->size)) report |= LIST_INV_CONNECTIONS;
+
+    const _ListCell* buffer = list->buffer;
+    if (buffer->next >= list->capacity || buffer->prev >= list->capacity) return report | LIST_INV_CONNECTIONS;
+
+    if (buffer[buffer->next].prev != 0 || buffer[buffer->prev].next != 0 ||
+        (buffer->next == 0) != (list->size == 0)) report |= LIST_INV_CONNECTIONS;
+
+    return report;
+}
+
+/**
+ * @brief Get the observer of the list.
+ * 
+ * @param list
+ * @return list_observer_t* (NULL if there is none)
+ */
+static inline list_observer_t* _List_observer(const List* const list) {
+    return list->extras ? list->extras->observer : NULL;
+}
+
+/**
+ * @brief Check the list the way its check mode says.
+ * 
+ * @param list
+ * @return list_report_t
+ */
+static list_report_t _List_verify(List* const list) {
+    if (!list) return LIST_NULL;
+    if (list->check_mode == LIST_CHECK_FULL) return List_status(list);
+
+    list_report_t report = _List_check_fields(list, false);
+    _ListExtras* extras = list->extras;
+    if (report || !extras || extras->audit_interval == 0) return report;
+
+    bool audit = false;
+
+    if (list->check_mode == LIST_CHECK_PERIODIC) {
+        audit = extras->audit_state <= 1;
+        extras->audit_state = audit ? extras->audit_interval : extras->audit_state - 1;
+    } else {
+        uint64_t random = extras->audit_state;
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+        extras->audit_state = random;
+
+        audit = random % extras->audit_interval == 0;
+    }
+
+    return audit ? List_status(list) : 0;
+}
+
+#include "listpolicy.h"
+
+/**
+ * @brief Report successful change of the list to its observer.
+ * 
+ * @param list
+ * @param event
+ * @param position
+ * @param elem
+ * @param result
+ */
+static inline void _List_notify(List* const list, const ListEvent event, const list_position_t position = 0,
+                                const list_elem_t* elem = NULL, const list_position_t result = 0) {
+    _ListExtras* extras = list->extras;
+    if (extras && extras->observer) extras->observer(event, position, elem, result, extras->observer_ctx);
+}
+
+#include "listsorted.h"
+
+void List_ctor(List* list, size_t capacity, int* const err_code, const AllocSite site) {
+    static const PageAllocOptions heap = {};
+    List_ctor_with(list, capacity, &heap, err_code, site);
+}
+
+/**
+ * @brief Initialize list of the specified size in the given buffer or in a new one.
+ * 
+ * @param list list to initialize
+ * @param capacity max number of elements the list can hold +1 empty element
+ * @param options way to allocate buffers of the list
+ * @param inline_cells buffer of capacity cells owned by the object holding the list (NULL to allocate one)
+ * @param err_code variable to use as errno
+ * @param site place the list is attributed to in the allocation profile
+ */
+static void _List_ctor_in(List* list, size_t capacity, const PageAllocOptions* const options, _ListCell* const inline_cells,
+                          int* const err_code, const AllocSite site) {
     _LOG_FAIL_CHECK_(check_ptr(list), "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(options,         "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(capacity > 1,    "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    list->pages = *options;
+    list->growable = false;
+    list->inline_buffer = inline_cells != NULL;
+
+    if (inline_cells) {
+        list->buffer = inline_cells;
+        list->mapped_size = 0;
+    } else {
+        list->buffer = (_ListCell*) page_alloc(capacity * sizeof(*list->buffer), options, &list->mapped_size,
+                                               &list->pages.pages, err_code);
+    }
+
+    _LOG_FAIL_CHECK_(list->buffer, "error", ERROR_REPORTS, return, err_code, ENOMEM);
+
+    if (LIST_INDIRECT) {
+        list->payload = (list_elem_t*) calloc(capacity, sizeof(*list->payload));
+        list->free_slots = (size_t*) calloc(capacity, sizeof(*list->free_slots));
+        list->free_slot_count = 0;
+        list->used_slots = 1;
+
+        _LOG_FAIL_CHECK_(list->payload && list->free_slots, "error", ERROR_REPORTS, {
+            if (!_List_is_inline(list)) page_free(list->buffer, list->mapped_size);
+            free(list->payload);
+            free(list->free_slots);
+            *list = List {};
+            return;
+        }, err_code, ENOMEM);
+    }
+
+    //* Only the sentinel is set, the rest of the buffer is left to the lazy region.
+    list->buffer[0] = _ListCell {};
+    _List_checksum_rebuild(list);
+
+    list->capacity = capacity;
+    list->first_empty = 0;
+    list->lazy_begin = 1;
+    list->lazy_count = capacity - 1;
+    list->size = 0;
+    list->rotation = 0;
+    list->linearized = true;
+    list->reversed = false;
+
+    SILENCE_UNUSED(site);
+    _LIST_PROFILE_(alloc_profile_add(list, _List_allocated_size(list, capacity), site));
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return, err_code, EAGAIN);
+}
+
+void List_ctor_with(List* list, size_t capacity, const PageAllocOptions* const options, int* const err_code,
+                    const AllocSite site) {
+    int error = 0;
+    _List_ctor_in(list, capacity, options, NULL, &error, site);
+    _LOG_FAIL_CHECK_(error == 0, "error", ERROR_REPORTS, return, err_code, error);
+
+    _LOG_FAIL_CHECK_(_List_extras(list), "error", ERROR_REPORTS, {
+        List_dtor(list);
+        return;
+    }, err_code, ENOMEM);
+}
+
+void List_ctor_small(SmallList* small, int* const err_code, const AllocSite site) {
+    _LOG_FAIL_CHECK_(small, "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    static const PageAllocOptions heap = {};
+    int error = 0;
+
+#if LIST_INLINE_CELLS > 0
+    _List_ctor_in(&small->list, LIST_INLINE_CELLS, &heap, small->inline_cells, &error, site);
+#else
+    _List_ctor_in(&small->list, 2, &heap, NULL, &error, site);
+#endif
+
+    _LOG_FAIL_CHECK_(error == 0, "error", ERROR_REPORTS, return, err_code, error);
+
+    small->list.growable = true;
+}
+
+void List_dtor(List* list, int* const err_code) {
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    if (LIST_INDIRECT) {
+        for (list_position_t cell = list->buffer->next; cell != 0; cell = list->buffer[cell].next) _List_elem(list, cell).~list_elem_t();
+    }
+
+    //* Cells that never left the lazy region were never used.
+    _LIST_PROFILE_(alloc_profile_remove(list, _List_allocated_size(list, list->capacity - list->lazy_count)));
+
+    if      (list->mapping)          _List_unmap(list, err_code);
+    else if (!_List_is_inline(list)) page_free(list->buffer, list->mapped_size);
+    free(list->payload);
+    free(list->free_slots);
+    if (list->extras) free(list->extras->stats);
+    free(list->extras);
+    free(list->policy);
+    free(list->occupancy);
+    _List_sorted_dtor(list);
+
+    list->buffer = NULL;
+    list->payload = NULL;
+    list->free_slots = NULL;
+    list->free_slot_count = 0;
+    list->used_slots = 0;
+    list->occupancy = NULL;
+    list->mapped_size = 0;
+    list->extras = NULL;
+    list->policy = NULL;
+    list->capacity = 0;
+    list->first_empty = 0;
+    list->lazy_begin = 0;
+    list->lazy_count = 0;
+    list->size = 0;
+    list->reversed = false;
+    list->growable = false;
+    list->inline_buffer = false;
+}
+
+void List_dtor_void(List* const list) { List_dtor(list, NULL); }
+
+/**
+ * @brief Close element ring of the buffer with cells [1, size] linked in index order, leave the rest to the lazy region.
+ * 
+ * @param list list the buffer belongs to (with valid size and capacity)
+ * @param buffer buffer to close the ring in
+ */
+static void _List_close_linear_rings(List* const list, _ListCell* const buffer) {
+    buffer[0].next = list->size ? 1 : 0;
+    buffer[0].prev = list->size;
+    buffer[1].prev = 0;
+    buffer[list->size].next = 0;
+
+    list->first_empty = 0;
+    list->lazy_begin = list->size + 1 < list->capacity ? list->size + 1 : 1;
+    list->lazy_count = list->capacity - 1 - list->size;
+    list->rotation = 0;
+
+    if (!list->occupancy) return;
+
+    //* Cells [1, size] hold elements.
+    size_t end = list->size + 1;
+    memset(list->occupancy, 0, _List_occupancy_words(list->capacity) * sizeof(*list->occupancy));
+
+    for (size_t word_id = 0; word_id < end / LIST_OCCUPANCY_WORD_BITS; ++word_id) list->occupancy[word_id] = ~(uint64_t)0;
+    if (end % LIST_OCCUPANCY_WORD_BITS) list->occupancy[end / LIST_OCCUPANCY_WORD_BITS] = ((uint64_t)1 << (end % LIST_OCCUPANCY_WORD_BITS)) - 1;
+
+    _List_mark_cell(list, 0, false);
+}
+
+/**
+ * @brief Exchange places of two cells keeping both of them in their rings.
+ * 
+ * @note Cells may be neighbours or even share the ring of two, so links are swapped first and fixed afterwards.
+ * 
+ * @param buffer
+ * @param alpha
+ * @param beta
+ */
+static void _List_swap_cells(_ListCell* const buffer, const list_position_t alpha, const list_position_t beta) {
+    _ListCell alpha_copy = buffer[alpha];
+    buffer[alpha] = buffer[beta];
+    buffer[beta] = alpha_copy;
+
+    const list_position_t swapped[2] = { alpha, beta };
+
+    for (list_position_t cell : swapped) {
+        list_position_t* links[2] = { &buffer[cell].next, &buffer[cell].prev };
+        for (list_position_t* link : links) {
+            if      (*link == alpha) *link = beta;
+            else if (*link == beta)  *link = alpha;
+        }
+    }
+
+    for (list_position_t cell : swapped) {
+        buffer[buffer[cell].next].prev = cell;
+        buffer[buffer[cell].prev].next = cell;
+    }
+}
+
+/**
+ * @brief Move element to the free cell keeping it in the element ring.
+ * 
+ * @param buffer
+ * @param cell cell of the element
+ * @param target free cell (its ring is not fixed)
+ */
+static void _List_move_cell(_ListCell* const buffer, const list_position_t cell, const list_position_t target) {
+    buffer[target] = buffer[cell];
+    buffer[buffer[target].next].prev = target;
+    buffer[buffer[target].prev].next = target;
+    buffer[cell].content = LIST_EMPTY_CONTENT;
+}
+
+void List_linearize(List* const list, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_LINEARIZE);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    _ListCell* buffer = list->buffer;
+    list_position_t cell = buffer->next;
+    size_t index = 0;
+
+    //* All free cells end up in the lazy region, so elements are moved to free cells without fixing their ring.
+    //* Lazy region is only changed at the end, and elements are never moved into the same cell twice,
+    //* so target cells from it are still free.
+    while (cell != 0) {
+        list_position_t target_spot = (index++) + 1;
+
+        if (cell != target_spot) {
+            if (_List_is_occupied(list, target_spot)) {
+                _List_swap_cells(buffer, cell, target_spot);
+            } else {
+                _List_move_cell(buffer, cell, target_spot);
+                _List_mark_cell(list, target_spot, true);
+                _List_mark_cell(list, cell, false);
+            }
+        }
+
+        cell = buffer[target_spot].next;
+    }
+
+    _List_close_linear_rings(list, buffer);
+
+    list->linearized = true;
+    _List_checksum_rebuild(list);
+    if (list->sorted) _List_sorted_rebuild(list);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return, err_code, EAGAIN);
+    _LIST_COUNT_(list, LIST_COUNTER_LINEARIZE, 1);
+    _List_notify(list, LIST_EVENT_LINEARIZE);
+}
+
+double List_fragmentation(List* const list, int* const err_code) {
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+
+    if (list->linearized || list->size < 2) return 0;
+
+    _ListCell* buffer = list->buffer;
+    size_t scattered_links = 0;
+
+    for (list_position_t cell = buffer->next; buffer[cell].next != 0; cell = buffer[cell].next) {
+        if (buffer[cell].next != cell + 1) ++scattered_links;
+    }
+
+    return (double)scattered_links / (double)(list->size - 1);
+}
+
+void List_track_occupancy(List* const list, const bool enable, int* const err_code) {
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    _ListCell* buffer = list->buffer;
+
+    if (!enable) {
+        if (!list->occupancy) return;
+
+        for (list_position_t cell = buffer->next; cell != 0; cell = buffer[cell].next) {
+            _LOG_FAIL_CHECK_(_List_elem(list, cell) != LIST_ELEM_POISON, "error", ERROR_REPORTS, return, err_code, EINVAL);
+        }
+
+        free(list->occupancy);
+        list->occupancy = NULL;
+        return;
+    }
+
+    if (list->occupancy) return;
+
+    list->occupancy = (uint64_t*) calloc(_List_occupancy_words(list->capacity), sizeof(*list->occupancy));
+    _LOG_FAIL_CHECK_(list->occupancy, "error", ERROR_REPORTS, return, err_code, ENOMEM);
+
+    for (list_position_t cell = buffer->next; cell != 0; cell = buffer[cell].next) _List_mark_cell(list, cell, true);
+}
+
+void List_set_checks(List* const list, const ListCheckMode mode, const size_t audit_interval, int* const err_code) {
+    _LOG_FAIL_CHECK_(List_status(list) == 0,     "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(mode <= LIST_CHECK_SAMPLED, "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    //* Lists that never run audits need no audit state.
+    _ListExtras* extras = audit_interval || list->extras ? _List_extras(list) : NULL;
+    _LOG_FAIL_CHECK_(extras || audit_interval == 0, "error", ERROR_REPORTS, return, err_code, ENOMEM);
+
+    list->check_mode = mode;
+    if (!extras) return;
+
+    extras->audit_interval = audit_interval;
+    extras->audit_state = mode == LIST_CHECK_SAMPLED ? 0x9E3779B97F4A7C15 : audit_interval;
+}
+
+/**
+ * @brief Partition of the list into sublists that can be walked by separate threads.
+ * 
+ */
+struct _ListSplit {
+    list_position_t* heads = NULL;      // First cell of every sublist.
+    list_position_t* saved_prev = NULL; // Original prev links of the tagged heads.
+    size_t* lengths = NULL;             // Number of elements in every sublist.
+    size_t* successors = NULL;          // Id of the following sublist (count for the last one).
+    size_t* order = NULL;               // Sublist ids in list order.
+    size_t* offsets = NULL;             // Index of the first sublist element in the list.
+    size_t count = 0;
+};
+
+//* Sublist heads are marked by setting the highest bit of their prev link (which makes it invalid).
+static const list_position_t LIST_HEAD_TAG = (list_position_t)1 << (sizeof(list_position_t) * 8 - 1);
+
+static inline list_position_t _List_head_tag(const size_t sublist_id) { return LIST_HEAD_TAG | sublist_id; }
+static inline bool _List_is_head_tag(const list_position_t link) { return link & LIST_HEAD_TAG; }
+static inline size_t _List_tag_id(const list_position_t link) { return link & ~LIST_HEAD_TAG; }
+
+struct _ListTaskArgs {
+    List* list = NULL;
+    _ListSplit* split = NULL;
+    _ListCell* target = NULL;
+    size_t chunk_count = 0;
+    list_visitor_t* visitor = NULL;
+    list_reducer_t* reducer = NULL;
+    list_elem_t* partials = NULL;
+    void* ctx = NULL;
+};
+
+static void _List_measure_task(size_t task_id, void* args) {
+    _ListTaskArgs* task = (_ListTaskArgs*) args;
+    _ListSplit* split = task->split;
+    _ListCell* buffer = task->list->buffer;
+
+    list_position_t cell = buffer[split->heads[task_id]].next;
+    size_t length = 1;
+
+    while (cell != 0 && !_List_is_head_tag(buffer[cell].prev)) {
+        cell = buffer[cell].next;
+        ++length;
+    }
+
+    split->lengths[task_id] = length;
+    split->successors[task_id] = cell == 0 ? split->count : _List_tag_id(buffer[cell].prev);
+}
+
+static void _List_split_dtor(List* const list, _ListSplit* const split) {
+    if (split->saved_prev) {
+        for (size_t id = 0; id < split->count; ++id) list->buffer[split->heads[id]].prev = split->saved_prev[id];
+    }
+
+    free(split->heads);
+    free(split->saved_prev);
+    free(split->lengths);
+    free(split->successors);
+    free(split->order);
+    free(split->offsets);
+
+    *split = _ListSplit {};
+}
+
+/**
+ * @brief Split non-empty list into sublists and rank them.
+ * 
+ * @note Linearized lists are cut arithmetically, other lists are cut at sampled
+ *       occupied cells which are then walked in parallel to find sublist order.
+ * 
+ * @param list
+ * @param pool
+ * @param split
+ * @return true on success, false if there was not enough memory
+ */
+static bool _List_split_ctor(List* const list, ThreadPool* const pool, _ListSplit* const split) {
+    size_t count = ThreadPool_size(pool) * LIST_SUBLISTS_PER_THREAD;
+    if (count > list->size) count = list->size;
+
+    _ListCell* buffer = list->buffer;
+
+    *split = _ListSplit {};
+    split->heads = (list_position_t*) calloc(count, sizeof(*split->heads));
+    split->lengths = (size_t*) calloc(count, sizeof(*split->lengths));
+    split->successors = (size_t*) calloc(count, sizeof(*split->successors));
+    split->order = (size_t*) calloc(count, sizeof(*split->order));
+    split->offsets = (size_t*) calloc(count, sizeof(*split->offsets));
+
+    if (!split->heads || !split->lengths || !split->successors || !split->order || !split->offsets) {
+        _List_split_dtor(list, split);
+        return false;
+    }
+
+    if (list->linearized) {
+        for (size_t id = 0; id < count; ++id) {
+            split->offsets[id] = id * list->size / count;
+            split->heads[id] = _List_linear_cell(list, split->offsets[id]);
+            split->lengths[id] = (id + 1) * list->size / count - split->offsets[id];
+            split->successors[id] = id + 1;
+            split->order[id] = id;
+        }
+
+        split->count = count;
+        return true;
+    }
+
+    split->saved_prev = (list_position_t*) calloc(count, sizeof(*split->saved_prev));
+    if (!split->saved_prev) {
+        _List_split_dtor(list, split);
+        return false;
+    }
+
+    split->heads[0] = buffer->next;
+    split->saved_prev[0] = buffer[buffer->next].prev;
+    buffer[buffer->next].prev = _List_head_tag(0);
+    split->count = 1;
+
+    list_position_t lazy_end = _List_ring_cell(list, list->lazy_begin, list->lazy_count);
+
+    for (size_t sample = 1; sample < count; ++sample) {
+        list_position_t cell = 1 + sample * (list->capacity - 1) / count;
+
+        while (cell < list->capacity && (!_List_is_occupied(list, cell) || _List_is_head_tag(buffer[cell].prev))) {
+            if (_List_is_lazy(list, cell)) cell = lazy_end > cell ? lazy_end : list->capacity;
+            else                           ++cell;
+        }
+        if (cell == list->capacity) break;
+
+        split->heads[split->count] = cell;
+        split->saved_prev[split->count] = buffer[cell].prev;
+        buffer[cell].prev = _List_head_tag(split->count);
+        ++split->count;
+    }
+
+    _ListTaskArgs args = {};
+    args.list = list;
+    args.split = split;
+
+    ThreadPool_run(pool, _List_measure_task, &args, split->count);
+
+    size_t offset = 0;
+    size_t sublist_id = 0;
+    for (size_t rank = 0; rank < split->count; ++rank) {
+        split->order[rank] = sublist_id;
+        split->offsets[sublist_id] = offset;
+        offset += split->lengths[sublist_id];
+        sublist_id = split->successors[sublist_id];
+    }
+
+    return true;
+}
+
+static void _List_scatter_task(size_t task_id, void* args) {
+    _ListTaskArgs* task = (_ListTaskArgs*) args;
+    _ListSplit* split = task->split;
+    _ListCell* buffer = task->list->buffer;
+
+    list_position_t cell = split->heads[task_id];
+    _ListCell* target = task->target + split->offsets[task_id] + 1;
+
+    for (size_t id = 0; id < split->lengths[task_id]; ++id) {
+        target[id].content = buffer[cell].content;
+        cell = buffer[cell].next;
+    }
+}
+
+static void _List_relink_task(size_t task_id, void* args) {
+    _ListTaskArgs* task = (_ListTaskArgs*) args;
+    size_t size = task->list->size;
+
+    //* Free cells of the new buffer are left to the lazy region.
+    size_t begin = 1 + task_id * size / task->chunk_count;
+    size_t end = 1 + (task_id + 1) * size / task->chunk_count;
+
+    for (size_t id = begin; id < end; ++id) {
+        task->target[id].next = id + 1;
+        task->target[id].prev = id - 1;
+    }
+}
+
+void List_linearize_parallel(List* const list, ThreadPool* const pool, int* const err_code) {
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    if (ThreadPool_size(pool) == 1 || list->size < LIST_PARALLEL_MIN_SIZE) {
+        List_linearize(list, err_code);
+        return;
+    }
+
+    _LIST_TRACE_(LIST_SPAN_LINEARIZE);
+
+    //* File-mapped lists only need a scratch buffer, the rest get a new one allocated like the old one.
+    size_t target_mapped_size = 0;
+    _ListCell* target = (_ListCell*) page_alloc(list->capacity * sizeof(*target), list->mapping ? NULL : &list->pages,
+                                                &target_mapped_size);
+    _LOG_FAIL_CHECK_(target, "error", ERROR_REPORTS, return, err_code, ENOMEM);
+
+    _ListSplit split = {};
+    _LOG_FAIL_CHECK_(_List_split_ctor(list, pool, &split), "error", ERROR_REPORTS, {
+        page_free(target, target_mapped_size);
+        return;
+    }, err_code, ENOMEM);
+
+    _ListTaskArgs args = {};
+    args.list = list;
+    args.split = &split;
+    args.target = target;
+    args.chunk_count = ThreadPool_size(pool) * LIST_SUBLISTS_PER_THREAD;
+
+    ThreadPool_run(pool, _List_scatter_task, &args, split.count);
+    ThreadPool_run(pool, _List_relink_task, &args, args.chunk_count);
+
+    _List_split_dtor(list, &split);
+
+    target->content = list->buffer->content;
+    _List_close_linear_rings(list, target);
+
+    //* Mapped and inline buffers have to stay in place, so the result is copied back into them.
+    if (list->mapping || _List_is_inline(list)) {
+        memcpy(list->buffer, target, list->capacity * sizeof(*target));
+        page_free(target, target_mapped_size);
+    } else {
+        page_free(list->buffer, list->mapped_size);
+        list->buffer = target;
+        list->mapped_size = target_mapped_size;
+    }
+
+    list->linearized = true;
+    _List_checksum_rebuild(list);
+    if (list->sorted) _List_sorted_rebuild(list);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return, err_code, EAGAIN);
+    _LIST_COUNT_(list, LIST_COUNTER_LINEARIZE, 1);
+    _List_notify(list, LIST_EVENT_LINEARIZE);
+}
+
+static void _List_visit_task(size_t task_id, void* args) {
+    _ListTaskArgs* task = (_ListTaskArgs*) args;
+    _ListSplit* split = task->split;
+    _ListCell* buffer = task->list->buffer;
+
+    list_position_t cell = split->heads[task_id];
+    for (size_t id = 0; id < split->lengths[task_id]; ++id) {
+        task->visitor(&_List_elem(task->list, cell), task->ctx);
+        cell = buffer[cell].next;
+    }
+}
+
+void List_for_each(List* const list, list_visitor_t* visitor, void* ctx, ThreadPool* const pool, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_TRAVERSE);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(visitor, "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    _ListCell* buffer = list->buffer;
+
+    if (ThreadPool_size(pool) == 1 || list->size < LIST_PARALLEL_MIN_SIZE) {
+        for (list_position_t cell = buffer->next; cell != 0; cell = buffer[cell].next) visitor(&_List_elem(list, cell), ctx);
+        _List_checksum_rebuild(list);
+        if (list->sorted) _List_sorted_restore(list);
+        _LIST_COUNT_(list, LIST_COUNTER_TRAVERSE, 1);
+        _List_notify(list, LIST_EVENT_MODIFY);
+        return;
+    }
+
+    _ListSplit split = {};
+    _LOG_FAIL_CHECK_(_List_split_ctor(list, pool, &split), "error", ERROR_REPORTS, return, err_code, ENOMEM);
+
+    _ListTaskArgs args = {};
+    args.list = list;
+    args.split = &split;
+    args.visitor = visitor;
+    args.ctx = ctx;
+
+    ThreadPool_run(pool, _List_visit_task, &args, split.count);
+
+    _List_split_dtor(list, &split);
+    _List_checksum_rebuild(list);
+    if (list->sorted) _List_sorted_restore(list);
+    _LIST_COUNT_(list, LIST_COUNTER_TRAVERSE, 1);
+    _List_notify(list, LIST_EVENT_MODIFY);
+}
+
+static void _List_reduce_task(size_t task_id, void* args) {
+    _ListTaskArgs* task = (_ListTaskArgs*) args;
+    _ListSplit* split = task->split;
+    _ListCell* buffer = task->list->buffer;
+
+    list_position_t cell = split->heads[task_id];
+    list_elem_t accumulator = _List_elem(task->list, cell);
+
+    for (size_t id = 1; id < split->lengths[task_id]; ++id) {
+        cell = buffer[cell].next;
+        accumulator = task->reducer(accumulator, _List_elem(task->list, cell), task->ctx);
+    }
+
+    task->partials[task_id] = accumulator;
+}
+
+list_elem_t List_reduce(List* const list, list_reducer_t* reducer, const list_elem_t initial, void* ctx,
+                        ThreadPool* const pool, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_TRAVERSE);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return initial, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(reducer, "error", ERROR_REPORTS, return initial, err_code, EINVAL);
+
+    _LIST_COUNT_(list, LIST_COUNTER_TRAVERSE, 1);
+
+    _ListCell* buffer = list->buffer;
+    list_elem_t result = initial;
+
+    //* Chunks are folded along next links, so reversed lists are folded on the calling thread.
+    if (ThreadPool_size(pool) == 1 || list->size < LIST_PARALLEL_MIN_SIZE || list->reversed) {
+        list_position_t _ListCell::* forward = _List_forward(list);
+
+        for (list_position_t cell = buffer->*forward; cell != 0; cell = buffer[cell].*forward)
+            result = reducer(result, _List_elem(list, cell), ctx);
+        return result;
+    }
+
+    _ListSplit split = {};
+    _LOG_FAIL_CHECK_(_List_split_ctor(list, pool, &split), "error", ERROR_REPORTS, return initial, err_code, ENOMEM);
+
+    _ListTaskArgs args = {};
+    args.list = list;
+    args.split = &split;
+    args.reducer = reducer;
+    args.ctx = ctx;
+    args.partials = (list_elem_t*) calloc(split.count, sizeof(*args.partials));
+
+    _LOG_FAIL_CHECK_(args.partials, "error", ERROR_REPORTS, {
+        _List_split_dtor(list, &split);
+        return initial;
+    }, err_code, ENOMEM);
+
+    ThreadPool_run(pool, _List_reduce_task, &args, split.count);
+
+    for (size_t rank = 0; rank < split.count; ++rank) {
+        result = reducer(result, args.partials[split.order[rank]], ctx);
+    }
+
+    free(args.partials);
+    _List_split_dtor(list, &split);
+
+    return result;
+}
+
+/**
+ * @brief Unlink cell from the ring of free cells.
+ * 
+ * @param list
+ * @param cell free cell to take
+ */
+static inline void _List_take_free_cell(List* const list, const list_position_t cell) {
+    _ListCell* buffer = list->buffer;
+
+    if (buffer[cell].next == cell) {
+        list->first_empty = 0;
+        return;
+    }
+
+    buffer[buffer[cell].prev].next = buffer[cell].next;
+    buffer[buffer[cell].next].prev = buffer[cell].prev;
+
+    if (list->first_empty == cell) list->first_empty = buffer[cell].next;
+}
+
+/**
+ * @brief Link cell into the ring of free cells right before the first empty one.
+ * 
+ * @param list
+ * @param cell unlinked cell to free
+ * @param keep_first_empty true to leave the first empty cell as is, false to make the cell the first empty one
+ */
+static inline void _List_put_free_cell(List* const list, const list_position_t cell, const bool keep_first_empty) {
+    _ListCell* buffer = list->buffer;
+
+    if (list->first_empty == 0) {
+        buffer[cell].next = cell;
+        buffer[cell].prev = cell;
+        list->first_empty = cell;
+        return;
+    }
+
+    buffer[cell].next = list->first_empty;
+    buffer[cell].prev = buffer[list->first_empty].prev;
+    buffer[buffer[cell].prev].next = cell;
+    buffer[list->first_empty].prev = cell;
+
+    if (!keep_first_empty) list->first_empty = cell;
+}
+
+/**
+ * @brief Link first cells of the lazy region into the ring of free cells (in the same order).
+ * 
+ * @param list
+ * @param count number of cells to take from the lazy region
+ */
+static void _List_materialize(List* const list, const size_t count) {
+    for (size_t id = 0; id < count; ++id) {
+        list_position_t cell = _List_take_lazy_cell(list, false);
+        list->buffer[cell].content = LIST_EMPTY_CONTENT;
+        _List_put_free_cell(list, cell, true);
+    }
+}
+
+/**
+ * @brief Take the cell for the element about to be inserted after the position.
+ * 
+ * @param list list with a free cell
+ * @param position
+ * @return free cell (its contents and links are not set)
+ */
+static list_position_t _List_take_cell(List* const list, const list_position_t position) {
+    _ListCell* buffer = list->buffer;
+
+    //* Free cells of linearized lists surround the elements, so ends of the lazy region are taken.
+    //* Ends of rotated lists meet inside the run of elements, so they have no free neighbours.
+    if (list->linearized && list->rotation == 0 && (position == 0 || position == buffer->prev)) {
+        _LIST_COUNT_(list, LIST_COUNTER_FAST_PATH, 1);
+        return _List_take_lazy_cell(list, position != buffer->prev);
+    }
+
+    if (list->linearized) _LIST_COUNT_(list, LIST_COUNTER_DELINEARIZE, 1);
+    _LIST_COUNT_(list, LIST_COUNTER_SLOW_PATH, 1);
+    if (list->policy) _List_policy_update(list, position, true);
+    list->linearized = false;
+    list->rotation = 0;
+
+    //* Reused cells go first, so the list only touches new memory when it has to.
+    if (list->first_empty == 0) return _List_take_lazy_cell(list, false);
+
+    list_position_t cell = list->first_empty;
+    _List_take_free_cell(list, cell);
+
+    return cell;
+}
+
+/**
+ * @brief Link the cell with a new element after the position.
+ * 
+ * @param list
+ * @param cell cell taken by _List_take_cell() with its element set
+ * @param position
+ */
+static void _List_link_cell(List* const list, const list_position_t cell, const list_position_t position) {
+    _ListCell* buffer = list->buffer;
+
+    _List_mark_cell(list, cell, true);
+
+    list_position_t prev_nbor = position;
+    list_position_t next_nbor = buffer[prev_nbor].next;
+
+    const list_position_t changed[3] = { prev_nbor, next_nbor, cell };
+    _List_checksum_cells(list, changed, 2, false);
+    
+    buffer[cell].next = next_nbor;
+    buffer[cell].prev = prev_nbor;
+    buffer[prev_nbor].next = cell;
+    buffer[next_nbor].prev = cell;
+
+    _List_checksum_cells(list, changed, 3, true);
+
+    ++list->size;
+}
+
+/**
+ * @brief Double the buffer of the full growable list.
+ * 
+ * @note New cells make the lazy region, cells keep their indices.
+ *       Linearized lists stay linearized unless their elements wrapped around the end of the old buffer.
+ *       Mapped buffers keep the size of their files, so they refuse to grow.
+ * 
+ * @param list list without free cells
+ * @param err_code variable to use as errno
+ */
+static void _List_grow(List* const list, int* const err_code) {
+    _LOG_FAIL_CHECK_(!list->mapping, "error", ERROR_REPORTS, return, err_code, ENOMEM);
+
+    size_t old_capacity = list->capacity;
+    size_t capacity = old_capacity * 2;
+
+    //* Everything is allocated first, so the list is left untouched on failure.
+    size_t mapped_size = 0;
+    _ListCell* buffer = (_ListCell*) page_alloc(capacity * sizeof(*buffer), &list->pages, &mapped_size);
+    uint64_t* occupancy = list->occupancy ? (uint64_t*) calloc(_List_occupancy_words(capacity), sizeof(*occupancy)) : NULL;
+    size_t* node_of = list->sorted ? (size_t*) calloc(capacity, sizeof(*node_of)) : NULL;
+    list_elem_t* payload = LIST_INDIRECT ? (list_elem_t*) calloc(capacity, sizeof(*payload)) : NULL;
+    size_t* free_slots = LIST_INDIRECT ? (size_t*) calloc(capacity, sizeof(*free_slots)) : NULL;
+
+    _LOG_FAIL_CHECK_(buffer && (occupancy || !list->occupancy) && (node_of || !list->sorted) &&
+                     ((payload && free_slots) || !LIST_INDIRECT), "error", ERROR_REPORTS, {
+        if (buffer) page_free(buffer, mapped_size);
+        free(occupancy);
+        free(node_of);
+        free(payload);
+        free(free_slots);
+        return;
+    }, err_code, ENOMEM);
+
+    memcpy(buffer, list->buffer, old_capacity * sizeof(*buffer));
+    if (!_List_is_inline(list)) page_free(list->buffer, list->mapped_size);
+
+    list->buffer = buffer;
+    list->mapped_size = mapped_size;
+    list->capacity = capacity;
+    list->inline_buffer = false;
+
+    _LIST_PROFILE_(alloc_profile_resize(list, _List_allocated_size(list, capacity)));
+
+    if (occupancy) {
+        memcpy(occupancy, list->occupancy, _List_occupancy_words(old_capacity) * sizeof(*occupancy));
+        free(list->occupancy);
+        list->occupancy = occupancy;
+    }
+
+    if (node_of) {
+        memcpy(node_of, list->sorted->node_of, old_capacity * sizeof(*node_of));
+        free(list->sorted->node_of);
+        list->sorted->node_of = node_of;
+    }
+
+    if (LIST_INDIRECT) {
+        for (list_position_t cell = buffer->next; cell != 0; cell = buffer[cell].next)
+            _List_relocate_payload(payload, list->payload, buffer[cell].content);
+
+        memcpy(free_slots, list->free_slots, list->free_slot_count * sizeof(*free_slots));
+        free(list->payload);
+        free(list->free_slots);
+        list->payload = payload;
+        list->free_slots = free_slots;
+    }
+
+    //* Full lists have no free cells, so the new ones make the whole lazy region.
+    list->first_empty = 0;
+    list->lazy_begin = old_capacity;
+    list->lazy_count = capacity - old_capacity;
+
+    //* Ring arithmetic of elements that wrapped around the old end no longer holds.
+    if (list->linearized && _List_linear_base(list) > 1) {
+        _LIST_COUNT_(list, LIST_COUNTER_DELINEARIZE, 1);
+        list->linearized = false;
+        list->rotation = 0;
+    }
+
+    if (list->policy) {
+        list->policy->run_length = 0;
+        list->policy->rebuilding = false;
+    }
+}
+
+list_position_t List_insert(List* const list, list_elem_t elem, const list_position_t position, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_INSERT);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0,            "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(position < list->capacity,          "error", ERROR_REPORTS, return 0, err_code, EINVAL);
+
+    if (list->growable && list->size + 1 == list->capacity) {
+        int error = 0;
+        _List_grow(list, &error);
+        _LOG_FAIL_CHECK_(error == 0, "error", ERROR_REPORTS, return 0, err_code, error);
+    }
+
+    _LOG_FAIL_CHECK_(list->size + 1 < list->capacity,    "error", ERROR_REPORTS, return 0, err_code, ENOMEM);
+    _LOG_FAIL_CHECK_(!list->sorted || _List_sorted_fits(list, elem, position),
+                     "error", ERROR_REPORTS, return 0, err_code, EINVAL);
+
+    list_position_t anchor = _List_anchor(list, position);
+    list_position_t pasted_cell = _List_take_cell(list, anchor);
+
+    //* Parameter is moved into its storage, so rvalue elements are never copied.
+    new (_List_claim(list, pasted_cell)) list_elem_t(std::move(elem));
+    _List_link_cell(list, pasted_cell, anchor);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return 0, err_code, EAGAIN);
+
+    _LIST_TRACK_PEAK_(list);
+    _LIST_COUNT_(list, LIST_COUNTER_INSERT, 1);
+    _List_notify(list, LIST_EVENT_INSERT, position, &_List_elem(list, pasted_cell), pasted_cell);
+
+    return pasted_cell;
+}
+
+list_position_t List_emplace(List* const list, const list_position_t position, list_constructor_t* constructor, void* ctx,
+                             int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_INSERT);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0,            "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(position < list->capacity,          "error", ERROR_REPORTS, return 0, err_code, EINVAL);
+    _LOG_FAIL_CHECK_(constructor && !list->sorted,       "error", ERROR_REPORTS, return 0, err_code, EINVAL);
+
+    if (list->growable && list->size + 1 == list->capacity) {
+        int error = 0;
+        _List_grow(list, &error);
+        _LOG_FAIL_CHECK_(error == 0, "error", ERROR_REPORTS, return 0, err_code, error);
+    }
+
+    _LOG_FAIL_CHECK_(list->size + 1 < list->capacity,    "error", ERROR_REPORTS, return 0, err_code, ENOMEM);
+
+    list_position_t anchor = _List_anchor(list, position);
+    list_position_t pasted_cell = _List_take_cell(list, anchor);
+
+    constructor(_List_claim(list, pasted_cell), ctx);
+    _List_link_cell(list, pasted_cell, anchor);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return 0, err_code, EAGAIN);
+
+    _LIST_TRACK_PEAK_(list);
+    _LIST_COUNT_(list, LIST_COUNTER_INSERT, 1);
+    _List_notify(list, LIST_EVENT_INSERT, position, &_List_elem(list, pasted_cell), pasted_cell);
+
+    return pasted_cell;
+}
+
+/**
+ * @brief Find position of the index'th element in the list.
+ * 
+ * @param list 
+ * @param index index of the element
+ * @param err_code variable to use as errno
+ * @return list_position_t
+ */
+static list_position_t _List_find_position(List* const list, int index, int* const err_code) {
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+
+    _LOG_FAIL_CHECK_((-(int)list->size <= index && index < (int)list->size) || list->size == 0, "error", ERROR_REPORTS, {
+        log_printf(ERROR_REPORTS, "error", "Requested index was %d with size %lld.\n", index, (long long) list->size);
+        return 0;
+    }, err_code, EFAULT);
+
+    _LIST_COUNT_(list, LIST_COUNTER_FIND_POSITION, 1);
+
+    if (list->size == 0) return 0;
+
+    //* Elements of reversed lists are counted from the other end of the links.
+    if (list->reversed) index = -1 - index;
+
+    if (list->policy && !list->linearized) _List_policy_prepare(list);
+
+    if (list->linearized) {
+        _LIST_COUNT_(list, LIST_COUNTER_FAST_PATH, 1);
+        return _List_linear_cell(list, index >= 0 ? (size_t)index : list->size - (size_t)(-(long long)index));
+    }
+
+    if (list->policy) return _List_policy_find(list, index);
+
+    list_position_t current = index >= 0 ? list->buffer->next : list->buffer->prev;
+    int steps = index >= 0 ? index : -index - 1;
+
+    _LIST_COUNT_(list, LIST_COUNTER_SLOW_PATH, 1);
+    _LIST_COUNT_(list, LIST_COUNTER_FIND_STEPS, (unsigned long long)steps);
+
+    for (int id = 0; id < steps; ++id) {
+        current = index >= 0 ? list->buffer[current].next : list->buffer[current].prev;
+    }
+
+    return current;
+}
+
+list_position_t List_find_position(List* const list, const int index, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_FIND_POSITION);
+
+    int error = 0;
+    list_position_t position = _List_find_position(list, index, &error);
+    _LOG_FAIL_CHECK_(error == 0, "error", ERROR_REPORTS, return 0, err_code, error);
+
+    _List_notify(list, LIST_EVENT_FIND_POSITION, (list_position_t)(long long)index, NULL, position);
+
+    return position;
+}
+
+list_elem_t List_get(List* const list, const list_position_t position, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_GET);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0,         "error", ERROR_REPORTS, return LIST_ELEM_POISON, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(position < list->capacity,       "error", ERROR_REPORTS, return LIST_ELEM_POISON, err_code, EINVAL);
+    _LOG_FAIL_CHECK_(_List_is_occupied(list, position), "error", ERROR_REPORTS, return LIST_ELEM_POISON, err_code, EINVAL);
+
+    _LIST_COUNT_(list, LIST_COUNTER_GET, 1);
+    _List_notify(list, LIST_EVENT_GET, position);
+
+    return _List_elem(list, position);
+}
+
+/**
+ * @brief Count index of the element from buffer->next (the head of non-reversed lists).
+ * 
+ * @param list
+ * @param index valid index (negative to count from the tail)
+ * @return size_t
+ */
+static inline size_t _List_target_index(const List* const list, const int index) {
+    size_t target = index >= 0 ? (size_t)index : list->size - (size_t)(-(long long)index);
+    return list->reversed ? list->size - 1 - target : target;
+}
+
+/**
+ * @brief Get number of first elements found by index arithmetic.
+ * 
+ * @note Elements of linearized lists are found with _List_linear_cell(), the rest lie in consecutive cells.
+ * 
+ * @param list
+ * @param[out] first cell of the first element
+ * @return size_t
+ */
+static inline size_t _List_ordered_prefix(const List* const list, list_position_t* const first) {
+    *first = list->buffer->next;
+
+    if (list->linearized) return list->size;
+    if (!list->policy)    return 0;
+
+    *first = list->policy->run_start;
+    return list->policy->run_length;
+}
+
+/**
+ * @brief Get cell of the element in the ordered prefix of the list.
+ * 
+ * @param list
+ * @param first cell of the first element (see _List_ordered_prefix())
+ * @param target index of the element counting along next links
+ * @return list_position_t
+ */
+static inline list_position_t _List_ordered_cell(const List* const list, const list_position_t first, const size_t target) {
+    return list->linearized ? _List_linear_cell(list, target) : _List_ring_cell(list, first, target);
+}
+
+/**
+ * @brief Check the index and let the policy prepare the list before the lookup.
+ * 
+ * @param list valid list
+ * @param index
+ * @return false if the index is out of range
+ */
+static bool _List_prepare_lookup(List* const list, const int index) {
+    _LOG_FAIL_CHECK_((-(int)list->size <= index && index < (int)list->size) || list->size == 0, "error", ERROR_REPORTS, {
+        log_printf(ERROR_REPORTS, "error", "Requested index was %d with size %lld.\n", index, (long long) list->size);
+        return false;
+    }, NULL, 0);
+
+    _LIST_COUNT_(list, LIST_COUNTER_FIND_POSITION, 1);
+
+    if (list->size && list->policy && !list->linearized) _List_policy_prepare(list);
+
+    return true;
+}
+
+/**
+ * @brief Lookup of the batch.
+ * 
+ */
+struct _ListLookup {
+    size_t target = 0;      // Index of the element counted from the head.
+    size_t slot = 0;        // Index of the answer.
+};
+
+static int _List_compare_lookups(const void* alpha, const void* beta) {
+    size_t alpha_target = ((const _ListLookup*) alpha)->target;
+    size_t beta_target = ((const _ListLookup*) beta)->target;
+
+    return (alpha_target > beta_target) - (alpha_target < beta_target);
+}
+
+void List_find_positions(List* const list, const int* indices, const size_t count, list_position_t* const positions,
+                         list_elem_t* const values, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_FIND_POSITION);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0,              "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(count == 0 || (indices && positions), "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    for (size_t id = 0; id < count; ++id) {
+        _LOG_FAIL_CHECK_((-(int)list->size <= indices[id] && indices[id] < (int)list->size) || list->size == 0,
+                         "error", ERROR_REPORTS, return, err_code, EFAULT);
+    }
+
+    _LIST_COUNT_(list, LIST_COUNTER_FIND_POSITION, count);
+
+    //* The policy prepares the list once for the whole batch.
+    if (count && list->size && list->policy && !list->linearized) _List_policy_prepare(list);
+
+    _ListCell* buffer = list->buffer;
+    list_position_t first = 0;
+    size_t ordered = _List_ordered_prefix(list, &first);
+
+    _ListLookup* lookups = NULL;
+    if (ordered < list->size) {
+        lookups = (_ListLookup*) calloc(count, sizeof(*lookups));
+        _LOG_FAIL_CHECK_(lookups || count == 0, "error", ERROR_REPORTS, return, err_code, ENOMEM);
+    }
+
+    size_t scattered = 0;
+    for (size_t id = 0; id < count; ++id) {
+        size_t target = _List_target_index(list, indices[id]);
+
+        if (list->size == 0)       positions[id] = 0;
+        else if (target < ordered) positions[id] = _List_ordered_cell(list, first, target);
+        else                       lookups[scattered++] = { target, id };
+    }
+
+    _LIST_COUNT_(list, LIST_COUNTER_FAST_PATH, count - scattered);
+
+    if (scattered) {
+        qsort(lookups, scattered, sizeof(*lookups), _List_compare_lookups);
+
+        //* Targets closer to the tail are walked to from it, the rest from the last ordered element.
+        size_t split = 0;
+        while (split < scattered && lookups[split].target + 1 - ordered <= list->size - lookups[split].target) ++split;
+
+        size_t steps = 0;
+        size_t scattered_steps = 0;
+
+        list_position_t current = ordered ? (first + ordered - 2) % (list->capacity - 1) + 1 : 0;
+        size_t reached = ordered;
+        for (size_t id = 0; id < split; ++id) {
+            for (; reached <= lookups[id].target; ++reached, ++steps) {
+                list_position_t next = buffer[current].next;
+                if (next != current + 1) ++scattered_steps;
+                current = next;
+            }
+
+            positions[lookups[id].slot] = current;
+        }
+
+        current = 0;
+        reached = list->size;
+        for (size_t id = scattered; id > split; --id) {
+            for (; reached > lookups[id - 1].target; --reached, ++steps) {
+                list_position_t prev = buffer[current].prev;
+                if (prev + 1 != current) ++scattered_steps;
+                current = prev;
+            }
+
+            positions[lookups[id - 1].slot] = current;
+        }
+
+        _LIST_COUNT_(list, LIST_COUNTER_SLOW_PATH, 1);
+        _LIST_COUNT_(list, LIST_COUNTER_FIND_STEPS, (unsigned long long)steps);
+
+        if (list->policy) list->policy->waste += (double)steps + (list->policy->config.scattered_step_cost - 1) * (double)scattered_steps;
+    }
+
+    free(lookups);
+
+    if (values) for (size_t id = 0; id < count; ++id) values[id] = _List_elem(list, positions[id]);
+}
+
+/**
+ * @brief Lookup walking its list in List_find_positions_multi().
+ * 
+ */
+struct _ListWalk {
+    const _ListCell* buffer = NULL;     // Buffer of the list (NULL for idle walks).
+    list_position_t cell = 0;
+    size_t steps = 0;                   // Number of links left to follow.
+    bool forward = true;
+    size_t slot = 0;                    // Index of the answer.
+};
+
+/**
+ * @brief Answer next lookups until one of them has to follow links, then start its walk.
+ * 
+ * @param lists
+ * @param indices
+ * @param count
+ * @param[in, out] next_lookup first lookup not answered or started yet
+ * @param[out] positions
+ * @param[out] values
+ * @param[out] walk walk to start
+ * @return false if there are no lookups left to walk
+ */
+static bool _List_start_walk(List* const* lists, const int* indices, const size_t count, size_t* const next_lookup,
+                             list_position_t* const positions, list_elem_t* const values, _ListWalk* const walk) {
+    for (; *next_lookup < count; ++*next_lookup) {
+        size_t id = *next_lookup;
+        List* list = lists[id];
+        size_t target = _List_target_index(list, indices[id]);
+
+        list_position_t first = 0;
+        size_t ordered = _List_ordered_prefix(list, &first);
+
+        if (list->size == 0 || target < ordered) {
+            positions[id] = list->size ? _List_ordered_cell(list, first, target) : 0;
+            if (values) values[id] = _List_elem(list, positions[id]);
+
+            _LIST_COUNT_(list, LIST_COUNTER_FAST_PATH, 1);
+            continue;
+        }
+
+        size_t forward_steps = target + 1 - ordered;
+        size_t backward_steps = list->size - target;
+
+        walk->buffer = list->buffer;
+        walk->forward = forward_steps <= backward_steps;
+        walk->cell = walk->forward && ordered ? (first + ordered - 2) % (list->capacity - 1) + 1 : 0;
+        walk->steps = walk->forward ? forward_steps : backward_steps;
+        walk->slot = id;
+
+        __builtin_prefetch(walk->buffer + walk->cell);
+
+        _LIST_COUNT_(list, LIST_COUNTER_SLOW_PATH, 1);
+        _LIST_COUNT_(list, LIST_COUNTER_FIND_STEPS, (unsigned long long)walk->steps);
+
+        ++*next_lookup;
+        return true;
+    }
+
+    walk->buffer = NULL;
+    return false;
+}
+
+void List_find_positions_multi(List* const* lists, const int* indices, const size_t count, list_position_t* const positions,
+                               list_elem_t* const values, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_FIND_POSITION);
+
+    _LOG_FAIL_CHECK_(count == 0 || (lists && indices && positions), "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    //* Lists are prepared before any walk starts, so policies can not move cells of found elements.
+    for (size_t id = 0; id < count; ++id) {
+        if (id == 0 || lists[id] != lists[id - 1])
+            _LOG_FAIL_CHECK_(_List_verify(lists[id]) == 0, "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+        _LOG_FAIL_CHECK_(_List_prepare_lookup(lists[id], indices[id]), "error", ERROR_REPORTS, return, err_code, EFAULT);
+    }
+
+    _ListWalk walks[LIST_LOOKUP_GROUP] = {};
+    size_t next_lookup = 0;
+    size_t in_flight = 0;
+
+    for (size_t walk_id = 0; walk_id < LIST_LOOKUP_GROUP; ++walk_id) {
+        if (_List_start_walk(lists, indices, count, &next_lookup, positions, values, walks + walk_id)) ++in_flight;
+    }
+
+    //* Every walk takes one step per round, by then the cell prefetched for it a round ago has arrived.
+    while (in_flight) {
+        for (size_t walk_id = 0; walk_id < LIST_LOOKUP_GROUP; ++walk_id) {
+            _ListWalk* walk = walks + walk_id;
+            if (!walk->buffer) continue;
+
+            if (walk->steps == 0) {
+                positions[walk->slot] = walk->cell;
+                if (values) values[walk->slot] = _List_elem(lists[walk->slot], walk->cell);
+
+                if (!_List_start_walk(lists, indices, count, &next_lookup, positions, values, walk)) --in_flight;
+                continue;
+            }
+
+            walk->cell = walk->forward ? walk->buffer[walk->cell].next : walk->buffer[walk->cell].prev;
+            --walk->steps;
+
+            __builtin_prefetch(walk->buffer + walk->cell);
+        }
+    }
+}
+
+//* Scan adapters: overloads for element types strided_scan kernels support, plain loops otherwise.
+//* All of them process count cells starting with the one the base pointer belongs to
+//* (plain loops also take handles of LIST_INDIRECT elements and get elements from the payload slab).
+
+template <typename content_t>
+static inline size_t _List_scan_find(const content_t* base, const size_t count, const list_elem_t value, list_elem_t* payload) {
+    const _ListCell* cell = (const _ListCell*) base;
+    for (size_t id = 0; id < count; ++id) {
+        if (*_List_payload(payload, cell[id].content) == value) return id;
+    }
+    return count;
+}
+static inline size_t _List_scan_find(const int* base, size_t count, int value, list_elem_t*) { return strided_find_i32(base, sizeof(_ListCell), count, value); }
+static inline size_t _List_scan_find(const long* base, size_t count, long value, list_elem_t*) { return strided_find_i64(base, sizeof(_ListCell), count, value); }
+static inline size_t _List_scan_find(const long long* base, size_t count, long long value, list_elem_t*) { return strided_find_i64(base, sizeof(_ListCell), count, value); }
+static inline size_t _List_scan_find(const double* base, size_t count, double value, list_elem_t*) { return strided_find_f64(base, sizeof(_ListCell), count, value); }
+
+template <typename content_t>
+static inline size_t _List_scan_count(const content_t* base, const size_t count, const list_elem_t value, list_elem_t* payload) {
+    const _ListCell* cell = (const _ListCell*) base;
+    size_t result = 0;
+    for (size_t id = 0; id < count; ++id) {
+        if (*_List_payload(payload, cell[id].content) == value) ++result;
+    }
+    return result;
+}
+static inline size_t _List_scan_count(const int* base, size_t count, int value, list_elem_t*) { return strided_count_i32(base, sizeof(_ListCell), count, value); }
+static inline size_t _List_scan_count(const long* base, size_t count, long value, list_elem_t*) { return strided_count_i64(base, sizeof(_ListCell), count, value); }
+static inline size_t _List_scan_count(const long long* base, size_t count, long long value, list_elem_t*) { return strided_count_i64(base, sizeof(_ListCell), count, value); }
+static inline size_t _List_scan_count(const double* base, size_t count, double value, list_elem_t*) { return strided_count_f64(base, sizeof(_ListCell), count, value); }
+
+/**
+ * @brief Split circular storage of the linearized list into (at most) four runs of consecutive cells.
+ * 
+ * @note Runs follow next links: elements from buffer->next to the end of the block come first, the rotated ones
+ *       from its start go after them, and each of these parts splits in two if it wraps around the last cell.
+ * 
+ * @param list linearized list
+ * @param[out] firsts first cells of the runs
+ * @param[out] counts numbers of elements in the runs
+ * @return number of runs
+ */
+static inline size_t _List_linear_runs(const List* const list, list_position_t* const firsts, size_t* const counts) {
+    const list_position_t starts[2] = { list->buffer->next, _List_linear_base(list) };
+    const size_t lengths[2] = { list->size - list->rotation, list->rotation };
+    size_t run_count = 0;
+
+    for (size_t part = 0; part < 2; ++part) {
+        size_t till_end = list->capacity - starts[part];
+        size_t first_count = lengths[part] < till_end ? lengths[part] : till_end;
+
+        if (first_count) {
+            firsts[run_count] = starts[part];
+            counts[run_count++] = first_count;
+        }
+
+        if (lengths[part] > first_count) {
+            firsts[run_count] = 1;
+            counts[run_count++] = lengths[part] - first_count;
+        }
+    }
+
+    return run_count;
+}
+
+/**
+ * @brief Find the last element equal to the value among consecutive cells.
+ * 
+ * @param list
+ * @param first first cell to scan
+ * @param count number of cells to scan
+ * @param value
+ * @return position of the element or 0 if there is none
+ */
+static list_position_t _List_scan_find_last(const List* const list, const list_position_t first, const size_t count,
+                                            const list_elem_t value) {
+    list_position_t found = 0;
+
+    for (size_t offset = 0; offset < count;) {
+        size_t index = _List_scan_find(&list->buffer[first + offset].content, count - offset, value, list->payload);
+        if (index == count - offset) break;
+
+        found = first + offset + index;
+        offset += index + 1;
+    }
+
+    return found;
+}
+
+list_position_t List_find_value(List* const list, const list_elem_t value, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_SCAN);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+
+    _LIST_COUNT_(list, LIST_COUNTER_SCAN, 1);
+    _LIST_COUNT_(list, list->linearized ? LIST_COUNTER_FAST_PATH : LIST_COUNTER_SLOW_PATH, 1);
+
+    _ListCell* buffer = list->buffer;
+
+    if (list->size == 0) return 0;
+
+    if (list->linearized) {
+        list_position_t firsts[4] = {};
+        size_t counts[4] = {};
+        size_t run_count = _List_linear_runs(list, firsts, counts);
+
+        //* The first element of the reversed list is the last match along next links.
+        if (list->reversed) {
+            for (size_t run = run_count; run > 0; --run) {
+                list_position_t found = _List_scan_find_last(list, firsts[run - 1], counts[run - 1], value);
+                if (found) return found;
+            }
+
+            return 0;
+        }
+
+        for (size_t run = 0; run < run_count; ++run) {
+            size_t index = _List_scan_find(&buffer[firsts[run]].content, counts[run], value, list->payload);
+            if (index < counts[run]) return firsts[run] + index;
+        }
+
+        return 0;
+    }
+
+    list_position_t _ListCell::* forward = _List_forward(list);
+
+    for (list_position_t cell = buffer->*forward; cell != 0; cell = buffer[cell].*forward) {
+        if (_List_elem(list, cell) == value) return cell;
+    }
+
+    return 0;
+}
+
+size_t List_count(List* const list, const list_elem_t value, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_SCAN);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+
+    _LIST_COUNT_(list, LIST_COUNTER_SCAN, 1);
+    _LIST_COUNT_(list, list->linearized ? LIST_COUNTER_FAST_PATH : LIST_COUNTER_SLOW_PATH, 1);
+
+    _ListCell* buffer = list->buffer;
+
+    if (list->size == 0) return 0;
+
+    size_t result = 0;
+
+    if (list->linearized) {
+        list_position_t firsts[4] = {};
+        size_t counts[4] = {};
+        size_t run_count = _List_linear_runs(list, firsts, counts);
+
+        for (size_t run = 0; run < run_count; ++run) {
+            result += _List_scan_count(&buffer[firsts[run]].content, counts[run], value, list->payload);
+        }
+
+        return result;
+    }
+
+    //* Order does not matter, so the bitmap is swept instead of following links.
+    if (list->occupancy) {
+        for (list_position_t cell = _List_next_occupied(list, 0); cell != 0; cell = _List_next_occupied(list, cell)) {
+            if (_List_elem(list, cell) == value) ++result;
+        }
+
+        return result;
+    }
+
+    for (list_position_t cell = buffer->next; cell != 0; cell = buffer[cell].next) {
+        if (_List_elem(list, cell) == value) ++result;
+    }
+
+    return result;
+}
+
+#ifndef LIST_NO_ARITHMETIC
+
+template <typename content_t>
+static inline list_elem_t _List_scan_min(const content_t* base, const size_t count, list_elem_t* payload) {
+    const _ListCell* cell = (const _ListCell*) base;
+    list_elem_t result = *_List_payload(payload, cell[0].content);
+    for (size_t id = 1; id < count; ++id) {
+        const list_elem_t& elem = *_List_payload(payload, cell[id].content);
+        if (elem < result) result = elem;
+    }
+    return result;
+}
+static inline int _List_scan_min(const int* base, size_t count, list_elem_t*) { return strided_min_i32(base, sizeof(_ListCell), count); }
+static inline long _List_scan_min(const long* base, size_t count, list_elem_t*) { return strided_min_i64(base, sizeof(_ListCell), count); }
+static inline long long _List_scan_min(const long long* base, size_t count, list_elem_t*) { return strided_min_i64(base, sizeof(_ListCell), count); }
+static inline double _List_scan_min(const double* base, size_t count, list_elem_t*) { return strided_min_f64(base, sizeof(_ListCell), count); }
+
+template <typename content_t>
+static inline list_elem_t _List_scan_max(const content_t* base, const size_t count, list_elem_t* payload) {
+    const _ListCell* cell = (const _ListCell*) base;
+    list_elem_t result = *_List_payload(payload, cell[0].content);
+    for (size_t id = 1; id < count; ++id) {
+        const list_elem_t& elem = *_List_payload(payload, cell[id].content);
+        if (result < elem) result = elem;
+    }
+    return result;
+}
+static inline int _List_scan_max(const int* base, size_t count, list_elem_t*) { return strided_max_i32(base, sizeof(_ListCell), count); }
+static inline long _List_scan_max(const long* base, size_t count, list_elem_t*) { return strided_max_i64(base, sizeof(_ListCell), count); }
+static inline long long _List_scan_max(const long long* base, size_t count, list_elem_t*) { return strided_max_i64(base, sizeof(_ListCell), count); }
+static inline double _List_scan_max(const double* base, size_t count, list_elem_t*) { return strided_max_f64(base, sizeof(_ListCell), count); }
+
+template <typename content_t>
+static inline list_elem_t _List_scan_sum(const content_t* base, const size_t count, list_elem_t* payload) {
+    const _ListCell* cell = (const _ListCell*) base;
+    list_elem_t result = {};
+    for (size_t id = 0; id < count; ++id) result = result + *_List_payload(payload, cell[id].content);
+    return result;
+}
+static inline int _List_scan_sum(const int* base, size_t count, list_elem_t*) { return (int)strided_sum_i32(base, sizeof(_ListCell), count); }
+static inline long _List_scan_sum(const long* base, size_t count, list_elem_t*) { return strided_sum_i64(base, sizeof(_ListCell), count); }
+static inline long long _List_scan_sum(const long long* base, size_t count, list_elem_t*) { return strided_sum_i64(base, sizeof(_ListCell), count); }
+static inline double _List_scan_sum(const double* base, size_t count, list_elem_t*) { return strided_sum_f64(base, sizeof(_ListCell), count); }
+
+//* Only floating point elements can be NaNs.
+template <typename elem_t>
+static inline bool _List_is_nan(const elem_t&) { return false; }
+static inline bool _List_is_nan(const float& value) { return std::isnan(value); }
+static inline bool _List_is_nan(const double& value) { return std::isnan(value); }
+static inline bool _List_is_nan(const long double& value) { return std::isnan(value); }
+
+/**
+ * @brief Count NaNs heading the segment of consecutive cells.
+ * 
+ * @param list
+ * @param first first cell of the segment
+ * @param count number of cells in the segment
+ * @return size_t
+ */
+static inline size_t _List_leading_nans(const List* const list, const list_position_t first, const size_t count) {
+    size_t skipped = 0;
+    while (skipped < count && _List_is_nan(_List_elem(list, first + skipped))) ++skipped;
+    return skipped;
+}
+
+//* Scans seed their result with the first value, so segment scans start after their leading NaNs.
+//* NaNs elsewhere never compare less or greater, and the result does not depend on the order of segments.
+
+/**
+ * @brief Lower the minimum with values of the segment of consecutive cells.
+ * 
+ * @param list linearized list
+ * @param first first cell of the segment
+ * @param count number of cells in the segment
+ * @param result minimum of other values (not a NaN)
+ * @return list_elem_t
+ */
+static inline list_elem_t _List_segment_min(const List* const list, const list_position_t first, const size_t count,
+                                            const list_elem_t result) {
+    size_t skipped = _List_leading_nans(list, first, count);
+    if (skipped == count) return result;
+
+    list_elem_t segment = _List_scan_min(&list->buffer[first + skipped].content, count - skipped, list->payload);
+    return segment < result ? segment : result;
+}
+
+/**
+ * @brief Raise the maximum with values of the segment of consecutive cells.
+ * 
+ * @param list linearized list
+ * @param first first cell of the segment
+ * @param count number of cells in the segment
+ * @param result maximum of other values (not a NaN)
+ * @return list_elem_t
+ */
+static inline list_elem_t _List_segment_max(const List* const list, const list_position_t first, const size_t count,
+                                            const list_elem_t result) {
+    size_t skipped = _List_leading_nans(list, first, count);
+    if (skipped == count) return result;
+
+    list_elem_t segment = _List_scan_max(&list->buffer[first + skipped].content, count - skipped, list->payload);
+    return result < segment ? segment : result;
+}
 
-    list->buffer = (_ListCell*) calloc(capacity, sizeof(*list->buffer));
+list_elem_t List_min(List* const list, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_SCAN);
 
-    _LOG_FAIL_CHECK_(list->buffer, "error", ERROR_REPORTS, return, err_code, ENOMEM);
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return LIST_ELEM_POISON, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(list->size > 0,         "error", ERROR_REPORTS, return LIST_ELEM_POISON, err_code, ENOENT);
 
-    for (size_t id = 0; id < capacity; ++id) {
-        _ListCell* cell = list->buffer + id;
-        *cell = _ListCell {};
-        cell->next = cell + 1;
-        cell->prev = cell - 1;
+    _LIST_COUNT_(list, LIST_COUNTER_SCAN, 1);
+    _LIST_COUNT_(list, list->linearized ? LIST_COUNTER_FAST_PATH : LIST_COUNTER_SLOW_PATH, 1);
+
+    _ListCell* buffer = list->buffer;
+
+    //* The result starts at the head of the list in its logical order, a NaN there is the result.
+    list_elem_t result = _List_elem(list, buffer->*_List_forward(list));
+    if (_List_is_nan(result)) return result;
+
+    if (list->linearized) {
+        list_position_t firsts[4] = {};
+        size_t counts[4] = {};
+        size_t run_count = _List_linear_runs(list, firsts, counts);
+
+        for (size_t run = 0; run < run_count; ++run) result = _List_segment_min(list, firsts[run], counts[run], result);
+        return result;
     }
 
-    list->buffer[0].next = list->buffer;
-    list->buffer[0].prev = list->buffer;
-    list->buffer[capacity - 1].next = list->buffer + 1;
-    list->buffer[1].prev = list->buffer + capacity - 1;
+    if (list->occupancy) {
+        for (list_position_t cell = _List_next_occupied(list, 0); cell != 0; cell = _List_next_occupied(list, cell)) {
+            if (_List_elem(list, cell) < result) result = _List_elem(list, cell);
+        }
 
-    list->capacity = capacity;
-    list->first_empty = list->buffer + 1;
-    list->size = 0;
+        return result;
+    }
 
-    _LOG_FAIL_CHECK_(List_status(list) == 0, "error", ERROR_REPORTS, return, err_code, EAGAIN);
+    for (list_position_t cell = buffer->next; cell != 0; cell = buffer[cell].next) {
+        if (_List_elem(list, cell) < result) result = _List_elem(list, cell);
+    }
+
+    return result;
 }
 
-void List_dtor(List* list, int* const err_code) {
-    _LOG_FAIL_CHECK_(List_status(list) == 0, "error", ERROR_REPORTS, return, err_code, EFAULT);
+list_elem_t List_max(List* const list, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_SCAN);
 
-    free(list->buffer);
-    
-    list->buffer = NULL;
-    list->capacity = 0;
-    list->first_empty = NULL;
-    list->size = 0;
-}
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return LIST_ELEM_POISON, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(list->size > 0,         "error", ERROR_REPORTS, return LIST_ELEM_POISON, err_code, ENOENT);
 
-void List_dtor_void(List* const list) { List_dtor(list, NULL); }
+    _LIST_COUNT_(list, LIST_COUNTER_SCAN, 1);
+    _LIST_COUNT_(list, list->linearized ? LIST_COUNTER_FAST_PATH : LIST_COUNTER_SLOW_PATH, 1);
 
-void List_linearize(List* const list, int* const err_code) {
-    _LOG_FAIL_CHECK_(List_status(list) == 0, "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _ListCell* buffer = list->buffer;
 
-    _ListCell* cell = list->buffer->next;
-    size_t index = 0;
+    //* The result starts at the head of the list in its logical order, a NaN there is the result.
+    list_elem_t result = _List_elem(list, buffer->*_List_forward(list));
+    if (_List_is_nan(result)) return result;
+
+    if (list->linearized) {
+        list_position_t firsts[4] = {};
+        size_t counts[4] = {};
+        size_t run_count = _List_linear_runs(list, firsts, counts);
 
-    while (cell != list->buffer) {
-        _ListCell* target_spot = list->buffer + (index++) + 1;
+        for (size_t run = 0; run < run_count; ++run) result = _List_segment_max(list, firsts[run], counts[run], result);
+        return result;
+    }
 
-        target_spot->next->prev = cell;
-        if (target_spot == cell->next) {
-            target_spot->prev = target_spot;
-            cell->next = cell;
-        } else {
-            target_spot->prev->next = cell;
-            cell->next->prev = target_spot;
-            cell->prev->next = target_spot;
+    if (list->occupancy) {
+        for (list_position_t cell = _List_next_occupied(list, 0); cell != 0; cell = _List_next_occupied(list, cell)) {
+            if (result < _List_elem(list, cell)) result = _List_elem(list, cell);
         }
 
-        _ListCell cell_copy = *cell;
-        *cell = *target_spot;
-        *target_spot = cell_copy;
+        return result;
+    }
 
-        cell = target_spot->next;
+    for (list_position_t cell = buffer->next; cell != 0; cell = buffer[cell].next) {
+        if (result < _List_elem(list, cell)) result = _List_elem(list, cell);
     }
 
-    list->first_empty = list->buffer + list->size + 1;
+    return result;
+}
+
+list_elem_t List_sum(List* const list, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_SCAN);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return LIST_ELEM_POISON, err_code, EFAULT);
+
+    _LIST_COUNT_(list, LIST_COUNTER_SCAN, 1);
+    _LIST_COUNT_(list, list->linearized ? LIST_COUNTER_FAST_PATH : LIST_COUNTER_SLOW_PATH, 1);
 
-    for (size_t id = 1; id < list->capacity; ++id) {
-        list->buffer[id].next = list->buffer + id + 1;
-        list->buffer[id].prev = list->buffer + id - 1;
+    _ListCell* buffer = list->buffer;
+    list_elem_t result = {};
+
+    if (list->size == 0) return result;
+
+    if (list->linearized) {
+        list_position_t firsts[4] = {};
+        size_t counts[4] = {};
+        size_t run_count = _List_linear_runs(list, firsts, counts);
+
+        result = _List_scan_sum(&buffer[firsts[0]].content, counts[0], list->payload);
+        for (size_t run = 1; run < run_count; ++run) result = result + _List_scan_sum(&buffer[firsts[run]].content, counts[run], list->payload);
+
+        return result;
     }
 
-    list->buffer[list->size].next = list->buffer;
-    list->buffer->prev = list->buffer + list->size;
+    if (list->occupancy) {
+        for (list_position_t cell = _List_next_occupied(list, 0); cell != 0; cell = _List_next_occupied(list, cell)) {
+            result = result + _List_elem(list, cell);
+        }
 
-    list->buffer[list->size + 1].prev = list->buffer + list->capacity - 1;
-    list->buffer[list->capacity - 1].next = list->buffer + list->size + 1;
+        return result;
+    }
 
-    list->linearized = true;
+    for (list_position_t cell = buffer->next; cell != 0; cell = buffer[cell].next) {
+        result = result + _List_elem(list, cell);
+    }
 
-    _LOG_FAIL_CHECK_(List_status(list) == 0, "error", ERROR_REPORTS, return, err_code, EAGAIN);
+    return result;
 }
 
-list_position_t List_insert(List* const list, const list_elem_t elem, const list_position_t position, int* const err_code) {
-    _LOG_FAIL_CHECK_(List_status(list) == 0,          "error", ERROR_REPORTS, return 0, err_code, EFAULT);
-    _LOG_FAIL_CHECK_(position < list->capacity,       "error", ERROR_REPORTS, return 0, err_code, EINVAL);
-    _LOG_FAIL_CHECK_(list->first_empty->next != NULL, "error", ERROR_REPORTS, return 0, err_code, ENOMEM);
+#endif
+
+/**
+ * @brief Remove element from the list.
+ * 
+ * @param list
+ * @param position position of the element
+ * @param elem where to move the element (NULL to destroy it)
+ * @param err_code variable to use as errno
+ */
+static void _List_pop(List* const list, const list_position_t position, list_elem_t* const elem, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_POP);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0,   "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(position < list->capacity, "error", ERROR_REPORTS, return, err_code, EINVAL);
+    _LOG_FAIL_CHECK_(list->size > 0,            "error", ERROR_REPORTS, return, err_code, ENOENT);
 
-    _ListCell* pasted_cell = NULL;
+    _LOG_FAIL_CHECK_(_List_is_occupied(list, position), "error", ERROR_REPORTS, return, err_code, EFAULT);
 
-    if (list->linearized && (list->buffer + position == list->buffer->next || 
-                             list->buffer + position == list->buffer->prev)) {
+    if (list->sorted) _List_sorted_pop(list, position);
 
-        if (list->buffer + position == list->buffer->prev) {
+    _ListCell* buffer = list->buffer;
+    _ListCell* cell = buffer + position;
 
-            pasted_cell = list->first_empty;
+    const list_position_t changed[3] = { cell->prev, cell->next, position };
+    _List_checksum_cells(list, changed, 3, false);
 
-            pasted_cell->prev->next = pasted_cell->next;
-            pasted_cell->next->prev = pasted_cell->prev;
+    buffer[cell->prev].next = cell->next;
+    buffer[cell->next].prev = cell->prev;
+    _List_mark_cell(list, position, false);
 
-            list->first_empty = list->first_empty->next;
+    _List_checksum_cells(list, changed, 2, true);
 
-        } else {
+    //* Cells freed at the ends of linearized lists join the lazy region (the tail one goes before it).
+    if (list->linearized && list->rotation == 0 && (cell->next == 0 || cell->prev == 0)) {
+        if (cell->next == 0 || list->lazy_count == 0) list->lazy_begin = position;
+        ++list->lazy_count;
+        _LIST_COUNT_(list, LIST_COUNTER_FAST_PATH, 1);
+    } else {
+        if (list->linearized) _LIST_COUNT_(list, LIST_COUNTER_DELINEARIZE, 1);
+        _LIST_COUNT_(list, LIST_COUNTER_SLOW_PATH, 1);
+        if (list->policy) _List_policy_update(list, position, false);
+        list->linearized = false;
+        list->rotation = 0;
+
+        _List_put_free_cell(list, position, false);
+    }
+
+    if (elem) *elem = std::move(_List_elem(list, position));
+    _List_release(list, position);
+    --list->size;
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return, err_code, EAGAIN);
+    _LIST_COUNT_(list, LIST_COUNTER_POP, 1);
+    _List_notify(list, LIST_EVENT_POP, position);
+}
 
-            pasted_cell = list->first_empty->prev;
+void List_pop(List* const list, const list_position_t position, int* const err_code) {
+    _List_pop(list, position, NULL, err_code);
+}
 
-            list->first_empty->prev = pasted_cell->prev;
+void List_extract(List* const list, const list_position_t position, list_elem_t* const elem, int* const err_code) {
+    _LOG_FAIL_CHECK_(elem, "error", ERROR_REPORTS, return, err_code, EFAULT);
 
-            pasted_cell->prev->next = pasted_cell->next;
-            pasted_cell->next->prev = pasted_cell->prev;
+    _List_pop(list, position, elem, err_code);
+}
 
+/**
+ * @brief Move elements of the rotated linearized list so that its head takes the first cell of their block.
+ * 
+ * @note Block is rotated with three reversals of contents, then its cells are relinked in cell order.
+ * 
+ * @param list non-empty linearized list
+ */
+static void _List_unrotate(List* const list) {
+    _ListCell* buffer = list->buffer;
+    list_position_t base = _List_linear_base(list);
+    const size_t bounds[3][2] = { { 0, list->rotation }, { list->rotation, list->size }, { 0, list->size } };
+
+    for (size_t pass = 0; pass < 3; ++pass) {
+        for (size_t left = bounds[pass][0], right = bounds[pass][1]; left + 1 < right; ++left, --right) {
+            std::swap(buffer[_List_ring_cell(list, base, left)].content, buffer[_List_ring_cell(list, base, right - 1)].content);
         }
-    } else {
-        list->linearized = false;
+    }
+
+    list_position_t prev = 0;
+    list_position_t cell = base;
+
+    for (size_t index = 0; index < list->size; ++index, prev = cell, cell = _List_ring_cell(list, cell, 1)) {
+        buffer[cell].prev = prev;
+        buffer[prev].next = cell;
+    }
 
-        pasted_cell = list->first_empty;
+    buffer[prev].next = 0;
+    buffer->prev = prev;
+
+    list->rotation = 0;
+    _List_checksum_rebuild(list);
+}
+
+/**
+ * @brief Remove matching elements of the linearized list moving the rest towards its head.
+ * 
+ * @note Freed cells end up next to the ends of the list, so they join the lazy region and the list stays linearized.
+ * 
+ * @param list non-empty linearized list
+ * @param predicate
+ * @param ctx
+ * @return number of removed elements (size of the list is not changed)
+ */
+static size_t _List_remove_compact(List* const list, list_predicate_t* predicate, void* ctx) {
+    _ListCell* buffer = list->buffer;
+    list_position_t _ListCell::* forward = _List_forward(list);
+    list_position_t _ListCell::* backward = _List_backward(list);
+
+    //* Reversed lists are walked from the last cell backwards (one step back is capacity - 2 steps forward).
+    size_t step = list->reversed ? list->capacity - 2 : 1;
+    list_position_t cell = buffer->*forward;
+    list_position_t target = cell;
+    list_position_t last = 0;
+    size_t removed = 0;
+
+    //* Targets never pass the walked cells, so cells are found by index arithmetic while links are rewritten.
+    for (size_t index = 0; index < list->size; ++index, cell = _List_ring_cell(list, cell, step)) {
+        if (predicate(&_List_elem(list, cell), ctx)) {
+            _List_release(list, cell);
+            _List_mark_cell(list, cell, false);
+            ++removed;
+            _List_notify(list, LIST_EVENT_REMOVE, index);
+            continue;
+        }
 
-        list->first_empty->next->prev = list->first_empty->prev;
-        list->first_empty->prev->next = list->first_empty->next;
+        if (cell != target) {
+            buffer[target].content = std::move(buffer[cell].content);
+            buffer[cell].content = LIST_EMPTY_CONTENT;
+            _List_mark_cell(list, target, true);
+            _List_mark_cell(list, cell, false);
+        }
 
-        list->first_empty = list->first_empty->next;
+        buffer[target].*backward = last;
+        buffer[last].*forward = target;
+        last = target;
+        target = _List_ring_cell(list, target, step);
     }
 
-    pasted_cell->content = elem;
+    buffer[last].*forward = 0;
+    buffer->*backward = last;
 
-    _ListCell* prev_nbor = list->buffer + position;
-    _ListCell* next_nbor = prev_nbor->next;
-    
-    pasted_cell->next = next_nbor;
-    pasted_cell->prev = prev_nbor;
-    prev_nbor->next = pasted_cell;
-    next_nbor->prev = pasted_cell;
+    list->lazy_begin = buffer->prev ? _List_ring_cell(list, buffer->prev, 1) : target;
+    list->lazy_count += removed;
 
-    ++list->size;
+    return removed;
+}
 
-    _LOG_FAIL_CHECK_(List_status(list) == 0, "error", ERROR_REPORTS, return 0, err_code, EAGAIN);
+/**
+ * @brief Make the cells neighbours (the first one goes before the second one in list order) updating the list checksum.
+ * 
+ * @param list
+ * @param prev
+ * @param next
+ */
+static inline void _List_link_pair(List* const list, const list_position_t prev, const list_position_t next) {
+    _ListCell* buffer = list->buffer;
+    list_position_t _ListCell::* forward = _List_forward(list);
+    list_position_t _ListCell::* backward = _List_backward(list);
+
+    if (buffer[prev].*forward == next && buffer[next].*backward == prev) return;
 
-    return (list_position_t)(pasted_cell - list->buffer);
+    const list_position_t changed[2] = { prev, next };
+    _List_checksum_cells(list, changed, 2, false);
+
+    buffer[prev].*forward = next;
+    buffer[next].*backward = prev;
+
+    _List_checksum_cells(list, changed, 2, true);
 }
 
-list_position_t List_find_position(List* const list, const int index, int* const err_code) {
-    _LOG_FAIL_CHECK_(List_status(list) == 0, "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+/**
+ * @brief Remove matching elements of the list unlinking their cells.
+ * 
+ * @param list non-linearized list
+ * @param predicate
+ * @param ctx
+ * @return number of removed elements (size of the list is not changed)
+ */
+static size_t _List_remove_unlink(List* const list, list_predicate_t* predicate, void* ctx) {
+    _ListCell* buffer = list->buffer;
+    list_position_t _ListCell::* forward = _List_forward(list);
+    list_position_t last = 0;
+    list_position_t chain_head = 0;     // Freed cells are chained in reverse order, as pops put every cell first.
+    list_position_t chain_tail = 0;
+    size_t removed = 0;
+    size_t index = 0;
 
-    _LOG_FAIL_CHECK_((-(int)list->size <= index && index < (int)list->size) || list->size == 0, "error", ERROR_REPORTS, {
-        log_printf(ERROR_REPORTS, "error", "Requested index was %d with size %lld.\n", index, (long long) list->size);
+    //* Checksums are updated like pops do, so cells keeping their links are only read.
+    for (list_position_t cell = buffer->*forward; cell != 0; ++index) {
+        list_position_t next = buffer[cell].*forward;
+
+        if (predicate(&_List_elem(list, cell), ctx)) {
+            if (list->policy) _List_policy_update(list, cell, false);
+            _List_checksum_cells(list, &cell, 1, false);
+            _List_release(list, cell);
+            _List_mark_cell(list, cell, false);
+
+            buffer[cell].next = chain_head;
+            if (chain_head) buffer[chain_head].prev = cell;
+            else            chain_tail = cell;
+            chain_head = cell;
+
+            ++removed;
+            _List_notify(list, LIST_EVENT_REMOVE, index);
+        } else {
+            _List_link_pair(list, last, cell);
+            last = cell;
+        }
+
+        cell = next;
+    }
+
+    _List_link_pair(list, last, 0);
+
+    if (removed == 0) return 0;
+
+    //* The whole chain is spliced in before the first empty cell and becomes the start of the ring.
+    if (list->first_empty == 0) {
+        buffer[chain_head].prev = chain_tail;
+        buffer[chain_tail].next = chain_head;
+    } else {
+        list_position_t ring_tail = buffer[list->first_empty].prev;
+        buffer[ring_tail].next = chain_head;
+        buffer[chain_head].prev = ring_tail;
+        buffer[chain_tail].next = list->first_empty;
+        buffer[list->first_empty].prev = chain_tail;
+    }
+
+    list->first_empty = chain_head;
+
+    return removed;
+}
+
+size_t List_remove_if(List* const list, list_predicate_t* predicate, void* ctx, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_POP);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(predicate,               "error", ERROR_REPORTS, return 0, err_code, EINVAL);
+
+    if (list->size == 0) {
+        _List_notify(list, LIST_EVENT_REMOVE_IF, 0);
         return 0;
-    }, err_code, EFAULT);
+    }
 
-    if (list->size == 0) return 0;
+    size_t removed = 0;
 
     if (list->linearized) {
-        long long delta = index + (long long)(list->capacity - 1);
-        _ListCell* count_start = list->buffer->prev;
+        if (list->rotation) _List_unrotate(list);
+        removed = _List_remove_compact(list, predicate, ctx);
+        if (removed) _List_checksum_rebuild(list);
+        _LIST_COUNT_(list, LIST_COUNTER_FAST_PATH, 1);
+    } else {
+        removed = _List_remove_unlink(list, predicate, ctx);
+        _LIST_COUNT_(list, LIST_COUNTER_SLOW_PATH, 1);
+    }
 
-        if (index >= 0) {
-            delta = index - 1;
-            count_start = list->buffer->next;
-        }
+    list->size -= removed;
+    if (removed && list->sorted) _List_sorted_rebuild(list);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return removed, err_code, EAGAIN);
+    _LIST_COUNT_(list, LIST_COUNTER_POP, removed);
+    _List_notify(list, LIST_EVENT_REMOVE_IF, removed);
+
+    return removed;
+}
+
+void List_move(List* const list, const list_position_t cell, const list_position_t position, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_MOVE);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0,                            "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(cell < list->capacity && position < list->capacity, "error", ERROR_REPORTS, return, err_code, EINVAL);
+    _LOG_FAIL_CHECK_(cell != 0 && _List_is_occupied(list, cell),         "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(position == 0 || _List_is_occupied(list, position), "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(cell != position && !list->sorted,                  "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    _ListCell* buffer = list->buffer;
+    list_position_t anchor = _List_anchor(list, position);
+    if (anchor == cell || buffer[anchor].next == cell) return;
+
+    //* Run of the linearized list is taken once, so the second update keeps the cut made by the first one.
+    if (list->linearized) _LIST_COUNT_(list, LIST_COUNTER_DELINEARIZE, 1);
+    if (list->policy) _List_policy_update(list, cell, false);
+    list->linearized = false;
+    list->rotation = 0;
+    if (list->policy) _List_policy_update(list, anchor, true);
+
+    const list_position_t changed[5] = { cell, buffer[cell].prev, buffer[cell].next, anchor, buffer[anchor].next };
+    _List_checksum_cells(list, changed, 5, false);
+
+    buffer[buffer[cell].prev].next = buffer[cell].next;
+    buffer[buffer[cell].next].prev = buffer[cell].prev;
+
+    list_position_t next_nbor = buffer[anchor].next;
+
+    buffer[cell].next = next_nbor;
+    buffer[cell].prev = anchor;
+    buffer[anchor].next = cell;
+    buffer[next_nbor].prev = cell;
 
-        return (unsigned long long)(count_start - list->buffer + delta) % (list->capacity - 1) + 1;
+    _List_checksum_cells(list, changed, 5, true);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return, err_code, EAGAIN);
+    _List_notify(list, LIST_EVENT_MOVE, position, NULL, cell);
+}
+
+void List_set(List* const list, const list_position_t position, list_elem_t elem, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_MOVE);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0,                    "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(position != 0 && position < list->capacity, "error", ERROR_REPORTS, return, err_code, EINVAL);
+    _LOG_FAIL_CHECK_(_List_is_occupied(list, position),          "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    _ListCell* buffer = list->buffer;
+    list_position_t prev = buffer[position].prev;
+    list_position_t next = buffer[position].next;
+
+    _LOG_FAIL_CHECK_(!list->sorted || ((prev == 0 || !(elem < _List_elem(list, prev))) &&
+                                       (next == 0 || !(_List_elem(list, next) < elem))),
+                     "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    _List_checksum_cells(list, &position, 1, false);
+    _List_elem(list, position) = std::move(elem);
+    _List_checksum_cells(list, &position, 1, true);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return, err_code, EAGAIN);
+    _List_notify(list, LIST_EVENT_SET, position, &_List_elem(list, position));
+}
+
+void List_reverse(List* const list, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_MOVE);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(!list->sorted,           "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    //* Links, checksum and cells of linearized lists stay valid, only the way they are read changes.
+    list->reversed = !list->reversed;
+
+    _List_notify(list, LIST_EVENT_REVERSE);
+}
+
+void List_rotate(List* const list, const int steps, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_MOVE);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(!list->sorted,           "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    long long size = (long long) list->size;
+    long long shift = size ? ((long long) steps % size + size) % size : 0;
+    if (shift == 0) return;
+
+    //* New head is found from the closer end of the list (linearized ones find it by index arithmetic).
+    int error = 0;
+    list_position_t head = _List_find_position(list, (int)(2 * shift <= size ? shift : shift - size), &error);
+    _LOG_FAIL_CHECK_(error == 0, "error", ERROR_REPORTS, return, err_code, error);
+
+    _ListCell* buffer = list->buffer;
+    list_position_t base = list->linearized ? _List_linear_base(list) : 0;
+    list_position_t _ListCell::* forward = _List_forward(list);
+    list_position_t _ListCell::* backward = _List_backward(list);
+
+    list_position_t first = buffer->*forward;
+    list_position_t last = buffer->*backward;
+    list_position_t tail = buffer[head].*backward;
+
+    const list_position_t changed[5] = { 0, first, last, head, tail };
+    _List_checksum_cells(list, changed, 5, false);
+
+    //* Old ends are joined and the sentinel takes the place between the new ones.
+    buffer[last].*forward = first;
+    buffer[first].*backward = last;
+    buffer[tail].*forward = 0;
+    buffer[head].*backward = 0;
+    buffer->*forward = head;
+    buffer->*backward = tail;
+
+    _List_checksum_cells(list, changed, 5, true);
+
+    //* Elements stay in their cells, the rotation tells how far the head went from the start of their block.
+    //* Elements of the full list take the whole ring of cells, so the block can start at any of them.
+    if (list->linearized) {
+        size_t ring = list->capacity - 1;
+        list->rotation = list->size == ring ? 0 : (buffer->next + ring - base) % ring;
     }
 
-    _ListCell* current = index >= 0 ? 
-        list->buffer->next : list->buffer->prev;
+    if (list->policy) _List_policy_update(list, 0, true);
+
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return, err_code, EAGAIN);
+    _List_notify(list, LIST_EVENT_ROTATE, (list_position_t) shift);
+}
+
+static_assert(sizeof(_ListFileHeader) <= LIST_FILE_DATA_OFFSET, "List file header does not fit before list cells.");
+
+static hash_t _List_header_hash(const _ListFileHeader* const header) {
+    return get_simple_hash(header, &header->header_hash);
+}
+
+/**
+ * @brief Describe the list in the file header.
+ * 
+ * @param list
+ * @param header
+ * @param checksum checksum of the list
+ * @param clean value of the clean flag
+ * @param tag value to store in the header
+ */
+static void _List_fill_header(const List* const list, _ListFileHeader* const header, const hash_t checksum, const bool clean,
+                              const uint64_t tag) {
+    header->magic = LIST_FILE_MAGIC;
+    header->version = LIST_FILE_VERSION;
+    header->cell_size = sizeof(_ListCell);
+    header->capacity = list->capacity;
+    header->size = list->size;
+    header->first_empty = list->first_empty;
+    header->lazy_begin = list->lazy_begin;
+    header->lazy_count = list->lazy_count;
+    header->rotation = list->rotation;
+    header->linearized = list->linearized;
+    header->clean = clean;
+    header->reversed = list->reversed;
+    header->growable = list->growable;
+    header->checksum = checksum;
+    header->tag = tag;
+    header->poison_hash = get_simple_hash(&LIST_ELEM_POISON, &LIST_ELEM_POISON + 1);
+    header->header_hash = _List_header_hash(header);
+}
+
+/**
+ * @brief Get the checksum of the list (lists without the extras block get it from scratch).
+ * 
+ * @param list list with valid links
+ * @return hash_t
+ */
+static inline hash_t _List_checksum(const List* const list) {
+    return list->extras ? list->extras->checksum : _List_checksum_walk(list);
+}
+
+static size_t _List_file_size(const size_t capacity) {
+    return LIST_FILE_DATA_OFFSET + capacity * sizeof(_ListCell);
+}
+
+/**
+ * @brief Write list into the file with the specified header tag.
+ * 
+ * @param list
+ * @param file_name name of the file to (over)write
+ * @param tag value to store in the file header
+ * @param err_code variable to use as errno
+ */
+static void _List_save(List* const list, const char* file_name, const uint64_t tag, int* const err_code) {
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(file_name,               "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(!LIST_INDIRECT,          "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    char temp_name[LIST_FILE_NAME_SIZE] = "";
+    _LOG_FAIL_CHECK_(snprintf(temp_name, sizeof(temp_name), "%s.tmp", file_name) < (int)sizeof(temp_name),
+                     "error", ERROR_REPORTS, return, err_code, ENAMETOOLONG);
+
+    int file = open(temp_name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    _LOG_FAIL_CHECK_(file != -1, "error", ERROR_REPORTS, return, err_code, FILE_ERROR);
 
-    for (int id = 0; id < index; ++id) {
-        current = index >= 0 ? current->next : current->prev;
+    _ListFileHeader header = {};
+    _List_fill_header(list, &header, _List_checksum(list), true, tag);
+
+    bool written = pwrite(file, &header, sizeof(header), 0) == (ssize_t) sizeof(header);
+
+    const char* data = (const char*) list->buffer;
+    size_t data_size = list->capacity * sizeof(*list->buffer);
+    for (size_t offset = 0; written && offset < data_size;) {
+        ssize_t chunk = pwrite(file, data + offset, data_size - offset, (off_t)(LIST_FILE_DATA_OFFSET + offset));
+        written = chunk > 0;
+        offset += written ? (size_t)chunk : 0;
     }
 
-    return (list_position_t)(current - list->buffer);
+    written = written && fsync(file) == 0;
+    close(file);
+
+    //* Renaming keeps the old file intact until the new one is complete (and keeps existing mappings valid).
+    _LOG_FAIL_CHECK_(written && rename(temp_name, file_name) == 0, "error", ERROR_REPORTS, {
+        unlink(temp_name);
+        return;
+    }, err_code, FILE_ERROR);
 }
 
-list_elem_t List_get(List* const list, const list_position_t position, int* const err_code) {
-    _LOG_FAIL_CHECK_(List_status(list) == 0,          "error", ERROR_REPORTS, return 0, err_code, EFAULT);
-    _LOG_FAIL_CHECK_(position < list->capacity,       "error", ERROR_REPORTS, return 0, err_code, EINVAL);
-    _LOG_FAIL_CHECK_(list->first_empty->next != NULL, "error", ERROR_REPORTS, return 0, err_code, ENOMEM);
+/**
+ * @brief Mark file of the mapped list as being modified.
+ * 
+ * @param list mapped list
+ */
+static void _List_mark_dirty(List* const list) {
+    list->mapping->clean = false;
+    list->mapping->header_hash = _List_header_hash(list->mapping);
+    msync(list->mapping, LIST_FILE_DATA_OFFSET, MS_SYNC);
+}
 
-    return (list->buffer + position)->content;
+void List_save(List* const list, const char* file_name, int* const err_code) {
+    _List_save(list, file_name, 0, err_code);
 }
 
-void List_pop(List* const list, const list_position_t position, int* const err_code) {
-    _LOG_FAIL_CHECK_(List_status(list) == 0,          "error", ERROR_REPORTS, return, err_code, EFAULT);
-    _LOG_FAIL_CHECK_(position < list->capacity,       "error", ERROR_REPORTS, return, err_code, EINVAL);
-    _LOG_FAIL_CHECK_(list->first_empty->next != NULL, "error", ERROR_REPORTS, return, err_code, ENOMEM);
-    _LOG_FAIL_CHECK_(list->size > 0,                  "error", ERROR_REPORTS, return, err_code, ENOENT);
+/**
+ * @brief Check the list file header and describe the list it holds.
+ * 
+ * @param header
+ * @param file_size size of the whole file
+ * @param[out] described list to copy size, capacity and other fields to
+ * @return list_report_t
+ */
+static list_report_t _List_check_header(const _ListFileHeader* const header, const size_t file_size, List* const described) {
+    *described = List {};
+    described->capacity = header->capacity;
+    described->size = header->size;
+    described->first_empty = header->first_empty;
+    described->lazy_begin = header->lazy_begin;
+    described->lazy_count = header->lazy_count;
+    described->rotation = header->rotation;
+    described->linearized = header->linearized;
+    described->reversed = header->reversed;
+    described->growable = header->growable;
+
+    _ListFileHeader expected = {};
+    _List_fill_header(described, &expected, header->checksum, true, header->tag);
+
+    if (memcmp(header, &expected, sizeof(expected)) != 0 || file_size != _List_file_size(described->capacity))
+        return LIST_INV_FILE;
 
-    _LOG_FAIL_CHECK_(list->buffer[position].content != LIST_ELEM_POISON, "error", ERROR_REPORTS, return, err_code, EFAULT);
+    list_report_t report = 0;
 
-    _ListCell* cell = list->buffer + position;
+    if (described->size >= described->capacity) report |= LIST_BIG_SIZE;
+    if (described->first_empty >= described->capacity || described->lazy_begin == 0 ||
+        described->lazy_begin >= described->capacity || described->lazy_count >= described->capacity) report |= LIST_INV_FREE;
+    if (described->rotation && (!described->linearized || described->rotation >= described->size)) report |= LIST_INV_CONNECTIONS;
 
-    cell->prev->next = cell->next;
-    cell->next->prev = cell->prev;
+    return report;
+}
 
-    if (list->linearized && (cell->next == list->buffer || cell->prev == list->buffer)) {
-        if (cell->next == list->buffer) {
-            cell->next = list->first_empty;
-            cell->prev = list->first_empty->prev;
-            list->first_empty->prev->next = cell;
-            list->first_empty->prev = cell;
-            list->first_empty = cell;
-        } else {
-            cell->next = list->first_empty;
-            cell->prev = list->first_empty->prev;
-            list->first_empty->prev->next = cell;
-            list->first_empty->prev = cell;
+list_report_t List_open_mapped(List* const list, const char* file_name, const bool verify, int* const err_code) {
+    _LOG_FAIL_CHECK_(check_ptr(list), "error", ERROR_REPORTS, return LIST_NULL, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(file_name,       "error", ERROR_REPORTS, return LIST_INV_FILE, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(!LIST_INDIRECT,  "error", ERROR_REPORTS, return LIST_INV_FILE, err_code, EINVAL);
+
+    int file = open(file_name, O_RDWR);
+    _LOG_FAIL_CHECK_(file != -1, "error", ERROR_REPORTS, return LIST_INV_FILE, err_code, FILE_ERROR);
+
+    struct stat file_info = {};
+    bool big_enough = fstat(file, &file_info) == 0 && (size_t)file_info.st_size >= LIST_FILE_DATA_OFFSET;
+
+    void* mapping = big_enough ? mmap(NULL, (size_t)file_info.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0) : MAP_FAILED;
+    close(file);
+
+    _LOG_FAIL_CHECK_(mapping != MAP_FAILED, "error", ERROR_REPORTS, return LIST_INV_FILE, err_code, FILE_ERROR);
+
+    List mapped = {};
+    list_report_t report = _List_check_header((_ListFileHeader*) mapping, (size_t)file_info.st_size, &mapped);
+
+    if (report == 0) {
+        mapped.buffer = (_ListCell*)((char*) mapping + LIST_FILE_DATA_OFFSET);
+        mapped.mapping = (_ListFileHeader*) mapping;
+
+        //* The checksum comes from the header, so verification compares it with the cells.
+        _ListExtras* extras = _List_extras(&mapped);
+        if (extras) extras->checksum = mapped.mapping->checksum;
+
+        if (!extras)     report |= LIST_NULL_CONTENT;
+        else if (verify) report |= List_status(&mapped);
+    }
+
+    _LOG_FAIL_CHECK_(report == 0, "error", ERROR_REPORTS, {
+        munmap(mapping, (size_t)file_info.st_size);
+        free(mapped.extras);
+        return report;
+    }, err_code, EINVAL);
+
+    *list = mapped;
+
+    _List_mark_dirty(list);
+
+    return 0;
+}
+
+/**
+ * @brief Initialize list with a heap copy of the list file.
+ * 
+ * @param list list to initialize
+ * @param file_name name of the file created by List_save()
+ * @param[out] tag tag stored in the file header (can be NULL)
+ * @param err_code variable to use as errno
+ * @return list_report_t
+ */
+static list_report_t _List_load(List* const list, const char* file_name, uint64_t* const tag, int* const err_code) {
+    _LOG_FAIL_CHECK_(check_ptr(list), "error", ERROR_REPORTS, return LIST_NULL, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(file_name,       "error", ERROR_REPORTS, return LIST_INV_FILE, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(!LIST_INDIRECT,  "error", ERROR_REPORTS, return LIST_INV_FILE, err_code, EINVAL);
+
+    int file = open(file_name, O_RDONLY);
+    _LOG_FAIL_CHECK_(file != -1, "error", ERROR_REPORTS, return LIST_INV_FILE, err_code, FILE_ERROR);
+
+    struct stat file_info = {};
+    _ListFileHeader header = {};
+    List loaded = {};
+
+    list_report_t report = LIST_INV_FILE;
+    if (fstat(file, &file_info) == 0 && pread(file, &header, sizeof(header), 0) == (ssize_t) sizeof(header))
+        report = _List_check_header(&header, (size_t)file_info.st_size, &loaded);
+
+    if (report == 0) {
+        loaded.buffer = (_ListCell*) calloc(loaded.capacity, sizeof(*loaded.buffer));
+
+        char* data = (char*) loaded.buffer;
+        size_t data_size = loaded.capacity * sizeof(*loaded.buffer);
+        size_t offset = 0;
+        while (data && offset < data_size) {
+            ssize_t chunk = pread(file, data + offset, data_size - offset, (off_t)(LIST_FILE_DATA_OFFSET + offset));
+            if (chunk <= 0) break;
+            offset += (size_t)chunk;
         }
-    } else {
-        list->linearized = false;
 
-        cell->next = list->first_empty;
-        cell->prev = list->first_empty->prev;
-        cell->next->prev = cell;
-        cell->prev->next = cell;
+        _ListExtras* extras = data && offset == data_size ? _List_extras(&loaded) : NULL;
+        if (extras) extras->checksum = header.checksum;
 
-        list->first_empty = cell;
+        if (!data || data_size == 0) report |= LIST_NULL_CONTENT;
+        else if (offset != data_size) report |= LIST_INV_FILE;  //* Read failed or the file was truncated after fstat().
+        else if (!extras)             report |= LIST_NULL_CONTENT;
+        else                          report |= List_status(&loaded);
     }
 
-    cell->content = LIST_ELEM_POISON;
-    --list->size;
+    close(file);
+
+    _LOG_FAIL_CHECK_(report == 0, "error", ERROR_REPORTS, {
+        free(loaded.buffer);
+        free(loaded.extras);
+        return report;
+    }, err_code, EINVAL);
+
+    if (tag) *tag = header.tag;
+    *list = loaded;
+
+    return 0;
+}
+
+list_report_t List_load(List* const list, const char* file_name, int* const err_code) {
+    return _List_load(list, file_name, NULL, err_code);
+}
+
+void List_sync(List* const list, int* const err_code) {
+    _LOG_FAIL_CHECK_(_List_verify(list) == 0, "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(list->mapping,           "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    size_t mapping_size = _List_file_size(list->capacity);
+
+    //* Cells go to the disk before the header that marks them consistent.
+    _LOG_FAIL_CHECK_(msync(list->mapping, mapping_size, MS_SYNC) == 0, "error", ERROR_REPORTS, return, err_code, FILE_ERROR);
+
+    _List_fill_header(list, list->mapping, _List_checksum(list), true, list->mapping->tag);
 
-    _LOG_FAIL_CHECK_(List_status(list) == 0, "error", ERROR_REPORTS, return, err_code, EAGAIN);
+    _LOG_FAIL_CHECK_(msync(list->mapping, LIST_FILE_DATA_OFFSET, MS_SYNC) == 0, "error", ERROR_REPORTS, return, err_code, FILE_ERROR);
+
+    _List_mark_dirty(list);
+}
+
+/**
+ * @brief Sync and unmap the buffer of the mapped list.
+ * 
+ * @param list mapped list
+ * @param err_code variable to use as errno
+ */
+static void _List_unmap(List* const list, int* const err_code) {
+    List_sync(list, err_code);
+
+    list->mapping->clean = true;
+    list->mapping->header_hash = _List_header_hash(list->mapping);
+    msync(list->mapping, LIST_FILE_DATA_OFFSET, MS_SYNC);
+
+    munmap(list->mapping, _List_file_size(list->capacity));
+    list->mapping = NULL;
 }
 
 list_report_t List_status(List* const list) {
+    _LIST_TRACE_(LIST_SPAN_STATUS);
+
     _LOG_FAIL_CHECK_(list, "error", ERROR_REPORTS, return LIST_NULL, NULL, 0);
 
-    list_report_t report = 0;
+    list_report_t report = _List_check_fields(list, true);
+    if (report) return report;
 
-    if (list->size >= list->capacity) report |= LIST_BIG_SIZE;
-    if (!check_ptr(list->buffer))     report |= LIST_NULL_CONTENT;
-    else if (list->first_empty <= list->buffer || list->first_empty > list->buffer + list->capacity)
-        report |= LIST_INV_FREE;
-    
-    for (_ListCell* cell = list->buffer; cell < list->buffer + list->capacity; ++cell) {
-        if (cell->prev == NULL || cell->next == NULL ||
-            cell->prev->next != cell || cell->next->prev != cell) report |= LIST_INV_CONNECTIONS;
+    //* Cells of the lazy region are skipped, so the check does not commit their pages either.
+    size_t free_cells = 0;
+    list_position_t cell = 0;
+    list_position_t lazy_end = _List_ring_cell(list, list->lazy_begin, list->lazy_count);
+
+    for (size_t id = list->lazy_count; id < list->capacity; ++id) {
+        list_position_t next = list->buffer[cell].next;
+        list_position_t prev = list->buffer[cell].prev;
+
+        if (next >= list->capacity || prev >= list->capacity ||
+            list->buffer[prev].next != cell || list->buffer[next].prev != cell) report |= LIST_INV_CONNECTIONS;
+
+        bool occupied = list->occupancy ? _List_is_occupied(list, cell) : _List_has_payload(list->buffer[cell].content);
+        if (cell != 0 && !occupied) ++free_cells;
+
+        if (cell == 0) cell = lazy_end;
+        else           cell = cell + 1 < list->capacity ? cell + 1 : 1;
     }
 
+    if (list->size < list->capacity && free_cells + list->lazy_count + list->size + 1 != list->capacity) report |= LIST_INV_FREE;
+    if ((list->first_empty == 0) != (free_cells == 0)) report |= LIST_INV_FREE;
+
+    if (list->occupancy) {
+        size_t occupied_cells = 0;
+        for (size_t word_id = 0; word_id < _List_occupancy_words(list->capacity); ++word_id) {
+            occupied_cells += (size_t)__builtin_popcountll(list->occupancy[word_id]);
+        }
+
+        if (occupied_cells != list->size) report |= LIST_INV_FREE;
+    }
+
+    //* Order is only checked along valid links.
+    if (report == 0 && list->sorted && !_List_sorted_check(list)) report |= LIST_INV_ORDER;
+    if (report == 0 && list->extras && _List_checksum_walk(list) != list->extras->checksum) report |= LIST_INV_CHECKSUM;
+
     return report;
 }
 
@@ -281,22 +2857,47 @@ void _List_dump(List* const list, const unsigned int importance, const int line,
 
     _log_printf(importance, LIST_DUMP_TAG, "List:\n");
 
-    _log_printf(importance, LIST_DUMP_TAG, "\tfirst empty = %lld,\n", (long long) (list->first_empty - list->buffer));
+    _log_printf(importance, LIST_DUMP_TAG, "\tfirst empty = %lld,\n", (long long) list->first_empty);
+    _log_printf(importance, LIST_DUMP_TAG, "\tlazy cells =  %lld starting with [%lld],\n",
+                (long long) list->lazy_count, (long long) list->lazy_begin);
     _log_printf(importance, LIST_DUMP_TAG, "\tsize =        %lld,\n", (long long) list->size);
     _log_printf(importance, LIST_DUMP_TAG, "\tcapacity =    %lld,\n", (long long) list->capacity);
     _log_printf(importance, LIST_DUMP_TAG, "\tlinearized =  %d,\n", list->linearized);
+    _log_printf(importance, LIST_DUMP_TAG, "\trotation =    %lld,\n", (long long) list->rotation);
+    _log_printf(importance, LIST_DUMP_TAG, "\treversed =    %d,\n", list->reversed);
+    if (status == 0) _log_printf(importance, LIST_DUMP_TAG, "\tfragmentation = %.3lf,\n", List_fragmentation(list));
+
+    if (list->extras && list->extras->stats) {
+        ListStats stats = {};
+        List_get_stats(list, &stats);
+
+        _log_printf(importance, LIST_DUMP_TAG, "\tpeak size =   %lld,\n", (long long) stats.peak_size);
+        for (size_t counter = 0; counter < LIST_COUNTER_COUNT; ++counter) {
+            _log_printf(importance, LIST_DUMP_TAG, "\t%s count = %llu,\n", LIST_COUNTER_NAMES[counter], stats.counters[counter]);
+        }
+    }
 
     _log_printf(importance, LIST_DUMP_TAG, "\tbuffer at %p:\n", list->buffer);
 
     for (size_t id = 0; id < list->capacity; id++) {
+        if (_List_is_lazy(list, id)) continue;
+
         unsigned char* data_start = (unsigned char*)(list->buffer + id);
         _log_printf(importance, LIST_DUMP_TAG, "\t\t[%5ld] = %02X %02X %02X %02X (%s), next [%lld], prev [%lld]\n", (long) id,
             data_start[0], data_start[1], data_start[2], data_start[3],
-            list->buffer[id].content == LIST_ELEM_POISON ? "POISON" : "VALUE",
-            (long long) (list->buffer[id].next - list->buffer), (long long) (list->buffer[id].prev - list->buffer));
+            _List_is_occupied(list, id) ? "VALUE" : "POISON",
+            (long long) list->buffer[id].next, (long long) list->buffer[id].prev);
     }
 }
 
+void List_print_trace(FILE* stream) {
+    LatencyTrace_print(stream, LIST_SPAN_NAMES, LIST_SPAN_COUNT);
+}
+
+void List_write_trace(const char* file_name, int* const err_code) {
+    LatencyTrace_write_chrome(file_name, LIST_SPAN_NAMES, LIST_SPAN_COUNT, err_code);
+}
+
 static int PictCount = 0;
 
 void _List_dump_graph(List* const list, unsigned int importance) {
@@ -312,18 +2913,23 @@ void _List_dump_graph(List* const list, unsigned int importance) {
             "\tsplines=ortho\n"
             , temp_file);
 
+    //* Lazy cells have no contents and links to draw.
     for (size_t id = 0; id < list->capacity; ++id) {
+        if (_List_is_lazy(list, id)) continue;
+
         unsigned char* data = (unsigned char*)&(list->buffer + id)->content;
         _ListCell* cell = list->buffer + id;
         fprintf(temp_file, LIST_VERTEX_FORMAT);
     }
 
     for (size_t id = 0; id < list->capacity - 1; ++id) {
+        if (_List_is_lazy(list, id) || _List_is_lazy(list, id + 1)) continue;
         fprintf(temp_file, "\tV%d->V%d [weight=999999999 color=none]\n", (int)id, (int)id + 1);
     }
 
     for (size_t id = 0; id < list->capacity; ++id) {
-        fprintf(temp_file, "\tV%ld->V%ld [arrowsize=0.3]\n", (long int)id, list->buffer[id].next - list->buffer);
+        if (_List_is_lazy(list, id)) continue;
+        fprintf(temp_file, "\tV%ld->V%ld [arrowsize=0.3]\n", (long int)id, (long int)list->buffer[id].next);
     }
 
     fputc('}', temp_file);
@@ -13,9 +13,16 @@
 #define LISTWORKS_H
 
 #include <stdint.h>
+#include <type_traits>
 
 #include "lib/util/dbg/debug.h"
+#include "lib/util/thread_pool.h"
+#include "lib/util/strided_scan.h"
+#include "lib/util/latency_trace.h"
+#include "lib/util/page_alloc.h"
+#include "lib/alloc_tracker/alloc_tracker.h"
 #include "listreports.h"
+#include "list_config.h"
 
 const char LIST_DUMP_TAG[] = "list_dump";
 
@@ -30,26 +37,227 @@ static const list_elem_t ___LIST_ELEM_T_OR_POISON_IS_NOT_DEFINED___ = LIST_ELEM_
 //* Type that is used to identify elements in raw list buffer.
 typedef uintptr_t list_position_t;
 
+//* Elements of non-trivial types and elements of LIST_INDIRECT_MIN_SIZE bytes or bigger are kept in the payload slab
+//* of the list, and its cells only hold handles of slab slots. Elements then stay in their slots for their whole life,
+//* so linearizations swap small link cells, and elements are only constructed and destroyed by insertions and pops.
+//* List files can not hold such lists (streams can, if elements are trivially copyable).
+static const bool LIST_INDIRECT = sizeof(list_elem_t) >= LIST_INDIRECT_MIN_SIZE || !std::is_trivially_copyable<list_elem_t>::value;
+
+/**
+ * @brief Handle of the payload slab slot of the element.
+ * 
+ */
+struct _ListHandle {
+    size_t slot = 0;            // 0 for cells without elements.
+};
+
+//* What list cells hold: elements themselves or handles of their slots.
+typedef std::conditional<LIST_INDIRECT, _ListHandle, list_elem_t>::type _list_content_t;
+
+static inline list_elem_t _List_empty_content(const list_elem_t*) { return LIST_ELEM_POISON; }
+static inline _ListHandle _List_empty_content(const _ListHandle*) { return _ListHandle {}; }
+
+//* Contents of cells without elements.
+static const _list_content_t LIST_EMPTY_CONTENT = _List_empty_content((const _list_content_t*) NULL);
+
 /**
  * @brief Primary content of the list with all the linkage.
  * 
+ * @note Links are buffer indices (0 is the sentinel cell), so buffers can be moved or mapped anywhere.
  */
 struct _ListCell {
-    list_elem_t content = LIST_ELEM_POISON;
-    _ListCell* next = NULL;
-    _ListCell* prev = NULL;
+    _list_content_t content = LIST_EMPTY_CONTENT;
+    list_position_t next = 0;
+    list_position_t prev = 0;
+};
+
+/**
+ * @brief Header of the list file, followed by list cells at LIST_FILE_DATA_OFFSET.
+ * 
+ */
+struct _ListFileHeader {
+    uint64_t magic = 0;
+    uint32_t version = 0;
+    uint32_t cell_size = 0;
+    uint64_t capacity = 0;
+    uint64_t size = 0;
+    uint64_t first_empty = 0;
+    uint64_t lazy_begin = 0;
+    uint64_t lazy_count = 0;
+    uint64_t rotation = 0;      // See List::rotation.
+    uint32_t linearized = 0;
+    uint32_t clean = 0;         // 0 while the file is mapped, so crashed sessions are detected.
+    uint32_t reversed = 0;      // Direction of the list (see List::reversed).
+    uint32_t growable = 0;      // List doubles its buffer when it fills up (see List::growable).
+    hash_t checksum = 0;        // Checksum of list links and contents (see _ListExtras::checksum).
+    uint64_t tag = 0;           // Arbitrary value saved with the list (journals use it to match logs).
+    hash_t poison_hash = 0;     // Detects files of lists with other element types.
+    hash_t header_hash = 0;     // Hash of all the fields above.
+};
+
+//* Kinds of list changes reported to list observers.
+enum ListEvent {
+    LIST_EVENT_INSERT,      // Element was inserted by List_insert().
+    LIST_EVENT_POP,         // Element was removed by List_pop().
+    LIST_EVENT_LINEARIZE,   // List was linearized.
+    LIST_EVENT_MODIFY,      // Element values were changed in place (by List_for_each()).
+    LIST_EVENT_SORT,        // List was sorted by List_sort() (the order of elements changed).
+    LIST_EVENT_MOVE,        // Element was moved by List_move().
+    LIST_EVENT_SET,         // Element was replaced by List_set().
+    LIST_EVENT_GET,         // Element was read by List_get() (the list did not change).
+    LIST_EVENT_FIND_POSITION, // Position was found by List_find_position() (the list did not change).
+    LIST_EVENT_REMOVE,      // Element matched the predicate of the running List_remove_if() (sent during the walk).
+    LIST_EVENT_REMOVE_IF,   // List_remove_if() finished (after all its LIST_EVENT_REMOVE ones).
+    LIST_EVENT_REVERSE,     // List was reversed by List_reverse().
+    LIST_EVENT_ROTATE,      // List was rotated by List_rotate().
+};
+
+/**
+ * @brief Function called after every successful change of the list and List_get() or List_find_position() call.
+ * 
+ * @param event kind of the call
+ * @param position position argument of the call (0 for linearization and in-place modification,
+ *                 the index converted to list_position_t for List_find_position(),
+ *                 index of the removed element counted before the call for LIST_EVENT_REMOVE,
+ *                 number of removed elements for LIST_EVENT_REMOVE_IF,
+ *                 number of steps in [1, size) for LIST_EVENT_ROTATE)
+ * @param elem inserted or stored element (NULL for other events)
+ * @param result position of the inserted, moved or found element (0 for other events)
+ * @param ctx observer context of the list
+ */
+typedef void list_observer_t(const ListEvent event, const list_position_t position, const list_elem_t* elem,
+                             const list_position_t result, void* ctx);
+
+//* Latency trace spans of list operations (see LatencyTrace_start()).
+enum ListTraceSpan {
+    LIST_SPAN_INSERT,
+    LIST_SPAN_POP,          // List_pop(), List_extract() and List_remove_if().
+    LIST_SPAN_MOVE,         // List_move(), List_set(), List_reverse() and List_rotate().
+    LIST_SPAN_GET,
+    LIST_SPAN_FIND_POSITION, // List_find_position(), batched lookups and List_lower_bound().
+    LIST_SPAN_SCAN,         // List_find_value(), List_count(), List_min(), List_max() and List_sum().
+    LIST_SPAN_TRAVERSE,     // List_for_each() and List_reduce().
+    LIST_SPAN_LINEARIZE,
+    LIST_SPAN_SORT,
+    LIST_SPAN_STATUS,       // List_status() (called by every other operation unless List_set_checks() says otherwise).
+
+    LIST_SPAN_COUNT,
+};
+
+static const char* const LIST_SPAN_NAMES[] = {
+    "List_insert",
+    "List_pop",
+    "List_move",
+    "List_get",
+    "List_find_position",
+    "List_scan",
+    "List_traverse",
+    "List_linearize",
+    "List_sort",
+    "List_status",
+};
+
+static_assert(sizeof(LIST_SPAN_NAMES) / sizeof(*LIST_SPAN_NAMES) == LIST_SPAN_COUNT, "Not every list span has a name.");
+
+//* Define LIST_TRACE before the library include to measure list operations.
+//* Operations then cost one extra load until LatencyTrace_start() is called.
+#ifdef LIST_TRACE
+#define _LIST_TRACE_(span) LatencyTraceScope _list_trace_scope_(span)
+#else
+#define _LIST_TRACE_(span) do {} while (0)
+#endif
+
+//* Define LIST_PROFILE before the library include to count list buffers in the allocation profile
+//* (see alloc_tracker.h) under the sites of constructor calls. Records are keyed by List objects.
+#ifdef LIST_PROFILE
+#define _LIST_PROFILE_(call) call
+#else
+#define _LIST_PROFILE_(call) do {} while (0)
+#endif
+
+//* How list operations check the list before and after the change.
+enum ListCheckMode {
+    LIST_CHECK_FULL,        // Run List_status() every time (the default).
+    LIST_CHECK_PERIODIC,    // Check list fields and sentinel links in O(1) time, run List_status() once per audit interval.
+    LIST_CHECK_SAMPLED,     // Check list fields and sentinel links in O(1) time, run List_status() with 1 / audit interval chance.
+};
+
+struct _ListStatsBlock;
+struct _ListPolicy;
+struct _ListSkipIndex;
+
+/**
+ * @brief Rarely used fields of the list kept out of the List object, so small lists stay small.
+ * 
+ * @note Lists made by List_ctor() and List_ctor_with() get the block at once, small lists get it
+ *       from the first call that needs it (and only track the checksum from then on).
+ */
+struct _ListExtras {
+    list_observer_t* observer = NULL; // Function to report list changes to (used by list journals).
+    void* observer_ctx = NULL;
+    _ListStatsBlock* stats = NULL;    // Operation counters (see liststats_.h).
+    hash_t checksum = 0;              // Sum of hashes of the sentinel and element cells (indices, links and contents).
+    size_t audit_interval = 0;        // Number of cheap checks per List_status() run (0 to never run it).
+    uint64_t audit_state = 0;         // Checks left until the audit (periodic checks) or generator state (sampled ones).
 };
 
 /**
  * @brief List data structure.
  * 
+ * @note Free cells are either linked into the free cell ring or lie in the lazy region:
+ *       lazy_count cells starting with lazy_begin (wrapping from the last cell to cell 1)
+ *       whose contents and links were never set. Constructors and linearizations only make the region,
+ *       so buffer pages are committed when the list grows into them.
+ *       Linearized lists keep their elements in consecutive cells starting rotation cells before buffer->next
+ *       (see List_rotate()) and all free cells in the lazy region right after the last of them.
+ *       Reversed lists run from buffer->prev along prev links, all positions and indices follow that order
+ *       (linearized ones still keep their elements in consecutive cells, they are just read backwards).
  */
 struct List {
     _ListCell* buffer = NULL;
-    _ListCell* first_empty = NULL;
+    list_position_t first_empty = 0;  // First cell of the free cell ring (0 if it is empty).
+    list_position_t lazy_begin = 0;   // First cell of the lazy region.
+    size_t lazy_count = 0;            // Number of cells in the lazy region.
     size_t size = 0;
     size_t capacity = 0;
+    size_t rotation = 0;              // Number of elements of the linearized list lying in cells before the head (0 otherwise).
     bool linearized = true;
+    bool reversed = false;            // Next and prev links swap their roles (see List_reverse()).
+    bool growable = false;            // Full list doubles its buffer instead of refusing insertions (see List_ctor_small()).
+    bool inline_buffer = false;       // Buffer lies in the SmallList holding the list, so it is never freed.
+    ListCheckMode check_mode = LIST_CHECK_FULL;  // Read by every operation, so it stays out of the extras.
+    _ListFileHeader* mapping = NULL;  // Header of the file the buffer is mapped from (NULL for heap buffers).
+    _ListExtras* extras = NULL;       // Observer, counters, checksum and audit state (see _ListExtras).
+    _ListPolicy* policy = NULL;       // Automatic linearization policy (see listpolicy_.h).
+    PageAllocOptions pages = {};      // How buffers of the list are allocated (see List_ctor_with()).
+    size_t mapped_size = 0;           // Size of the anonymous mapping holding the buffer (0 for heap buffers).
+    uint64_t* occupancy = NULL;       // Bitmap of cells holding elements (see List_track_occupancy()).
+    _ListSkipIndex* sorted = NULL;    // Skip index of lists in sorted container mode (see listsorted_.h).
+    list_elem_t* payload = NULL;      // Payload slab of lists with LIST_INDIRECT elements (slot 0 is never taken).
+    size_t* free_slots = NULL;        // Stack of released slab slots.
+    size_t free_slot_count = 0;
+    size_t used_slots = 0;            // Number of slots ever taken (including slot 0).
+};
+
+static_assert(LIST_INLINE_CELLS == 0 || LIST_INLINE_CELLS >= 2, "Inline buffers need space for the sentinel and an element.");
+
+/**
+ * @brief List keeping its first LIST_INLINE_CELLS cells (the sentinel included) in the object itself.
+ * 
+ * @note Small lists are made by List_ctor_small() and passed to all other calls by their list member.
+ *       While the buffer is inline, the list points into the object, so it can be neither copied nor moved.
+ */
+struct SmallList {
+    List list = {};
+#if LIST_INLINE_CELLS > 0
+    _ListCell inline_cells[LIST_INLINE_CELLS];
+#endif
+
+    SmallList() = default;
+    SmallList(const SmallList&) = delete;
+    SmallList(SmallList&&) = delete;
+    SmallList& operator=(const SmallList&) = delete;
+    SmallList& operator=(SmallList&&) = delete;
 };
 
 /**
@@ -58,8 +266,40 @@ struct List {
  * @param list list to initialize
  * @param capacity max number of elements the list can hold +1 empty element
  * @param err_code variable to use as errno
+ * @param site place the list is attributed to in the allocation profile
+ */
+void List_ctor(List* list, size_t capacity = 1024, int* const err_code = NULL, const AllocSite site = ALLOC_SITE_HERE);
+
+/**
+ * @brief Initialize list of the specified size with buffers allocated in the specified way.
+ * 
+ * @note Huge pages cut TLB misses of traversals over big scattered lists.
+ *       Options stay with the list, so buffers made by List_linearize_parallel() are allocated the same way.
+ *       Options.pages is set to the kind of pages the buffer actually got (huge pages may be unavailable).
+ * 
+ * @param list list to initialize
+ * @param capacity max number of elements the list can hold +1 empty element
+ * @param options way to allocate the buffer
+ * @param err_code variable to use as errno
+ * @param site place the list is attributed to in the allocation profile
  */
-void List_ctor(List* list, size_t capacity = 1024, int* const err_code = NULL);
+void List_ctor_with(List* list, size_t capacity, const PageAllocOptions* const options, int* const err_code = NULL,
+                    const AllocSite site = ALLOC_SITE_HERE);
+
+/**
+ * @brief Initialize empty small list that starts in its inline buffer and grows when it fills up.
+ * 
+ * @note Buffers spill to the heap (then double) when insertions find no free cell.
+ *       Cells keep their indices, so positions stay valid, but pointers to elements do not.
+ *       Lists that wrapped around the end of the full buffer stop being linearized.
+ *       With LIST_INLINE_CELLS defined as 0 lists start with the smallest heap buffer instead.
+ *       Checksums, counters and observers are only kept from the first call that needs them (see _ListExtras).
+ * 
+ * @param small small list to initialize
+ * @param err_code variable to use as errno
+ * @param site place the list is attributed to in the allocation profile
+ */
+void List_ctor_small(SmallList* small, int* const err_code = NULL, const AllocSite site = ALLOC_SITE_HERE);
 
 /**
  * @brief Destroy the list.
@@ -84,15 +324,124 @@ void List_dtor_void(List* const list);
  */
 void List_linearize(List* const list, int* const err_code = NULL);
 
+/**
+ * @brief Sort list elements for faster element access using multiple threads.
+ * 
+ * @note Ranks the list by splitting it into sublists that are walked in parallel,
+ *       then scatters every element into a fresh buffer at its final position.
+ *       Requires one extra buffer of list capacity for the duration of the call.
+ * 
+ * @param list list to linearize
+ * @param pool thread pool to run on (NULL falls back to List_linearize())
+ * @param err_code variable to use as errno
+ */
+void List_linearize_parallel(List* const list, ThreadPool* const pool, int* const err_code = NULL);
+
+/**
+ * @brief Measure how scattered list elements are in the buffer.
+ * 
+ * @note Walks the whole list, so it takes O(size) time for non-linearized lists.
+ * 
+ * @param list
+ * @param err_code variable to use as errno
+ * @return fraction of links between consecutive elements that do not lead to the next buffer cell
+ *         (0 for linearized lists, about 1 for lists with elements spread randomly)
+ */
+double List_fragmentation(List* const list, int* const err_code = NULL);
+
+/**
+ * @brief Start or stop keeping the bitmap of cells holding elements.
+ * 
+ * @note Without the bitmap free cells are recognized by LIST_ELEM_POISON contents, so the value can not be stored.
+ *       With it the value is only used to fill free cells, and List_status() checks the size with popcounts.
+ *       List_count(), List_min(), List_max() and List_sum() of non-linearized lists sweep the bitmap
+ *       instead of following links (List_sum() then adds elements in buffer order).
+ *       List files and streams do not keep the bitmap, so they can not hold LIST_ELEM_POISON elements.
+ * 
+ * @param list
+ * @param enable true to build the bitmap, false to drop it (fails if an element is equal to LIST_ELEM_POISON)
+ * @param err_code variable to use as errno
+ */
+void List_track_occupancy(List* const list, const bool enable, int* const err_code = NULL);
+
+/**
+ * @brief Choose how list operations check the list.
+ * 
+ * @note Checksums are updated in O(1) time by every operation and verified by List_status(),
+ *       so audits also catch stray writes that keep the links consistent.
+ *       Cheap checks skip check_ptr() probes of the buffer.
+ *       Small lists get the checksum with the audit state, so they keep none if audit_interval is 0.
+ * 
+ * @param list
+ * @param mode
+ * @param audit_interval number of cheap checks per full audit (0 to only run cheap checks, ignored by LIST_CHECK_FULL)
+ * @param err_code variable to use as errno
+ */
+void List_set_checks(List* const list, const ListCheckMode mode, const size_t audit_interval, int* const err_code = NULL);
+
+//* Function applied to list elements by List_for_each().
+typedef void list_visitor_t(list_elem_t* elem, void* ctx);
+
+//* Associative function used to fold list elements in List_reduce().
+typedef list_elem_t list_reducer_t(const list_elem_t left, const list_elem_t right, void* ctx);
+
+/**
+ * @brief Apply visitor to every element of the list.
+ * 
+ * @note Elements may be visited in any order and from multiple threads at once.
+ * 
+ * @param list
+ * @param visitor function to apply
+ * @param ctx argument passed to every visitor call
+ * @param pool thread pool to run on (NULL to run on the calling thread)
+ * @param err_code variable to use as errno
+ */
+void List_for_each(List* const list, list_visitor_t* visitor, void* ctx, ThreadPool* const pool = NULL, int* const err_code = NULL);
+
+/**
+ * @brief Fold list elements in list order.
+ * 
+ * @param list
+ * @param reducer associative function to combine elements with
+ * @param initial value to start folding from
+ * @param ctx argument passed to every reducer call
+ * @param pool thread pool to run on (NULL to run on the calling thread)
+ * @param err_code variable to use as errno
+ * @return list_elem_t
+ */
+list_elem_t List_reduce(List* const list, list_reducer_t* reducer, const list_elem_t initial, void* ctx,
+                        ThreadPool* const pool = NULL, int* const err_code = NULL);
+
 /**
  * @brief Insert element into the list.
  * 
+ * @note Element is moved into its storage, so temporary elements are never copied.
+ * 
  * @param list 
  * @param elem element to insert
  * @param position which element to insert after
  * @param err_code variable to use as errno
  */
-list_position_t List_insert(List* const list, const list_elem_t elem, const list_position_t position, int* const err_code = NULL);
+list_position_t List_insert(List* const list, list_elem_t elem, const list_position_t position, int* const err_code = NULL);
+
+//* Function creating the element right in its list storage for List_emplace().
+//* Storage is uninitialized, so elements of non-trivial types have to be created there with placement new.
+typedef void list_constructor_t(list_elem_t* storage, void* ctx);
+
+/**
+ * @brief Insert element constructed in place, so it is never copied.
+ * 
+ * @note Refused for lists in sorted container mode (use List_insert_sorted()).
+ * 
+ * @param list
+ * @param position which element to insert after
+ * @param constructor function creating the element
+ * @param ctx argument passed to the constructor
+ * @param err_code variable to use as errno
+ * @return position of the inserted element
+ */
+list_position_t List_emplace(List* const list, const list_position_t position, list_constructor_t* constructor, void* ctx,
+                             int* const err_code = NULL);
 
 /**
  * @brief Find position of the index'th element in the list.
@@ -108,12 +457,106 @@ list_position_t List_find_position(List* const list, const int index, int* const
  * @brief Get element from the list at specified position.
  * 
  * @param list 
- * @param position position of the element
+ * @param position position of the element (free cells are rejected with EINVAL)
  * @param err_code variable to use as errno
  * @return list_elem_t
  */
 list_elem_t List_get(List* const list, const list_position_t position, int* const err_code = NULL);
 
+/**
+ * @brief Find positions (and values) of many elements of the list at once.
+ * 
+ * @note Indices are sorted and answered in one walk from both ends of the list,
+ *       so k lookups take O(k log k + n) time instead of O(k n) ones of separate List_find_position() calls.
+ * 
+ * @param list
+ * @param indices indices of the elements (negative to count from the tail)
+ * @param count number of indices
+ * @param[out] positions position of every element
+ * @param[out] values value of every element (can be NULL)
+ * @param err_code variable to use as errno
+ */
+void List_find_positions(List* const list, const int* indices, const size_t count, list_position_t* const positions,
+                         list_elem_t* const values = NULL, int* const err_code = NULL);
+
+/**
+ * @brief Find positions (and values) of elements of many lists.
+ * 
+ * @note Walks of LIST_LOOKUP_GROUP lookups are interleaved and their next cells are prefetched,
+ *       so cache misses of one walk overlap with steps of the others.
+ * 
+ * @param lists list of every lookup (lists may repeat)
+ * @param indices index of the element in its list (negative to count from the tail)
+ * @param count number of lookups
+ * @param[out] positions position of every element
+ * @param[out] values value of every element (can be NULL)
+ * @param err_code variable to use as errno
+ */
+void List_find_positions_multi(List* const* lists, const int* indices, const size_t count, list_position_t* const positions,
+                               list_elem_t* const values = NULL, int* const err_code = NULL);
+
+/**
+ * @brief Find position of the first element equal to the value.
+ * 
+ * @note Linearized lists are scanned with SIMD kernels if list_elem_t is int, long, long long or double.
+ * 
+ * @param list
+ * @param value value to search for
+ * @param err_code variable to use as errno
+ * @return position of the element or 0 if there is none
+ */
+list_position_t List_find_value(List* const list, const list_elem_t value, int* const err_code = NULL);
+
+/**
+ * @brief Count elements equal to the value.
+ * 
+ * @param list
+ * @param value value to count
+ * @param err_code variable to use as errno
+ * @return size_t
+ */
+size_t List_count(List* const list, const list_elem_t value, int* const err_code = NULL);
+
+//* Define LIST_NO_ARITHMETIC before the library include if list_elem_t does not support operators < and +.
+#ifndef LIST_NO_ARITHMETIC
+
+/**
+ * @brief Find minimal element of the list.
+ * 
+ * @note Elements only replace the result when they compare less, so NaNs are skipped unless the head is one
+ *       (then the result is NaN). Linearized and scattered lists give the same result.
+ * 
+ * @param list non-empty list
+ * @param err_code variable to use as errno
+ * @return list_elem_t
+ */
+list_elem_t List_min(List* const list, int* const err_code = NULL);
+
+/**
+ * @brief Find maximal element of the list.
+ * 
+ * @note Elements only replace the result when they compare greater, so NaNs are skipped unless the head is one
+ *       (then the result is NaN). Linearized and scattered lists give the same result.
+ * 
+ * @param list non-empty list
+ * @param err_code variable to use as errno
+ * @return list_elem_t
+ */
+list_elem_t List_max(List* const list, int* const err_code = NULL);
+
+/**
+ * @brief Calculate sum of the list elements.
+ * 
+ * @note Sum of floating point elements may be accumulated in any order.
+ * 
+ * @param list
+ * @param err_code variable to use as errno
+ * @return list_elem_t
+ */
+list_elem_t List_sum(List* const list, int* const err_code = NULL);
+
+#endif
+
 /**
  * @brief Remove element from the list.
  * 
@@ -123,9 +566,156 @@ list_elem_t List_get(List* const list, const list_position_t position, int* cons
  */
 void List_pop(List* const list, const list_position_t position, int* const err_code = NULL);
 
+/**
+ * @brief Remove element from the list moving it out.
+ * 
+ * @param list
+ * @param position position of the element
+ * @param[out] elem where to move the element
+ * @param err_code variable to use as errno
+ */
+void List_extract(List* const list, const list_position_t position, list_elem_t* const elem, int* const err_code = NULL);
+
+//* Condition of elements removed by List_remove_if().
+typedef bool list_predicate_t(const list_elem_t* elem, void* ctx);
+
+/**
+ * @brief Remove every element matching the predicate.
+ * 
+ * @note Walks the list once and checks it once before and once after the walk, so k removals take O(size) time
+ *       instead of k List_find_position() and List_pop() calls. Predicate is called once per element in list order.
+ *       Freed cells join the free cell ring in one splice, in the order k pops would leave them.
+ *       Linearized lists move the remaining elements towards the head instead, so they stay linearized
+ *       (positions of the moved elements change).
+ * 
+ * @param list
+ * @param predicate function telling if the element has to be removed
+ * @param ctx argument passed to every predicate call
+ * @param err_code variable to use as errno
+ * @return number of removed elements
+ */
+size_t List_remove_if(List* const list, list_predicate_t* predicate, void* ctx, int* const err_code = NULL);
+
+/**
+ * @brief Move element to another place in the list.
+ * 
+ * @note Element stays in its cell, so its position stays valid (unlike pop and insert, takes no free cell).
+ *       Refused for lists in sorted container mode.
+ * 
+ * @param list
+ * @param cell position of the element to move
+ * @param position which element to put it after (0 to put it at the head)
+ * @param err_code variable to use as errno
+ */
+void List_move(List* const list, const list_position_t cell, const list_position_t position, int* const err_code = NULL);
+
+/**
+ * @brief Replace element at the specified position.
+ * 
+ * @note Lists in sorted container mode refuse values that would break the order.
+ * 
+ * @param list
+ * @param position position of the element
+ * @param elem new value of the element
+ * @param err_code variable to use as errno
+ */
+void List_set(List* const list, const list_position_t position, list_elem_t elem, int* const err_code = NULL);
+
+/**
+ * @brief Reverse the order of list elements.
+ * 
+ * @note Takes O(1) time: the list only swaps roles of next and prev links, so elements keep their cells.
+ *       Later operations read the links that way (inserting after the element links the new one before its cell).
+ *       Refused for lists in sorted container mode.
+ * 
+ * @param list
+ * @param err_code variable to use as errno
+ */
+void List_reverse(List* const list, int* const err_code = NULL);
+
+/**
+ * @brief Make the element at the index the head of the list keeping the cyclic order of elements.
+ * 
+ * @note Only the sentinel is relinked (between the element and the one before it), so elements keep their cells,
+ *       and the rotation takes O(1) time once the element is found (see List_find_position()):
+ *       linearized lists find it by index arithmetic, the rest follow links from the closer end.
+ *       Linearized lists stay linearized and remember how far their head went in List::rotation.
+ *       Refused for lists in sorted container mode.
+ * 
+ * @param list
+ * @param steps index of the new head (negative to count from the tail, taken modulo the size)
+ * @param err_code variable to use as errno
+ */
+void List_rotate(List* const list, const int steps, int* const err_code = NULL);
+
+/**
+ * @brief Write list into the file.
+ * 
+ * @note The file is replaced atomically. Mapped lists keep working with their own file,
+ *       use List_sync() to persist their changes there. Refused for lists of LIST_INDIRECT elements.
+ * 
+ * @param list
+ * @param file_name name of the file to (over)write
+ * @param err_code variable to use as errno
+ */
+void List_save(List* const list, const char* file_name, int* const err_code = NULL);
+
+/**
+ * @brief Initialize list with buffer mapped from the list file.
+ * 
+ * @note Loading does not read list cells, so it takes O(1) time. All later changes
+ *       of the list go directly to the file, List_dtor() or List_sync() mark it as consistent.
+ *       Files left inconsistent (the process stopped between syncs) are rejected even with verify:
+ *       their header misses the size, free cells and direction changed since the last sync,
+ *       so neither this function nor List_load() can rebuild the list. Keep a journal
+ *       (see List_recover()) for lists that have to survive crashes.
+ * 
+ * @param list list to initialize
+ * @param file_name name of the file created by List_save()
+ * @param verify true to run full List_status() check on the mapped cells (takes O(capacity) time)
+ * @param err_code variable to use as errno
+ * @return list_report_t problems found in the file (list is left uninitialized if it is not zero)
+ */
+list_report_t List_open_mapped(List* const list, const char* file_name, const bool verify = false, int* const err_code = NULL);
+
+/**
+ * @brief Initialize list with a heap copy of the list file.
+ * 
+ * @param list list to initialize
+ * @param file_name name of the file created by List_save()
+ * @param err_code variable to use as errno
+ * @return list_report_t problems found in the file (list is left uninitialized if it is not zero)
+ */
+list_report_t List_load(List* const list, const char* file_name, int* const err_code = NULL);
+
+/**
+ * @brief Write list header into its mapped file and flush the mapping.
+ * 
+ * @param list mapped list
+ * @param err_code variable to use as errno
+ */
+void List_sync(List* const list, int* const err_code = NULL);
+
+/**
+ * @brief Print latency percentiles of list operations (collected with LIST_TRACE defined).
+ * 
+ * @param stream stream to print to
+ */
+void List_print_trace(FILE* stream);
+
+/**
+ * @brief Write list operation spans selected in LatencyTrace_start() in Chrome trace-event format.
+ * 
+ * @param file_name name of the JSON file to write
+ * @param err_code variable to use as errno
+ */
+void List_write_trace(const char* file_name, int* const err_code = NULL);
+
 /**
  * @brief Get info about list as binary mask.
  * 
+ * @note Walks all cells outside of the lazy region and recomputes the list checksum (O(capacity) time).
+ * 
  * @param list 
  * @return list_report_t
  */
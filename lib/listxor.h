@@ -0,0 +1,366 @@
+/**
+ * @file listxor.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief .cpp - style file for listworks XOR lists.
+ * @version 0.1
+ * @date 2022-11-22
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+//* Function headers are specified in the file listxor_.h
+
+#ifndef LISTXOR_HPP
+#define LISTXOR_HPP
+
+#include "listxor_.h"
+
+#include <stdlib.h>
+
+static inline list_position_t _XorList_position(const list_link_t prev, const list_link_t cell) {
+    return (list_position_t)prev << 32 | cell;
+}
+
+static inline list_link_t _XorList_cell(const list_position_t position) { return (list_link_t)(position & UINT32_MAX); }
+static inline list_link_t _XorList_prev(const list_position_t position) { return (list_link_t)(position >> 32); }
+
+/**
+ * @brief Check list fields operations rely on.
+ * 
+ * @param list
+ * @return true if the list can be worked with
+ */
+static inline bool _XorList_valid(const XorList* const list) {
+    return list && list->buffer && list->used_cells <= list->capacity && list->size < list->capacity;
+}
+
+/**
+ * @brief Check if the cell holds an element of the list.
+ * 
+ * @param list
+ * @param cell
+ * @return bool
+ */
+static inline bool _XorList_occupied(const XorList* const list, const list_link_t cell) {
+    return cell != 0 && cell < list->used_cells && list->buffer[cell].content != LIST_ELEM_POISON;
+}
+
+/**
+ * @brief Check if the position belongs to an element of the list.
+ * 
+ * @note Only checks the cells the position refers to.
+ * 
+ * @param list
+ * @param position
+ * @return bool
+ */
+static inline bool _XorList_has_position(const XorList* const list, const list_position_t position) {
+    list_link_t cell = _XorList_cell(position);
+    list_link_t prev = _XorList_prev(position);
+
+    if (!_XorList_occupied(list, cell)) return false;
+    if (prev == 0) return cell == list->head;
+
+    return _XorList_occupied(list, prev) && (list->buffer[cell].link ^ prev) < list->used_cells;
+}
+
+void List_ctor(XorList* const list, size_t capacity, int* const err_code) {
+    _LOG_FAIL_CHECK_(check_ptr(list),                                   "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(1 < capacity && capacity <= LIST_XOR_MAX_CAPACITY, "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    list->buffer = (_ListXorCell*) calloc(capacity, sizeof(*list->buffer));
+    _LOG_FAIL_CHECK_(list->buffer, "error", ERROR_REPORTS, return, err_code, ENOMEM);
+
+    //* Cells past used_cells are poisoned when they are taken.
+    list->buffer[0] = _ListXorCell {};
+
+    list->capacity = capacity;
+    list->used_cells = 1;
+    list->free_cell = 0;
+    list->head = 0;
+    list->tail = 0;
+    list->size = 0;
+}
+
+void List_dtor(XorList* const list, int* const err_code) {
+    _LOG_FAIL_CHECK_(_XorList_valid(list), "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    free(list->buffer);
+    *list = XorList {};
+}
+
+list_position_t List_insert(XorList* const list, const list_elem_t elem, const list_position_t position, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_INSERT);
+
+    _LOG_FAIL_CHECK_(_XorList_valid(list), "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(position == 0 || _XorList_has_position(list, position),
+                     "error", ERROR_REPORTS, return 0, err_code, EINVAL);
+    _LOG_FAIL_CHECK_(list->free_cell != 0 || list->used_cells < list->capacity,
+                     "error", ERROR_REPORTS, return 0, err_code, ENOMEM);
+
+    _ListXorCell* buffer = list->buffer;
+
+    list_link_t prev = _XorList_prev(position);
+    list_link_t cell = _XorList_cell(position);
+    list_link_t next = cell ? buffer[cell].link ^ prev : list->head;
+
+    list_link_t pasted_cell = list->free_cell;
+
+    if (pasted_cell) list->free_cell = buffer[pasted_cell].link;
+    else             pasted_cell = (list_link_t)list->used_cells++;
+
+    buffer[pasted_cell].content = elem;
+    buffer[pasted_cell].link = cell ^ next;
+
+    if (cell) buffer[cell].link ^= next ^ pasted_cell;
+    else      list->head = pasted_cell;
+
+    if (next) buffer[next].link ^= cell ^ pasted_cell;
+    else      list->tail = pasted_cell;
+
+    ++list->size;
+
+    return _XorList_position(cell, pasted_cell);
+}
+
+list_position_t List_find_position(XorList* const list, const int index, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_FIND_POSITION);
+
+    _LOG_FAIL_CHECK_(_XorList_valid(list), "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+
+    _LOG_FAIL_CHECK_((-(int)list->size <= index && index < (int)list->size) || list->size == 0, "error", ERROR_REPORTS, {
+        log_printf(ERROR_REPORTS, "error", "Requested index was %d with size %lld.\n", index, (long long) list->size);
+        return 0;
+    }, err_code, EFAULT);
+
+    if (list->size == 0) return 0;
+
+    _ListXorCell* buffer = list->buffer;
+
+    if (index >= 0) {
+        list_link_t prev = 0;
+        list_link_t current = list->head;
+
+        for (int step = 0; step < index; ++step) {
+            list_link_t next = buffer[current].link ^ prev;
+            prev = current;
+            current = next;
+        }
+
+        return _XorList_position(prev, current);
+    }
+
+    list_link_t next = 0;
+    list_link_t current = list->tail;
+
+    for (int step = 0; step < -index - 1; ++step) {
+        list_link_t prev = buffer[current].link ^ next;
+        next = current;
+        current = prev;
+    }
+
+    return _XorList_position(buffer[current].link ^ next, current);
+}
+
+list_position_t List_next(XorList* const list, const list_position_t position, int* const err_code) {
+    _LOG_FAIL_CHECK_(_XorList_valid(list), "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(position == 0 || _XorList_has_position(list, position),
+                     "error", ERROR_REPORTS, return 0, err_code, EINVAL);
+
+    if (position == 0) return list->head ? _XorList_position(0, list->head) : 0;
+
+    list_link_t cell = _XorList_cell(position);
+    list_link_t next = list->buffer[cell].link ^ _XorList_prev(position);
+
+    return next ? _XorList_position(cell, next) : 0;
+}
+
+list_position_t List_prev(XorList* const list, const list_position_t position, int* const err_code) {
+    _LOG_FAIL_CHECK_(_XorList_valid(list), "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(position == 0 || _XorList_has_position(list, position),
+                     "error", ERROR_REPORTS, return 0, err_code, EINVAL);
+
+    if (position == 0) return list->tail ? _XorList_position(list->buffer[list->tail].link, list->tail) : 0;
+
+    list_link_t prev = _XorList_prev(position);
+
+    return prev ? _XorList_position(list->buffer[prev].link ^ _XorList_cell(position), prev) : 0;
+}
+
+list_elem_t List_get(XorList* const list, const list_position_t position, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_GET);
+
+    _LOG_FAIL_CHECK_(_XorList_valid(list), "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(_XorList_occupied(list, _XorList_cell(position)), "error", ERROR_REPORTS, return 0, err_code, EINVAL);
+
+    return list->buffer[_XorList_cell(position)].content;
+}
+
+void List_pop(XorList* const list, const list_position_t position, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_POP);
+
+    _LOG_FAIL_CHECK_(_XorList_valid(list),                  "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(_XorList_has_position(list, position), "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    _ListXorCell* buffer = list->buffer;
+
+    list_link_t prev = _XorList_prev(position);
+    list_link_t cell = _XorList_cell(position);
+    list_link_t next = buffer[cell].link ^ prev;
+
+    if (prev) buffer[prev].link ^= cell ^ next;
+    else      list->head = next;
+
+    if (next) buffer[next].link ^= cell ^ prev;
+    else      list->tail = prev;
+
+    buffer[cell].content = LIST_ELEM_POISON;
+    buffer[cell].link = list->free_cell;
+    list->free_cell = cell;
+
+    --list->size;
+}
+
+list_position_t List_find_value(XorList* const list, const list_elem_t value, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_SCAN);
+
+    _LOG_FAIL_CHECK_(_XorList_valid(list), "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+
+    _ListXorCell* buffer = list->buffer;
+
+    for (list_link_t prev = 0, cell = list->head, next = 0; cell != 0; prev = cell, cell = next) {
+        if (buffer[cell].content == value) return _XorList_position(prev, cell);
+        next = buffer[cell].link ^ prev;
+    }
+
+    return 0;
+}
+
+size_t List_count(XorList* const list, const list_elem_t value, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_SCAN);
+
+    _LOG_FAIL_CHECK_(_XorList_valid(list), "error", ERROR_REPORTS, return 0, err_code, EFAULT);
+
+    _ListXorCell* buffer = list->buffer;
+    size_t count = 0;
+
+    for (list_link_t prev = 0, cell = list->head, next = 0; cell != 0; prev = cell, cell = next) {
+        count += buffer[cell].content == value;
+        next = buffer[cell].link ^ prev;
+    }
+
+    return count;
+}
+
+void List_for_each(XorList* const list, list_visitor_t* visitor, void* ctx, int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_TRAVERSE);
+
+    _LOG_FAIL_CHECK_(_XorList_valid(list), "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(visitor,              "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    _ListXorCell* buffer = list->buffer;
+
+    for (list_link_t prev = 0, cell = list->head, next = 0; cell != 0; prev = cell, cell = next) {
+        next = buffer[cell].link ^ prev;
+        visitor(&buffer[cell].content, ctx);
+    }
+}
+
+list_elem_t List_reduce(XorList* const list, list_reducer_t* reducer, const list_elem_t initial, void* ctx,
+                        int* const err_code) {
+    _LIST_TRACE_(LIST_SPAN_TRAVERSE);
+
+    _LOG_FAIL_CHECK_(_XorList_valid(list), "error", ERROR_REPORTS, return initial, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(reducer,              "error", ERROR_REPORTS, return initial, err_code, EINVAL);
+
+    _ListXorCell* buffer = list->buffer;
+    list_elem_t result = initial;
+
+    for (list_link_t prev = 0, cell = list->head, next = 0; cell != 0; prev = cell, cell = next) {
+        result = reducer(result, buffer[cell].content, ctx);
+        next = buffer[cell].link ^ prev;
+    }
+
+    return result;
+}
+
+list_report_t List_status(XorList* const list) {
+    _LIST_TRACE_(LIST_SPAN_STATUS);
+
+    _LOG_FAIL_CHECK_(list, "error", ERROR_REPORTS, return LIST_NULL, NULL, 0);
+
+    list_report_t report = 0;
+
+    if (list->size >= list->capacity) report |= LIST_BIG_SIZE;
+    if (!check_ptr(list->buffer) || list->used_cells > list->capacity) return report | LIST_NULL_CONTENT;
+
+    _ListXorCell* buffer = list->buffer;
+
+    size_t element_count = 0;
+    list_link_t prev = 0;
+
+    for (list_link_t cell = list->head; cell != 0; ++element_count) {
+        if (!_XorList_occupied(list, cell) || element_count >= list->size) return report | LIST_INV_CONNECTIONS;
+
+        list_link_t next = buffer[cell].link ^ prev;
+        prev = cell;
+        cell = next;
+    }
+
+    if (prev != list->tail || element_count != list->size) report |= LIST_INV_CONNECTIONS;
+
+    size_t free_count = 0;
+    for (list_link_t cell = list->free_cell; cell != 0; cell = buffer[cell].link, ++free_count) {
+        if (cell >= list->used_cells || buffer[cell].content != LIST_ELEM_POISON || free_count >= list->used_cells)
+            return report | LIST_INV_FREE;
+    }
+
+    //* Every taken cell but cell 0 either holds an element or is stacked as free.
+    if (element_count + free_count + 1 != list->used_cells) report |= LIST_INV_FREE;
+
+    return report;
+}
+
+void _List_dump(XorList* const list, const unsigned int importance, const int line, const char* func_name, const char* file_name) {
+    _log_printf(importance, LIST_DUMP_TAG, " ----- XOR list dump in function %s of file %s (%lld): ----- \n",
+                func_name, file_name, (long long) line);
+
+    list_report_t status = List_status(list);
+
+    _log_printf(importance, LIST_DUMP_TAG, "XOR list at %p:\n", list);
+
+    _log_printf(importance, LIST_DUMP_TAG, "\tStatus: %s\n", status ? "CORRUPT" : "OK");
+
+    for (int error_id = 0; error_id < (int)sizeof(LIST_STATUS_DESCR) / (int)sizeof(LIST_STATUS_DESCR[0]); ++error_id) {
+        if (status & (1 << error_id)) {
+            _log_printf(importance, LIST_DUMP_TAG, "\t\t%s\n", LIST_STATUS_DESCR[error_id]);
+        }
+    }
+
+    if (status & LIST_NULL) return;
+
+    _log_printf(importance, LIST_DUMP_TAG, "\thead =       %lld,\n", (long long) list->head);
+    _log_printf(importance, LIST_DUMP_TAG, "\ttail =       %lld,\n", (long long) list->tail);
+    _log_printf(importance, LIST_DUMP_TAG, "\tfree cell =  %lld,\n", (long long) list->free_cell);
+    _log_printf(importance, LIST_DUMP_TAG, "\tsize =       %lld,\n", (long long) list->size);
+    _log_printf(importance, LIST_DUMP_TAG, "\tused cells = %lld,\n", (long long) list->used_cells);
+    _log_printf(importance, LIST_DUMP_TAG, "\tcapacity =   %lld,\n", (long long) list->capacity);
+    _log_printf(importance, LIST_DUMP_TAG, "\tbuffer at %p:\n", list->buffer);
+
+    if (status & LIST_NULL_CONTENT) return;
+
+    for (size_t id = 0; id < list->used_cells; id++) {
+        unsigned char* data_start = (unsigned char*)(list->buffer + id);
+        _log_printf(importance, LIST_DUMP_TAG, "\t\t[%5ld] = %02X %02X %02X %02X (%s), link [%lld]\n", (long) id,
+            data_start[0], data_start[1], data_start[2], data_start[3],
+            list->buffer[id].content == LIST_ELEM_POISON ? "POISON" : "VALUE", (long long) list->buffer[id].link);
+    }
+}
+
+void _List_dump_graph(XorList* const list, const unsigned int importance) {
+    SILENCE_UNUSED(list);
+    SILENCE_UNUSED(importance);
+}
+
+#endif
@@ -0,0 +1,206 @@
+/**
+ * @file listxor_.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Compact XOR-linked list storage with the listworks API.
+ * @version 0.1
+ * @date 2022-11-22
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#ifndef LISTXOR_H
+#define LISTXOR_H
+
+#include <stdint.h>
+
+#include "listworks_.h"
+
+//* XOR lists keep a single 32-bit link per cell (prev ^ next, 0 stands for no neighbour),
+//* so cells of small elements take a half or a third of List cells.
+//*
+//* Functions are overloads of the List_* ones, so code written for List works with XorList as well.
+//* Cells are found by their neighbours, so positions are (prev, cell) pairs packed as prev << 32 | cell
+//* (0 is still the place before the head). Positions stay valid until the previous element changes,
+//* List_next() and List_prev() move them in both directions.
+
+//* Type of XOR list cell indices.
+typedef uint32_t list_link_t;
+
+//* Max number of cells in XOR lists.
+const size_t LIST_XOR_MAX_CAPACITY = UINT32_MAX;
+
+/**
+ * @brief XOR list cell.
+ * 
+ * @note Free cells are poisoned and stacked through their links.
+ */
+struct _ListXorCell {
+    list_elem_t content = LIST_ELEM_POISON;
+    list_link_t link = 0;
+};
+
+/**
+ * @brief XOR-linked list data structure.
+ * 
+ */
+struct XorList {
+    _ListXorCell* buffer = NULL;    // Cell 0 is never used, so 0 links mean no neighbour.
+    size_t capacity = 0;
+    size_t used_cells = 0;          // Number of cells ever taken (including cell 0).
+    list_link_t free_cell = 0;      // First cell of the free cell stack (0 if it is empty).
+    list_link_t head = 0;
+    list_link_t tail = 0;
+    size_t size = 0;
+};
+
+/**
+ * @brief Initialize XOR list of the specified size.
+ * 
+ * @param list list to initialize
+ * @param capacity max number of elements the list can hold +1 empty element
+ * @param err_code variable to use as errno
+ */
+void List_ctor(XorList* const list, size_t capacity = 1024, int* const err_code = NULL);
+
+/**
+ * @brief Destroy the list.
+ * 
+ * @param list list to uninitialize
+ * @param err_code variable to use as errno
+ */
+void List_dtor(XorList* const list, int* const err_code = NULL);
+
+/**
+ * @brief Insert element into the list.
+ * 
+ * @param list
+ * @param elem element to insert
+ * @param position which element to insert after
+ * @param err_code variable to use as errno
+ * @return position of the inserted element
+ */
+list_position_t List_insert(XorList* const list, const list_elem_t elem, const list_position_t position, int* const err_code = NULL);
+
+/**
+ * @brief Find position of the index'th element in the list.
+ * 
+ * @param list
+ * @param index index of the element (negative to count from the tail)
+ * @param err_code variable to use as errno
+ * @return list_position_t
+ */
+list_position_t List_find_position(XorList* const list, const int index, int* const err_code = NULL);
+
+/**
+ * @brief Get position of the element after the specified one.
+ * 
+ * @param list
+ * @param position position of the element (0 to get the head)
+ * @param err_code variable to use as errno
+ * @return list_position_t (0 after the tail)
+ */
+list_position_t List_next(XorList* const list, const list_position_t position, int* const err_code = NULL);
+
+/**
+ * @brief Get position of the element before the specified one.
+ * 
+ * @param list
+ * @param position position of the element (0 to get the tail)
+ * @param err_code variable to use as errno
+ * @return list_position_t (0 before the head)
+ */
+list_position_t List_prev(XorList* const list, const list_position_t position, int* const err_code = NULL);
+
+/**
+ * @brief Get element from the list at specified position.
+ * 
+ * @param list
+ * @param position position of the element
+ * @param err_code variable to use as errno
+ * @return list_elem_t
+ */
+list_elem_t List_get(XorList* const list, const list_position_t position, int* const err_code = NULL);
+
+/**
+ * @brief Remove element at specified position.
+ * 
+ * @param list
+ * @param position position of the element
+ * @param err_code variable to use as errno
+ */
+void List_pop(XorList* const list, const list_position_t position, int* const err_code = NULL);
+
+/**
+ * @brief Find position of the first element equal to the value.
+ * 
+ * @param list
+ * @param value value to search for
+ * @param err_code variable to use as errno
+ * @return position of the element or 0 if there is none
+ */
+list_position_t List_find_value(XorList* const list, const list_elem_t value, int* const err_code = NULL);
+
+/**
+ * @brief Count elements equal to the value.
+ * 
+ * @param list
+ * @param value value to count
+ * @param err_code variable to use as errno
+ * @return size_t
+ */
+size_t List_count(XorList* const list, const list_elem_t value, int* const err_code = NULL);
+
+/**
+ * @brief Apply visitor to every element of the list in list order.
+ * 
+ * @param list
+ * @param visitor function to apply
+ * @param ctx argument passed to every visitor call
+ * @param err_code variable to use as errno
+ */
+void List_for_each(XorList* const list, list_visitor_t* visitor, void* ctx, int* const err_code = NULL);
+
+/**
+ * @brief Fold list elements in list order.
+ * 
+ * @param list
+ * @param reducer function to combine elements with
+ * @param initial value to start folding from
+ * @param ctx argument passed to every reducer call
+ * @param err_code variable to use as errno
+ * @return list_elem_t
+ */
+list_elem_t List_reduce(XorList* const list, list_reducer_t* reducer, const list_elem_t initial, void* ctx,
+                        int* const err_code = NULL);
+
+/**
+ * @brief Get info about list as binary mask.
+ * 
+ * @note Walks the whole list, list operations only check list fields and the cells they use.
+ * 
+ * @param list
+ * @return list_report_t
+ */
+list_report_t List_status(XorList* const list);
+
+/**
+ * @brief [Should only be called by List_dump() macro] Dump the list into logs.
+ * 
+ * @param list
+ * @param importance message importance
+ * @param line line at which the call was at
+ * @param func_name name of the top-function
+ * @param file_name name of the file where invocation happened
+ */
+void _List_dump(XorList* const list, const unsigned int importance, const int line, const char* func_name, const char* file_name);
+
+/**
+ * @brief [Should only be called by List_dump() macro] XOR lists have no graph images, does nothing.
+ * 
+ * @param list
+ * @param importance
+ */
+void _List_dump_graph(XorList* const list, const unsigned int importance);
+
+#endif
@@ -61,6 +61,18 @@ void edit_string(const int argc, void** argv, const char* argument) {
     strcpy(*(char**)argv, argument);
 }
 
+void edit_bounded_string(const int argc, void** argv, const char* argument) {
+    const size_t size = argc >= 2 ? *(size_t*)argv[1] : 0;
+    const size_t max_length = size ? size - 1 : 0;
+
+    if (strlen(argument) > max_length || size == 0) {
+        printf("Argument \"%s\" is too long (at most %lu characters are allowed).\n", argument, (unsigned long) max_length);
+        exit(EXIT_FAILURE);
+    }
+
+    memcpy(argv[0], argument, strlen(argument) + 1);
+}
+
 void print_description(const ActionTag& tag) {
     if (*tag.name.long_name)
         printf("-%c --%s - %s\n\n", tag.name.short_name, tag.name.long_name, tag.description);
@@ -72,4 +72,13 @@ void edit_int(const int argc, void** argv, const char* argument);
  */
 void edit_string(const int argc, void** argv, const char* argument);
 
+/**
+ * @brief Set string value to the value of the argument if it fits into the buffer, exit otherwise.
+ * 
+ * @param argc number of arguments
+ * @param argv pointers to arguments (1-st element should be char*, 2-nd - size_t* with the buffer size)
+ * @param argument argument as string
+ */
+void edit_bounded_string(const int argc, void** argv, const char* argument);
+
 #endif
\ No newline at end of file
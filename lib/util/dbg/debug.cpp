@@ -3,6 +3,7 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <stdio.h>
+#include <string.h>
 
 void log_end_program() {
     log_printf(TERMINATE_REPORTS, "exit", "Program closed with errno = %d.\n", errno);
@@ -22,11 +23,36 @@ bool check_ptr(const void* ptr) {
     return result != -1;
 }
 
-hash_t get_simple_hash(const void* start, const void* end) {
-    hash_t hash = 0xDEADBABEDEAD;
-    for (const char* ptr = (const char*)start; ptr < (const char*)end; ++ptr) {
-        hash *= 0xC0FEBABEDEAD;
-        hash += (unsigned char)*ptr;
+/**
+ * @brief Mix the word into the hash.
+ * 
+ * @param hash
+ * @param word
+ * @return hash_t
+ */
+static inline hash_t mix_hash_word(hash_t hash, const hash_t word) {
+    hash = (hash ^ word) * 0xC0FEBABEDEAD1;
+    return hash ^ (hash >> 29);
+}
+
+hash_t get_simple_hash(const void* start, const void* end, hash_t hash) {
+    if (end <= start) return hash;
+
+    const unsigned char* ptr = (const unsigned char*)start;
+    size_t size = (size_t)((const unsigned char*)end - ptr);
+
+    for (; size >= sizeof(hash_t); ptr += sizeof(hash_t), size -= sizeof(hash_t)) {
+        hash_t word = 0;
+        memcpy(&word, ptr, sizeof(word));
+        hash = mix_hash_word(hash, word);
     }
+
+    //* Tail length is mixed in with the tail bytes, so buffers differing in trailing zeroes get different hashes.
+    if (size > 0) {
+        hash_t word = 0;
+        memcpy(&word, ptr, size);
+        hash = mix_hash_word(hash, word ^ ((hash_t)size << 56));
+    }
+
     return hash;
 }
\ No newline at end of file
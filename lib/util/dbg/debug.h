@@ -71,13 +71,19 @@ bool check_ptr(const void* ptr);
  */
 #define _ABORT_ON_ERRNO_() _LOG_FAIL_CHECK_(!errno, "FATAL ERROR", ABSOLUTE_IMPORTANCE, exit(EXIT_FAILURE);, NULL, 0);
 
+//* Initial value of get_simple_hash().
+const hash_t SIMPLE_HASH_SEED = 0xDEADBABEDEAD;
+
 /**
  * @brief Calculate hash value of the buffer.
  * 
+ * @note Reads the buffer by 8-byte words, hashes of a buffer split into parts depend on the split.
+ * 
  * @param start pointer to the start of the buffer
  * @param end pointer to the end of the buffer
+ * @param hash hash to continue (hash of the preceding data), SIMPLE_HASH_SEED to start a new one
  * @return hash_t 
  */
-hash_t get_simple_hash(const void* start, const void* end);
+hash_t get_simple_hash(const void* start, const void* end, hash_t hash = SIMPLE_HASH_SEED);
 
 #endif
\ No newline at end of file
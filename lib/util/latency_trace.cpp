@@ -0,0 +1,233 @@
+#include "latency_trace.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <time.h>
+#include <new>
+
+#include "dbg/debug.h"
+
+std::atomic<size_t> LatencyTraceSamplePeriod(0);
+
+static const size_t SUB_BUCKET_COUNT = (size_t)1 << LATENCY_TRACE_SUB_BITS;
+
+//* Minimal time between calibration points of the timestamp counter.
+static const double CALIBRATION_TIME_NS = 1e7;
+
+struct TraceEvent {
+    uint64_t start = 0;
+    uint64_t duration = 0;
+    uint32_t span_id = 0;
+    uint32_t thread_id = 0;
+};
+
+/**
+ * @brief Collected measurements (allocated by the first LatencyTrace_start() call).
+ * 
+ */
+struct TraceState {
+    unsigned long long histograms[LATENCY_TRACE_MAX_SPANS][LATENCY_TRACE_BUCKET_COUNT] = {};
+    unsigned long long max_ticks[LATENCY_TRACE_MAX_SPANS] = {};
+
+    uint64_t span_mask = 0;
+    TraceEvent* events = NULL;
+    size_t event_capacity = 0;
+    std::atomic<size_t> event_count = 0;
+
+    uint64_t start_ticks = 0;   // Timestamp and monotonic time of the LatencyTrace_start() call.
+    double start_ns = 0;
+};
+
+static TraceState* State = NULL;
+
+static double monotonic_ns() {
+    timespec moment = {};
+    clock_gettime(CLOCK_MONOTONIC, &moment);
+    return (double)moment.tv_sec * 1e9 + (double)moment.tv_nsec;
+}
+
+/**
+ * @brief Get number of timestamp counter ticks per nanosecond.
+ * 
+ * @note Waits until enough time passes since LatencyTrace_start() to measure it precisely.
+ * 
+ * @return double
+ */
+static double ticks_per_ns() {
+#ifdef LATENCY_TRACE_TSC
+    while (monotonic_ns() - State->start_ns < CALIBRATION_TIME_NS) {}
+
+    uint64_t ticks = latency_trace_now();
+    double elapsed = monotonic_ns() - State->start_ns;
+
+    return (double)(ticks - State->start_ticks) / elapsed;
+#else
+    return 1.0;
+#endif
+}
+
+static size_t bucket_of(const uint64_t value) {
+    if (value < SUB_BUCKET_COUNT) return (size_t)value;
+
+    int shift = 63 - __builtin_clzll(value) - LATENCY_TRACE_SUB_BITS;
+    return ((size_t)(shift + 1) << LATENCY_TRACE_SUB_BITS) + ((value >> shift) & (SUB_BUCKET_COUNT - 1));
+}
+
+/**
+ * @brief Get value in the middle of the bucket.
+ * 
+ * @param bucket
+ * @return double
+ */
+static double bucket_value(const size_t bucket) {
+    if (bucket < SUB_BUCKET_COUNT) return (double)bucket;
+
+    int shift = (int)(bucket >> LATENCY_TRACE_SUB_BITS) - 1;
+    uint64_t low = (SUB_BUCKET_COUNT + bucket % SUB_BUCKET_COUNT) << shift;
+
+    return (double)low + (double)((uint64_t)1 << shift) / 2;
+}
+
+void LatencyTrace_start(const size_t sample_period, const uint64_t span_mask, const size_t event_capacity, int* const err_code) {
+    LatencyTrace_stop();
+
+    if (!State) State = new (std::nothrow) TraceState;
+    _LOG_FAIL_CHECK_(State, "error", ERROR_REPORTS, return, err_code, ENOMEM);
+
+    for (size_t span_id = 0; span_id < LATENCY_TRACE_MAX_SPANS; ++span_id) {
+        for (size_t bucket = 0; bucket < LATENCY_TRACE_BUCKET_COUNT; ++bucket) State->histograms[span_id][bucket] = 0;
+        State->max_ticks[span_id] = 0;
+    }
+
+    free(State->events);
+    State->events = NULL;
+    State->event_capacity = 0;
+    State->event_count = 0;
+    State->span_mask = span_mask;
+
+    if (span_mask && event_capacity) {
+        State->events = (TraceEvent*) calloc(event_capacity, sizeof(*State->events));
+        _LOG_FAIL_CHECK_(State->events, "error", ERROR_REPORTS, return, err_code, ENOMEM);
+        State->event_capacity = event_capacity;
+    }
+
+    State->start_ns = monotonic_ns();
+    State->start_ticks = latency_trace_now();
+
+    LatencyTraceSamplePeriod.store(sample_period, std::memory_order_relaxed);
+}
+
+void LatencyTrace_stop() {
+    LatencyTraceSamplePeriod.store(0, std::memory_order_relaxed);
+}
+
+void LatencyTrace_clear() {
+    LatencyTrace_stop();
+
+    if (State) free(State->events);
+    delete State;
+    State = NULL;
+}
+
+void LatencyTrace_record(const size_t span_id, const uint64_t start, const uint64_t end) {
+    if (!State || span_id >= LATENCY_TRACE_MAX_SPANS) return;
+
+    uint64_t duration = end > start ? end - start : 0;
+
+    __atomic_fetch_add(&State->histograms[span_id][bucket_of(duration)], 1, __ATOMIC_RELAXED);
+
+    unsigned long long max_ticks = __atomic_load_n(&State->max_ticks[span_id], __ATOMIC_RELAXED);
+    while (max_ticks < duration &&
+           !__atomic_compare_exchange_n(&State->max_ticks[span_id], &max_ticks, duration, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+
+    if (!(State->span_mask & ((uint64_t)1 << span_id))) return;
+
+    static std::atomic<uint32_t> thread_count(0);
+    static thread_local uint32_t thread_id = thread_count.fetch_add(1, std::memory_order_relaxed);
+
+    size_t event_id = State->event_count.fetch_add(1, std::memory_order_relaxed);
+    if (event_id >= State->event_capacity) return;
+
+    TraceEvent* event = &State->events[event_id];
+    event->start = start;
+    event->duration = duration;
+    event->span_id = (uint32_t)span_id;
+    event->thread_id = thread_id;
+}
+
+unsigned long long LatencyTrace_count(const size_t span_id) {
+    if (!State || span_id >= LATENCY_TRACE_MAX_SPANS) return 0;
+
+    unsigned long long count = 0;
+    for (size_t bucket = 0; bucket < LATENCY_TRACE_BUCKET_COUNT; ++bucket) {
+        count += __atomic_load_n(&State->histograms[span_id][bucket], __ATOMIC_RELAXED);
+    }
+
+    return count;
+}
+
+double LatencyTrace_quantile(const size_t span_id, const double quantile) {
+    unsigned long long count = LatencyTrace_count(span_id);
+    if (count == 0) return 0;
+
+    double scale = 1.0 / ticks_per_ns();
+    unsigned long long max_ticks = __atomic_load_n(&State->max_ticks[span_id], __ATOMIC_RELAXED);
+
+    if (quantile >= 1) return (double)max_ticks * scale;
+
+    unsigned long long target = (unsigned long long)(quantile * (double)count) + 1;
+    unsigned long long seen = 0;
+
+    for (size_t bucket = 0; bucket < LATENCY_TRACE_BUCKET_COUNT; ++bucket) {
+        seen += __atomic_load_n(&State->histograms[span_id][bucket], __ATOMIC_RELAXED);
+        if (seen >= target) {
+            double value = bucket_value(bucket);
+            return (value < (double)max_ticks ? value : (double)max_ticks) * scale;
+        }
+    }
+
+    return (double)max_ticks * scale;
+}
+
+void LatencyTrace_print(FILE* stream, const char* const* names, const size_t name_count) {
+    _LOG_FAIL_CHECK_(stream, "error", ERROR_REPORTS, return, NULL, 0);
+
+    fprintf(stream, "%-20s %10s %10s %10s %10s %10s %12s\n", "span", "count", "p50, ns", "p90, ns", "p99, ns", "p99.9, ns", "max, ns");
+
+    for (size_t span_id = 0; span_id < name_count && span_id < LATENCY_TRACE_MAX_SPANS; ++span_id) {
+        unsigned long long count = LatencyTrace_count(span_id);
+        if (count == 0) continue;
+
+        fprintf(stream, "%-20s %10llu %10.0lf %10.0lf %10.0lf %10.0lf %12.0lf\n", names[span_id], count,
+                LatencyTrace_quantile(span_id, 0.5), LatencyTrace_quantile(span_id, 0.9),
+                LatencyTrace_quantile(span_id, 0.99), LatencyTrace_quantile(span_id, 0.999),
+                LatencyTrace_quantile(span_id, 1));
+    }
+}
+
+void LatencyTrace_write_chrome(const char* file_name, const char* const* names, const size_t name_count, int* const err_code) {
+    _LOG_FAIL_CHECK_(file_name, "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(State,     "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    FILE* file = fopen(file_name, "w");
+    _LOG_FAIL_CHECK_(file, "error", ERROR_REPORTS, return, err_code, FILE_ERROR);
+
+    double ticks_per_us = ticks_per_ns() * 1e3;
+    size_t event_count = State->event_count.load(std::memory_order_relaxed);
+    size_t written_count = event_count < State->event_capacity ? event_count : State->event_capacity;
+
+    fprintf(file, "{\"displayTimeUnit\": \"ns\", \"otherData\": {\"dropped_events\": %zu}, \"traceEvents\": [\n",
+            event_count - written_count);
+
+    for (size_t event_id = 0; event_id < written_count; ++event_id) {
+        const TraceEvent* event = &State->events[event_id];
+
+        fprintf(file, "%s{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %u, \"ts\": %.3lf, \"dur\": %.3lf}",
+                event_id ? ",\n" : "", event->span_id < name_count ? names[event->span_id] : "unknown", event->thread_id,
+                (double)(event->start - State->start_ticks) / ticks_per_us, (double)event->duration / ticks_per_us);
+    }
+
+    fprintf(file, "\n]}\n");
+
+    _LOG_FAIL_CHECK_(fclose(file) == 0, "error", ERROR_REPORTS, return, err_code, FILE_ERROR);
+}
@@ -0,0 +1,159 @@
+/**
+ * @file latency_trace.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Sampling latency tracer with log-linear histograms and Chrome trace output.
+ * @version 0.1
+ * @date 2022-11-18
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#ifndef LATENCY_TRACE_H
+#define LATENCY_TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <atomic>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define LATENCY_TRACE_TSC
+#else
+#include <time.h>
+#endif
+
+//* Max number of distinct spans (span ids are in [0, LATENCY_TRACE_MAX_SPANS)).
+const size_t LATENCY_TRACE_MAX_SPANS = 32;
+//* Every power of two is split into 2^LATENCY_TRACE_SUB_BITS buckets (values are kept with ~6% precision).
+const int LATENCY_TRACE_SUB_BITS = 4;
+const size_t LATENCY_TRACE_BUCKET_COUNT = (64 - LATENCY_TRACE_SUB_BITS + 1) << LATENCY_TRACE_SUB_BITS;
+//* Default number of events kept for Chrome trace output.
+const size_t LATENCY_TRACE_EVENT_CAPACITY = 1 << 16;
+
+//* Sampling period (0 while tracing is stopped). Defined in latency_trace.cpp.
+extern std::atomic<size_t> LatencyTraceSamplePeriod;
+
+/**
+ * @brief Read timestamp counter (or monotonic nanoseconds where there is none).
+ * 
+ * @return uint64_t
+ */
+static inline uint64_t latency_trace_now() {
+#ifdef LATENCY_TRACE_TSC
+    return __rdtsc();
+#else
+    timespec moment = {};
+    clock_gettime(CLOCK_MONOTONIC, &moment);
+    return (uint64_t)moment.tv_sec * 1000000000ull + (uint64_t)moment.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Decide if the current call should be measured.
+ * 
+ * @note Costs one relaxed load while tracing is stopped.
+ * 
+ * @return true every sample period'th call of the calling thread
+ */
+static inline bool latency_trace_should_sample() {
+    size_t period = LatencyTraceSamplePeriod.load(std::memory_order_relaxed);
+    if (period == 0) return false;
+
+    static thread_local size_t until_sample = 0;
+    if (until_sample > 1) {
+        --until_sample;
+        return false;
+    }
+
+    until_sample = period;
+    return true;
+}
+
+/**
+ * @brief Start collecting latencies (resets everything collected before).
+ * 
+ * @param sample_period measure every sample_period'th call of every thread
+ * @param span_mask spans to record as trace events (bit 1 << span_id for every span)
+ * @param event_capacity max number of trace events to keep
+ * @param err_code variable to use as errno
+ */
+void LatencyTrace_start(const size_t sample_period = 1, const uint64_t span_mask = 0,
+                        const size_t event_capacity = LATENCY_TRACE_EVENT_CAPACITY, int* const err_code = NULL);
+
+/**
+ * @brief Stop collecting latencies (collected data stays available).
+ * 
+ */
+void LatencyTrace_stop();
+
+/**
+ * @brief Stop collecting latencies and free trace events.
+ * 
+ */
+void LatencyTrace_clear();
+
+/**
+ * @brief Add measurement to the span histogram.
+ * 
+ * @param span_id
+ * @param start timestamp of the span start
+ * @param end timestamp of the span end
+ */
+void LatencyTrace_record(const size_t span_id, const uint64_t start, const uint64_t end);
+
+/**
+ * @brief Get number of measurements of the span.
+ * 
+ * @param span_id
+ * @return unsigned long long
+ */
+unsigned long long LatencyTrace_count(const size_t span_id);
+
+/**
+ * @brief Get latency of the span at the specified quantile.
+ * 
+ * @param span_id
+ * @param quantile value in [0, 1]
+ * @return latency in nanoseconds (0 if there are no measurements)
+ */
+double LatencyTrace_quantile(const size_t span_id, const double quantile);
+
+/**
+ * @brief Print latency percentiles of all measured spans.
+ * 
+ * @param stream stream to print to
+ * @param names names of the spans
+ * @param name_count number of names
+ */
+void LatencyTrace_print(FILE* stream, const char* const* names, const size_t name_count);
+
+/**
+ * @brief Write recorded events in Chrome trace-event format (chrome://tracing, Perfetto).
+ * 
+ * @param file_name name of the JSON file to write
+ * @param names names of the spans
+ * @param name_count number of names
+ * @param err_code variable to use as errno
+ */
+void LatencyTrace_write_chrome(const char* file_name, const char* const* names, const size_t name_count,
+                               int* const err_code = NULL);
+
+/**
+ * @brief Scope measuring its lifetime as the span.
+ * 
+ */
+struct LatencyTraceScope {
+    size_t span_id = 0;
+    uint64_t start = 0;     // 0 if the scope is not sampled.
+
+    explicit LatencyTraceScope(const size_t span) : span_id(span), start(latency_trace_should_sample() ? latency_trace_now() : 0) {}
+    ~LatencyTraceScope() { if (start) LatencyTrace_record(span_id, start, latency_trace_now()); }
+
+    LatencyTraceScope(const LatencyTraceScope&) = delete;
+    LatencyTraceScope& operator=(const LatencyTraceScope&) = delete;
+};
+
+#endif
@@ -0,0 +1,149 @@
+#include "page_alloc.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+
+#include "dbg/debug.h"
+
+static const unsigned long NODE_MASK_BITS = PAGE_MAX_NUMA_NODE + 1;
+static const size_t NODE_WORD_BITS = 8 * sizeof(unsigned long);
+
+//* Hugetlb mappings otherwise use the default huge page size of the system, which is not always PAGE_HUGE_SIZE.
+static const int MAP_HUGE_PAGE_SIZE = __builtin_ctzll(PAGE_HUGE_SIZE) << MAP_HUGE_SHIFT;
+
+/**
+ * @brief Round the value up to the multiple of the alignment.
+ * 
+ * @param value
+ * @param alignment power of two
+ * @return size_t
+ */
+static inline size_t round_up(const size_t value, const size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+ * @brief Map anonymous memory starting at the huge page boundary.
+ * 
+ * @param size multiple of PAGE_HUGE_SIZE
+ * @return void* (NULL on failure)
+ */
+static void* map_huge_aligned(const size_t size) {
+    const size_t span = size + PAGE_HUGE_SIZE;
+    char* raw = (char*) mmap(NULL, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) return NULL;
+
+    char* aligned = (char*) round_up((uintptr_t) raw, PAGE_HUGE_SIZE);
+    char* end = aligned + size;
+
+    if (aligned > raw)    munmap(raw, (size_t)(aligned - raw));
+    if (raw + span > end) munmap(end, (size_t)(raw + span - end));
+
+    return aligned;
+}
+
+/**
+ * @brief Set NUMA policy of the untouched mapping.
+ * 
+ * @param buffer
+ * @param mapped_size
+ * @param options
+ */
+static void place_pages(void* const buffer, const size_t mapped_size, const PageAllocOptions* const options) {
+    if (options->placement == NUMA_FIRST_TOUCH) return;
+
+    unsigned long mask[NODE_MASK_BITS / NODE_WORD_BITS] = {};
+    int mode = MPOL_BIND;
+
+    if (options->placement == NUMA_BIND) {
+        const int node = options->node;
+        _LOG_FAIL_CHECK_(0 <= node && node <= PAGE_MAX_NUMA_NODE, "warning", WARNINGS, return, NULL, 0);
+        mask[(size_t) node / NODE_WORD_BITS] |= 1ul << ((size_t) node % NODE_WORD_BITS);
+    } else {
+        mode = MPOL_INTERLEAVE;
+        //* The kernel reads one bit less than maxnode, hence +1 here and in mbind().
+        long allowed = syscall(SYS_get_mempolicy, NULL, mask, NODE_MASK_BITS + 1, NULL, MPOL_F_MEMS_ALLOWED);
+        _LOG_FAIL_CHECK_(allowed == 0, "warning", WARNINGS, return, NULL, 0);
+    }
+
+    long bound = syscall(SYS_mbind, buffer, mapped_size, mode, mask, NODE_MASK_BITS + 1, 0);
+    _LOG_FAIL_CHECK_(bound == 0, "warning", WARNINGS, return, NULL, 0);
+}
+
+void* page_alloc(const size_t size, const PageAllocOptions* const options, size_t* const mapped_size,
+                 PageSize* const used_pages, int* const err_code) {
+    _LOG_FAIL_CHECK_(mapped_size, "error", ERROR_REPORTS, return NULL, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(size > 0,    "error", ERROR_REPORTS, return NULL, err_code, EINVAL);
+
+    static const PageAllocOptions defaults = {};
+    const PageAllocOptions* const used_options = options ? options : &defaults;
+
+    PageSize pages = used_options->pages;
+    if (pages == PAGE_HEAP && used_options->placement != NUMA_FIRST_TOUCH) pages = PAGE_NORMAL;
+
+    *mapped_size = 0;
+
+    if (pages == PAGE_HEAP) {
+        void* buffer = calloc(size, 1);
+        _LOG_FAIL_CHECK_(buffer, "error", ERROR_REPORTS, return NULL, err_code, ENOMEM);
+
+        if (used_pages) *used_pages = PAGE_HEAP;
+        return buffer;
+    }
+
+    //* Refused huge page requests and placements are not errors, so they must not leave errno set.
+    const int saved_errno = errno;
+    void* buffer = NULL;
+
+    if (pages == PAGE_HUGETLB) {
+        *mapped_size = round_up(size, PAGE_HUGE_SIZE);
+        const int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_HUGE_PAGE_SIZE;
+        buffer = mmap(NULL, *mapped_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+
+        if (buffer == MAP_FAILED) {
+            log_printf(STATUS_REPORTS, "status", "No reserved huge pages for %lu bytes, using transparent huge pages.\n",
+                       (unsigned long) size);
+            buffer = NULL;
+            pages = PAGE_TRANSPARENT_HUGE;
+        }
+    }
+
+    if (pages == PAGE_TRANSPARENT_HUGE) {
+        *mapped_size = round_up(size, PAGE_HUGE_SIZE);
+        buffer = map_huge_aligned(*mapped_size);
+
+        if (buffer && madvise(buffer, *mapped_size, MADV_HUGEPAGE) != 0) {
+            log_printf(STATUS_REPORTS, "status", "Transparent huge pages are disabled, using normal pages.\n");
+            pages = PAGE_NORMAL;
+        }
+
+        if (!buffer) pages = PAGE_NORMAL;
+    }
+
+    if (!buffer && pages == PAGE_NORMAL) {
+        *mapped_size = round_up(size, (size_t) sysconf(_SC_PAGESIZE));
+        buffer = mmap(NULL, *mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (buffer == MAP_FAILED) buffer = NULL;
+    }
+
+    _LOG_FAIL_CHECK_(buffer, "error", ERROR_REPORTS, {
+        *mapped_size = 0;
+        return NULL;
+    }, err_code, ENOMEM);
+
+    place_pages(buffer, *mapped_size, used_options);
+    errno = saved_errno;
+
+    if (used_pages) *used_pages = pages;
+    return buffer;
+}
+
+void page_free(void* const buffer, const size_t mapped_size) {
+    if (mapped_size) munmap(buffer, mapped_size);
+    else             free(buffer);
+}
@@ -0,0 +1,84 @@
+/**
+ * @file page_alloc.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Zeroed buffer allocation with control over page size and NUMA node placement.
+ * @version 0.1
+ * @date 2022-11-23
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#ifndef PAGE_ALLOC_H
+#define PAGE_ALLOC_H
+
+#include <stddef.h>
+
+//* Size of huge pages buffers are aligned and rounded to.
+const size_t PAGE_HUGE_SIZE = (size_t)2 << 20;
+
+//* Max NUMA node number supported by placement options.
+const int PAGE_MAX_NUMA_NODE = 1023;
+
+enum PageSize {
+    PAGE_HEAP,                  // Plain calloc() (the default).
+    PAGE_NORMAL,                // Anonymous mapping of base pages.
+    PAGE_TRANSPARENT_HUGE,      // Anonymous mapping aligned to huge pages and advised to use them (MADV_HUGEPAGE).
+    PAGE_HUGETLB,               // Reserved huge pages (MAP_HUGETLB), transparent huge pages if there are none left.
+};
+
+static const char* const PAGE_SIZE_NAMES[] = {
+    "heap",
+    "normal",
+    "thp",
+    "hugetlb",
+};
+
+enum NumaPlacement {
+    NUMA_FIRST_TOUCH,           // Pages go to the node of the thread touching them first (the default).
+    NUMA_BIND,                  // Pages go to the chosen node.
+    NUMA_INTERLEAVE,            // Pages are spread over all allowed nodes.
+};
+
+static const char* const NUMA_PLACEMENT_NAMES[] = {
+    "first-touch",
+    "bind",
+    "interleave",
+};
+
+/**
+ * @brief Way to allocate the buffer.
+ * 
+ * @note Placements other than first touch need a mapping, so they turn PAGE_HEAP into PAGE_NORMAL.
+ */
+struct PageAllocOptions {
+    PageSize pages = PAGE_HEAP;
+    NumaPlacement placement = NUMA_FIRST_TOUCH;
+    int node = 0;               // Node to bind pages to (NUMA_BIND only).
+};
+
+/**
+ * @brief Allocate zeroed buffer.
+ * 
+ * @note Placement is a hint: buffers are still returned if the system refuses it (a warning is logged).
+ *       Pages are not touched, so first-touch buffers end up on the nodes of the threads filling them.
+ * 
+ * @param size size of the buffer in bytes
+ * @param options way to allocate the buffer (NULL for calloc())
+ * @param[out] mapped_size size of the mapping to pass to page_free() (0 for heap buffers)
+ * @param[out] used_pages kind of pages the buffer actually got (may be NULL)
+ * @param err_code variable to use as errno
+ * @return pointer to the buffer (NULL on failure)
+ */
+void* page_alloc(const size_t size, const PageAllocOptions* const options, size_t* const mapped_size,
+                 PageSize* const used_pages = NULL, int* const err_code = NULL);
+
+/**
+ * @brief Free buffer allocated by page_alloc().
+ * 
+ * @param buffer
+ * @param mapped_size mapped size returned by page_alloc()
+ */
+void page_free(void* const buffer, const size_t mapped_size);
+
+#endif
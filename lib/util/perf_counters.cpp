@@ -0,0 +1,129 @@
+#include "perf_counters.h"
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "dbg/debug.h"
+
+/**
+ * @brief Describe the counter for perf_event_open().
+ * 
+ * @param counter
+ * @param[out] attributes
+ */
+static void describe_counter(const PerfCounter counter, perf_event_attr* const attributes) {
+    memset(attributes, 0, sizeof(*attributes));
+    attributes->size = sizeof(*attributes);
+    attributes->disabled = 1;
+    attributes->exclude_kernel = 1;
+    attributes->exclude_hv = 1;
+    attributes->read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    const unsigned long long read_miss = (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+    switch (counter) {
+        case PERF_INSTRUCTIONS:
+            attributes->type = PERF_TYPE_HARDWARE;
+            attributes->config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case PERF_CYCLES:
+            attributes->type = PERF_TYPE_HARDWARE;
+            attributes->config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case PERF_CACHE_MISSES:
+            attributes->type = PERF_TYPE_HARDWARE;
+            attributes->config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        case PERF_L1D_MISSES:
+            attributes->type = PERF_TYPE_HW_CACHE;
+            attributes->config = PERF_COUNT_HW_CACHE_L1D | read_miss;
+            break;
+        case PERF_DTLB_MISSES:
+            attributes->type = PERF_TYPE_HW_CACHE;
+            attributes->config = PERF_COUNT_HW_CACHE_DTLB | read_miss;
+            break;
+        case PERF_COUNTER_COUNT:
+        default: break;
+    }
+}
+
+void PerfCounters_ctor(PerfCounters* const counters, int* const err_code) {
+    _LOG_FAIL_CHECK_(counters, "error", ERROR_REPORTS, return, err_code, EFAULT);
+
+    *counters = PerfCounters {};
+
+    bool any_available = false;
+    int open_error = 0;
+
+    //* Missing counters are reported through err_code only, so failed opens must not leave errno set.
+    const int saved_errno = errno;
+
+    for (int counter = 0; counter < PERF_COUNTER_COUNT; ++counter) {
+        perf_event_attr attributes = {};
+        describe_counter((PerfCounter) counter, &attributes);
+
+        counters->fds[counter] = (int) syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+
+        if (counters->fds[counter] != -1) any_available = true;
+        else                              open_error = errno;
+    }
+
+    errno = saved_errno;
+
+    //* Usual reasons are kernel.perf_event_paranoid > 2, containers and virtual machines without PMU.
+    _LOG_FAIL_CHECK_(any_available, "warning", WARNINGS, return, err_code, open_error);
+}
+
+void PerfCounters_dtor(PerfCounters* const counters) {
+    _LOG_FAIL_CHECK_(counters, "error", ERROR_REPORTS, return, NULL, 0);
+
+    for (int counter = 0; counter < PERF_COUNTER_COUNT; ++counter) {
+        if (counters->fds[counter] != -1) close(counters->fds[counter]);
+        counters->fds[counter] = -1;
+    }
+}
+
+bool PerfCounters_available(const PerfCounters* const counters, const PerfCounter counter) {
+    return counters && counter < PERF_COUNTER_COUNT && counters->fds[counter] != -1;
+}
+
+void PerfCounters_start(PerfCounters* const counters) {
+    _LOG_FAIL_CHECK_(counters, "error", ERROR_REPORTS, return, NULL, 0);
+
+    for (int counter = 0; counter < PERF_COUNTER_COUNT; ++counter) {
+        if (counters->fds[counter] == -1) continue;
+        ioctl(counters->fds[counter], PERF_EVENT_IOC_RESET, 0);
+        ioctl(counters->fds[counter], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+void PerfCounters_stop(PerfCounters* const counters) {
+    _LOG_FAIL_CHECK_(counters, "error", ERROR_REPORTS, return, NULL, 0);
+
+    for (int counter = 0; counter < PERF_COUNTER_COUNT; ++counter) {
+        counters->values[counter] = 0;
+        if (counters->fds[counter] == -1) continue;
+
+        ioctl(counters->fds[counter], PERF_EVENT_IOC_DISABLE, 0);
+
+        //* Value, time enabled and time running.
+        unsigned long long data[3] = {};
+        if (read(counters->fds[counter], data, sizeof(data)) != (ssize_t) sizeof(data) || data[2] == 0) continue;
+
+        counters->values[counter] = data[2] < data[1] ? (unsigned long long)((double)data[0] * (double)data[1] / (double)data[2]) : data[0];
+    }
+}
+
+void PerfCounters_print(const PerfCounters* const counters, FILE* stream, const double operation_count) {
+    _LOG_FAIL_CHECK_(counters, "error", ERROR_REPORTS, return, NULL, 0);
+    _LOG_FAIL_CHECK_(stream,   "error", ERROR_REPORTS, return, NULL, 0);
+
+    for (int counter = 0; counter < PERF_COUNTER_COUNT; ++counter) {
+        if (counters->fds[counter] == -1) fprintf(stream, " %12s", "n/a");
+        else fprintf(stream, " %12.3lf", (double)counters->values[counter] / operation_count);
+    }
+}
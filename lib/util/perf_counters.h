@@ -0,0 +1,97 @@
+/**
+ * @file perf_counters.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Hardware performance counters of the calling thread (Linux perf_event_open).
+ * @version 0.1
+ * @date 2022-11-19
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <stdio.h>
+
+enum PerfCounter {
+    PERF_INSTRUCTIONS,
+    PERF_CYCLES,
+    PERF_CACHE_MISSES,      // Last level cache misses.
+    PERF_L1D_MISSES,        // L1 data cache read misses.
+    PERF_DTLB_MISSES,       // Data TLB read misses.
+
+    PERF_COUNTER_COUNT,
+};
+
+static const char* const PERF_COUNTER_NAMES[] = {
+    "instructions",
+    "cycles",
+    "cache-misses",
+    "L1d-misses",
+    "dTLB-misses",
+};
+
+static_assert(sizeof(PERF_COUNTER_NAMES) / sizeof(*PERF_COUNTER_NAMES) == PERF_COUNTER_COUNT, "Not every perf counter has a name.");
+
+/**
+ * @brief Set of counters measuring the code between PerfCounters_start() and PerfCounters_stop().
+ * 
+ * @note Counters the system does not provide (or does not allow to use) stay unavailable,
+ *       the rest keep working.
+ */
+struct PerfCounters {
+    int fds[PERF_COUNTER_COUNT] = { -1, -1, -1, -1, -1 };
+    unsigned long long values[PERF_COUNTER_COUNT] = {};   // Values measured by the last PerfCounters_stop() call.
+};
+
+/**
+ * @brief Open counters of the calling thread.
+ * 
+ * @param counters
+ * @param err_code variable to use as errno (set only if none of the counters are available)
+ */
+void PerfCounters_ctor(PerfCounters* const counters, int* const err_code = NULL);
+
+/**
+ * @brief Close counters.
+ * 
+ * @param counters
+ */
+void PerfCounters_dtor(PerfCounters* const counters);
+
+/**
+ * @brief Check if the counter can be measured.
+ * 
+ * @param counters
+ * @param counter
+ * @return bool
+ */
+bool PerfCounters_available(const PerfCounters* const counters, const PerfCounter counter);
+
+/**
+ * @brief Reset and start counting.
+ * 
+ * @param counters
+ */
+void PerfCounters_start(PerfCounters* const counters);
+
+/**
+ * @brief Stop counting and read counter values.
+ * 
+ * @note Values are scaled if the kernel had to multiplex counters.
+ * 
+ * @param counters
+ */
+void PerfCounters_stop(PerfCounters* const counters);
+
+/**
+ * @brief Print counter values divided by the number of operations.
+ * 
+ * @param counters
+ * @param stream stream to print to
+ * @param operation_count number to divide values by (1 to print raw values)
+ */
+void PerfCounters_print(const PerfCounters* const counters, FILE* stream, const double operation_count = 1);
+
+#endif
@@ -0,0 +1,404 @@
+#include "strided_scan.h"
+
+#include <string.h>
+
+#include <functional>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define STRIDED_SCAN_X86
+#endif
+
+/**
+ * @brief Read value of the specified type from the strided array.
+ * 
+ * @param base array start
+ * @param stride distance between values in bytes
+ * @param id index of the value
+ * @return value
+ */
+template <typename value_t>
+static inline value_t load_value(const void* base, const size_t stride, const size_t id) {
+    value_t value = {};
+    memcpy(&value, (const char*)base + stride * id, sizeof(value));
+    return value;
+}
+
+template <typename value_t>
+static size_t scalar_find(const void* base, const size_t stride, const size_t from, const size_t count, const value_t value) {
+    for (size_t id = from; id < count; ++id) {
+        if (std::equal_to<value_t>{}(load_value<value_t>(base, stride, id), value)) return id;
+    }
+    return count;
+}
+
+template <typename value_t>
+static size_t scalar_count(const void* base, const size_t stride, const size_t from, const size_t count, const value_t value) {
+    size_t result = 0;
+    for (size_t id = from; id < count; ++id) {
+        if (std::equal_to<value_t>{}(load_value<value_t>(base, stride, id), value)) ++result;
+    }
+    return result;
+}
+
+template <typename value_t, typename sum_t>
+static sum_t scalar_sum(const void* base, const size_t stride, const size_t from, const size_t count, sum_t sum) {
+    for (size_t id = from; id < count; ++id) sum += (sum_t)load_value<value_t>(base, stride, id);
+    return sum;
+}
+
+template <typename value_t>
+static value_t scalar_min(const void* base, const size_t stride, const size_t from, const size_t count, value_t result) {
+    for (size_t id = from; id < count; ++id) {
+        value_t value = load_value<value_t>(base, stride, id);
+        if (value < result) result = value;
+    }
+    return result;
+}
+
+template <typename value_t>
+static value_t scalar_max(const void* base, const size_t stride, const size_t from, const size_t count, value_t result) {
+    for (size_t id = from; id < count; ++id) {
+        value_t value = load_value<value_t>(base, stride, id);
+        if (result < value) result = value;
+    }
+    return result;
+}
+
+#ifdef STRIDED_SCAN_X86
+
+/**
+ * @brief Check if the processor supports AVX2.
+ * 
+ * @note Static initializers may run before the libgcc one that detects the processor, so detection is started here.
+ * 
+ * @return bool
+ */
+static bool detect_avx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+static const bool HAS_AVX2 = detect_avx2();
+
+//* Max stride the 32-bit gather indices can address.
+static const size_t MAX_I32_GATHER_STRIDE = 0x7FFFFFFF / 8;
+
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+AVX2_TARGET static inline __m256i i64_gather_offsets(const size_t stride) {
+    return _mm256_set_epi64x((long long)(3 * stride), (long long)(2 * stride), (long long)stride, 0);
+}
+
+AVX2_TARGET static inline __m256i i32_gather_offsets(const size_t stride) {
+    int step = (int)stride;
+    return _mm256_set_epi32(7 * step, 6 * step, 5 * step, 4 * step, 3 * step, 2 * step, step, 0);
+}
+
+AVX2_TARGET static inline __m256i avx2_gather_i64(const void* base, const size_t stride, const size_t id, const __m256i offsets) {
+    return _mm256_i64gather_epi64((const long long*)((const char*)base + stride * id), offsets, 1);
+}
+
+AVX2_TARGET static inline __m256d avx2_gather_f64(const void* base, const size_t stride, const size_t id, const __m256i offsets) {
+    return _mm256_i64gather_pd((const double*)((const char*)base + stride * id), offsets, 1);
+}
+
+AVX2_TARGET static inline __m256i avx2_gather_i32(const void* base, const size_t stride, const size_t id, const __m256i offsets) {
+    return _mm256_i32gather_epi32((const int*)((const char*)base + stride * id), offsets, 1);
+}
+
+AVX2_TARGET static size_t avx2_find_i64(const void* base, const size_t stride, const size_t count, const int64_t value) {
+    const __m256i offsets = i64_gather_offsets(stride);
+    const __m256i needle = _mm256_set1_epi64x(value);
+
+    size_t id = 0;
+    for (; id + 4 <= count; id += 4) {
+        __m256i equal = _mm256_cmpeq_epi64(avx2_gather_i64(base, stride, id, offsets), needle);
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(equal));
+        if (mask) return id + (size_t)__builtin_ctz((unsigned)mask);
+    }
+    return scalar_find<int64_t>(base, stride, id, count, value);
+}
+
+AVX2_TARGET static size_t avx2_find_f64(const void* base, const size_t stride, const size_t count, const double value) {
+    const __m256i offsets = i64_gather_offsets(stride);
+    const __m256d needle = _mm256_set1_pd(value);
+
+    size_t id = 0;
+    for (; id + 4 <= count; id += 4) {
+        int mask = _mm256_movemask_pd(_mm256_cmp_pd(avx2_gather_f64(base, stride, id, offsets), needle, _CMP_EQ_OQ));
+        if (mask) return id + (size_t)__builtin_ctz((unsigned)mask);
+    }
+    return scalar_find<double>(base, stride, id, count, value);
+}
+
+AVX2_TARGET static size_t avx2_find_i32(const void* base, const size_t stride, const size_t count, const int32_t value) {
+    const __m256i offsets = i32_gather_offsets(stride);
+    const __m256i needle = _mm256_set1_epi32(value);
+
+    size_t id = 0;
+    for (; id + 8 <= count; id += 8) {
+        __m256i equal = _mm256_cmpeq_epi32(avx2_gather_i32(base, stride, id, offsets), needle);
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(equal));
+        if (mask) return id + (size_t)__builtin_ctz((unsigned)mask);
+    }
+    return scalar_find<int32_t>(base, stride, id, count, value);
+}
+
+AVX2_TARGET static size_t avx2_count_i64(const void* base, const size_t stride, const size_t count, const int64_t value) {
+    const __m256i offsets = i64_gather_offsets(stride);
+    const __m256i needle = _mm256_set1_epi64x(value);
+
+    size_t result = 0;
+    size_t id = 0;
+    for (; id + 4 <= count; id += 4) {
+        __m256i equal = _mm256_cmpeq_epi64(avx2_gather_i64(base, stride, id, offsets), needle);
+        result += (size_t)__builtin_popcount((unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(equal)));
+    }
+    return result + scalar_count<int64_t>(base, stride, id, count, value);
+}
+
+AVX2_TARGET static size_t avx2_count_f64(const void* base, const size_t stride, const size_t count, const double value) {
+    const __m256i offsets = i64_gather_offsets(stride);
+    const __m256d needle = _mm256_set1_pd(value);
+
+    size_t result = 0;
+    size_t id = 0;
+    for (; id + 4 <= count; id += 4) {
+        __m256d equal = _mm256_cmp_pd(avx2_gather_f64(base, stride, id, offsets), needle, _CMP_EQ_OQ);
+        result += (size_t)__builtin_popcount((unsigned)_mm256_movemask_pd(equal));
+    }
+    return result + scalar_count<double>(base, stride, id, count, value);
+}
+
+AVX2_TARGET static size_t avx2_count_i32(const void* base, const size_t stride, const size_t count, const int32_t value) {
+    const __m256i offsets = i32_gather_offsets(stride);
+    const __m256i needle = _mm256_set1_epi32(value);
+
+    size_t result = 0;
+    size_t id = 0;
+    for (; id + 8 <= count; id += 8) {
+        __m256i equal = _mm256_cmpeq_epi32(avx2_gather_i32(base, stride, id, offsets), needle);
+        result += (size_t)__builtin_popcount((unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(equal)));
+    }
+    return result + scalar_count<int32_t>(base, stride, id, count, value);
+}
+
+AVX2_TARGET static uint64_t avx2_horizontal_sum(const __m256i accumulator) {
+    uint64_t lanes[4] = {};
+    _mm256_storeu_si256((__m256i*)lanes, accumulator);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+AVX2_TARGET static int64_t avx2_sum_i64(const void* base, const size_t stride, const size_t count) {
+    const __m256i offsets = i64_gather_offsets(stride);
+    __m256i accumulator = _mm256_setzero_si256();
+
+    size_t id = 0;
+    for (; id + 4 <= count; id += 4) {
+        accumulator = _mm256_add_epi64(accumulator, avx2_gather_i64(base, stride, id, offsets));
+    }
+    return (int64_t)scalar_sum<int64_t, uint64_t>(base, stride, id, count, avx2_horizontal_sum(accumulator));
+}
+
+AVX2_TARGET static int64_t avx2_sum_i32(const void* base, const size_t stride, const size_t count) {
+    const __m256i offsets = i32_gather_offsets(stride);
+    __m256i accumulator = _mm256_setzero_si256();
+
+    size_t id = 0;
+    for (; id + 8 <= count; id += 8) {
+        __m256i values = avx2_gather_i32(base, stride, id, offsets);
+        accumulator = _mm256_add_epi64(accumulator, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(values)));
+        accumulator = _mm256_add_epi64(accumulator, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(values, 1)));
+    }
+    return (int64_t)scalar_sum<int32_t, uint64_t>(base, stride, id, count, avx2_horizontal_sum(accumulator));
+}
+
+AVX2_TARGET static double avx2_sum_f64(const void* base, const size_t stride, const size_t count) {
+    const __m256i offsets = i64_gather_offsets(stride);
+    __m256d accumulator = _mm256_setzero_pd();
+
+    size_t id = 0;
+    for (; id + 4 <= count; id += 4) {
+        accumulator = _mm256_add_pd(accumulator, avx2_gather_f64(base, stride, id, offsets));
+    }
+
+    double lanes[4] = {};
+    _mm256_storeu_pd(lanes, accumulator);
+    return scalar_sum<double, double>(base, stride, id, count, (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]));
+}
+
+//* Min and max kernels share the structure, so they are generated by one macro.
+#define AVX2_EXTREMUM_I64_(name, select)                                                        \
+AVX2_TARGET static int64_t avx2_##name##_i64(const void* base, const size_t stride, const size_t count) { \
+    const __m256i offsets = i64_gather_offsets(stride);                                         \
+    __m256i accumulator = _mm256_set1_epi64x(load_value<int64_t>(base, stride, 0));             \
+                                                                                                \
+    size_t id = 0;                                                                              \
+    for (; id + 4 <= count; id += 4) {                                                          \
+        __m256i values = avx2_gather_i64(base, stride, id, offsets);                            \
+        accumulator = _mm256_blendv_epi8(accumulator, values, select);                          \
+    }                                                                                           \
+                                                                                                \
+    int64_t lanes[4] = {};                                                                      \
+    _mm256_storeu_si256((__m256i*)lanes, accumulator);                                          \
+    int64_t result = scalar_##name<int64_t>(lanes, sizeof(*lanes), 1, 4, lanes[0]);             \
+    return scalar_##name<int64_t>(base, stride, id, count, result);                             \
+}
+
+AVX2_EXTREMUM_I64_(min, _mm256_cmpgt_epi64(accumulator, values))
+AVX2_EXTREMUM_I64_(max, _mm256_cmpgt_epi64(values, accumulator))
+
+#define AVX2_EXTREMUM_(name, type, vector_t, width, set1, gather, offsets_for, combine)         \
+AVX2_TARGET static type avx2_##name##_##type(const void* base, const size_t stride, const size_t count) { \
+    const __m256i offsets = offsets_for(stride);                                                \
+    vector_t accumulator = set1(load_value<type>(base, stride, 0));                             \
+                                                                                                \
+    size_t id = 0;                                                                              \
+    for (; id + width <= count; id += width) {                                                  \
+        accumulator = combine(accumulator, gather(base, stride, id, offsets));                  \
+    }                                                                                           \
+                                                                                                \
+    type lanes[width] = {};                                                                     \
+    memcpy(lanes, &accumulator, sizeof(lanes));                                                 \
+    type result = scalar_##name<type>(lanes, sizeof(*lanes), 1, width, lanes[0]);               \
+    return scalar_##name<type>(base, stride, id, count, result);                                \
+}
+
+//* Values replace lanes only when they compare less (greater), so NaNs are skipped as scalar_min() skips them
+//* (_mm256_min_pd() and _mm256_max_pd() would return NaNs of their second operand).
+AVX2_TARGET static inline __m256d avx2_select_less_f64(const __m256d accumulator, const __m256d values) {
+    return _mm256_blendv_pd(accumulator, values, _mm256_cmp_pd(values, accumulator, _CMP_LT_OQ));
+}
+
+AVX2_TARGET static inline __m256d avx2_select_greater_f64(const __m256d accumulator, const __m256d values) {
+    return _mm256_blendv_pd(accumulator, values, _mm256_cmp_pd(values, accumulator, _CMP_GT_OQ));
+}
+
+typedef int32_t i32;
+typedef double f64;
+
+AVX2_EXTREMUM_(min, i32, __m256i, 8, _mm256_set1_epi32, avx2_gather_i32, i32_gather_offsets, _mm256_min_epi32)
+AVX2_EXTREMUM_(max, i32, __m256i, 8, _mm256_set1_epi32, avx2_gather_i32, i32_gather_offsets, _mm256_max_epi32)
+AVX2_EXTREMUM_(min, f64, __m256d, 4, _mm256_set1_pd,    avx2_gather_f64, i64_gather_offsets, avx2_select_less_f64)
+AVX2_EXTREMUM_(max, f64, __m256d, 4, _mm256_set1_pd,    avx2_gather_f64, i64_gather_offsets, avx2_select_greater_f64)
+
+//* Kernels with 64-bit gathers have no stride limit.
+static const size_t ANY_STRIDE = (size_t)-1;
+
+#define USE_AVX2(stride_limit) (HAS_AVX2 && stride <= (stride_limit))
+
+#endif
+
+size_t strided_find_i32(const void* base, size_t stride, size_t count, int32_t value) {
+#ifdef STRIDED_SCAN_X86
+    if (USE_AVX2(MAX_I32_GATHER_STRIDE)) return avx2_find_i32(base, stride, count, value);
+#endif
+    return scalar_find<int32_t>(base, stride, 0, count, value);
+}
+
+size_t strided_find_i64(const void* base, size_t stride, size_t count, int64_t value) {
+#ifdef STRIDED_SCAN_X86
+    if (USE_AVX2(ANY_STRIDE)) return avx2_find_i64(base, stride, count, value);
+#endif
+    return scalar_find<int64_t>(base, stride, 0, count, value);
+}
+
+size_t strided_find_f64(const void* base, size_t stride, size_t count, double value) {
+#ifdef STRIDED_SCAN_X86
+    if (USE_AVX2(ANY_STRIDE)) return avx2_find_f64(base, stride, count, value);
+#endif
+    return scalar_find<double>(base, stride, 0, count, value);
+}
+
+size_t strided_count_i32(const void* base, size_t stride, size_t count, int32_t value) {
+#ifdef STRIDED_SCAN_X86
+    if (USE_AVX2(MAX_I32_GATHER_STRIDE)) return avx2_count_i32(base, stride, count, value);
+#endif
+    return scalar_count<int32_t>(base, stride, 0, count, value);
+}
+
+size_t strided_count_i64(const void* base, size_t stride, size_t count, int64_t value) {
+#ifdef STRIDED_SCAN_X86
+    if (USE_AVX2(ANY_STRIDE)) return avx2_count_i64(base, stride, count, value);
+#endif
+    return scalar_count<int64_t>(base, stride, 0, count, value);
+}
+
+size_t strided_count_f64(const void* base, size_t stride, size_t count, double value) {
+#ifdef STRIDED_SCAN_X86
+    if (USE_AVX2(ANY_STRIDE)) return avx2_count_f64(base, stride, count, value);
+#endif
+    return scalar_count<double>(base, stride, 0, count, value);
+}
+
+int64_t strided_sum_i32(const void* base, size_t stride, size_t count) {
+#ifdef STRIDED_SCAN_X86
+    if (USE_AVX2(MAX_I32_GATHER_STRIDE)) return avx2_sum_i32(base, stride, count);
+#endif
+    return (int64_t)scalar_sum<int32_t, uint64_t>(base, stride, 0, count, 0);
+}
+
+int64_t strided_sum_i64(const void* base, size_t stride, size_t count) {
+#ifdef STRIDED_SCAN_X86
+    if (USE_AVX2(ANY_STRIDE)) return avx2_sum_i64(base, stride, count);
+#endif
+    return (int64_t)scalar_sum<int64_t, uint64_t>(base, stride, 0, count, 0);
+}
+
+double strided_sum_f64(const void* base, size_t stride, size_t count) {
+#ifdef STRIDED_SCAN_X86
+    if (USE_AVX2(ANY_STRIDE)) return avx2_sum_f64(base, stride, count);
+#endif
+    return scalar_sum<double, double>(base, stride, 0, count, 0);
+}
+
+int32_t strided_min_i32(const void* base, size_t stride, size_t count) {
+#ifdef STRIDED_SCAN_X86
+    if (USE_AVX2(MAX_I32_GATHER_STRIDE)) return avx2_min_i32(base, stride, count);
+#endif
+    return scalar_min<int32_t>(base, stride, 1, count, load_value<int32_t>(base, stride, 0));
+}
+
+int64_t strided_min_i64(const void* base, size_t stride, size_t count) {
+#ifdef STRIDED_SCAN_X86
+    if (USE_AVX2(ANY_STRIDE)) return avx2_min_i64(base, stride, count);
+#endif
+    return scalar_min<int64_t>(base, stride, 1, count, load_value<int64_t>(base, stride, 0));
+}
+
+double strided_min_f64(const void* base, size_t stride, size_t count) {
+#ifdef STRIDED_SCAN_X86
+    if (USE_AVX2(ANY_STRIDE)) return avx2_min_f64(base, stride, count);
+#endif
+    return scalar_min<double>(base, stride, 1, count, load_value<double>(base, stride, 0));
+}
+
+int32_t strided_max_i32(const void* base, size_t stride, size_t count) {
+#ifdef STRIDED_SCAN_X86
+    if (USE_AVX2(MAX_I32_GATHER_STRIDE)) return avx2_max_i32(base, stride, count);
+#endif
+    return scalar_max<int32_t>(base, stride, 1, count, load_value<int32_t>(base, stride, 0));
+}
+
+int64_t strided_max_i64(const void* base, size_t stride, size_t count) {
+#ifdef STRIDED_SCAN_X86
+    if (USE_AVX2(ANY_STRIDE)) return avx2_max_i64(base, stride, count);
+#endif
+    return scalar_max<int64_t>(base, stride, 1, count, load_value<int64_t>(base, stride, 0));
+}
+
+double strided_max_f64(const void* base, size_t stride, size_t count) {
+#ifdef STRIDED_SCAN_X86
+    if (USE_AVX2(ANY_STRIDE)) return avx2_max_f64(base, stride, count);
+#endif
+    return scalar_max<double>(base, stride, 1, count, load_value<double>(base, stride, 0));
+}
+
+bool strided_scan_is_vectorized() {
+#ifdef STRIDED_SCAN_X86
+    return HAS_AVX2;
+#else
+    return false;
+#endif
+}
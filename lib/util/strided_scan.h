@@ -0,0 +1,97 @@
+/**
+ * @file strided_scan.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Search and reduction kernels over strided arrays with runtime SIMD dispatch.
+ * @version 0.1
+ * @date 2022-11-07
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#ifndef STRIDED_SCAN_H
+#define STRIDED_SCAN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+//* All kernels read count values of the given type placed stride bytes apart starting at base.
+//* AVX2 gather kernels are used when the processor supports them, scalar loops otherwise.
+//* There are no SSE kernels: SSE has no gathers, so they would do the same scalar loads.
+
+/**
+ * @brief Find index of the first value equal to the specified one.
+ * 
+ * @param base pointer to the first value
+ * @param stride distance between values in bytes
+ * @param count number of values
+ * @param value value to search for
+ * @return index of the value or count if there is none
+ */
+size_t strided_find_i32(const void* base, size_t stride, size_t count, int32_t value);
+size_t strided_find_i64(const void* base, size_t stride, size_t count, int64_t value);
+size_t strided_find_f64(const void* base, size_t stride, size_t count, double value);
+
+/**
+ * @brief Count values equal to the specified one.
+ * 
+ * @param base pointer to the first value
+ * @param stride distance between values in bytes
+ * @param count number of values
+ * @param value value to count
+ * @return size_t
+ */
+size_t strided_count_i32(const void* base, size_t stride, size_t count, int32_t value);
+size_t strided_count_i64(const void* base, size_t stride, size_t count, int64_t value);
+size_t strided_count_f64(const void* base, size_t stride, size_t count, double value);
+
+/**
+ * @brief Calculate sum of the values.
+ * 
+ * @note Integer sums wrap around on overflow.
+ * 
+ * @param base pointer to the first value
+ * @param stride distance between values in bytes
+ * @param count number of values
+ * @return sum of the values
+ */
+int64_t strided_sum_i32(const void* base, size_t stride, size_t count);
+int64_t strided_sum_i64(const void* base, size_t stride, size_t count);
+double  strided_sum_f64(const void* base, size_t stride, size_t count);
+
+/**
+ * @brief Find minimum of the values.
+ * 
+ * @note Values only replace the result when they compare less, so NaNs are skipped unless the first value is one.
+ * 
+ * @param base pointer to the first value
+ * @param stride distance between values in bytes
+ * @param count number of values (should be positive)
+ * @return minimal value
+ */
+int32_t strided_min_i32(const void* base, size_t stride, size_t count);
+int64_t strided_min_i64(const void* base, size_t stride, size_t count);
+double  strided_min_f64(const void* base, size_t stride, size_t count);
+
+/**
+ * @brief Find maximum of the values.
+ * 
+ * @note Values only replace the result when they compare greater, so NaNs are skipped unless the first value is one.
+ * 
+ * @param base pointer to the first value
+ * @param stride distance between values in bytes
+ * @param count number of values (should be positive)
+ * @return maximal value
+ */
+int32_t strided_max_i32(const void* base, size_t stride, size_t count);
+int64_t strided_max_i64(const void* base, size_t stride, size_t count);
+double  strided_max_f64(const void* base, size_t stride, size_t count);
+
+/**
+ * @brief Check if SIMD kernels are used on this processor.
+ * 
+ * @return bool
+ */
+bool strided_scan_is_vectorized();
+
+#endif
@@ -0,0 +1,111 @@
+#include "thread_pool.h"
+
+#include <errno.h>
+#include <new>
+
+#include "dbg/debug.h"
+
+/**
+ * @brief Grab and execute tasks of the current batch until none are left.
+ * 
+ * @param pool
+ */
+static void execute_tasks(ThreadPool* const pool) {
+    for (size_t task_id = pool->next_task.fetch_add(1); task_id < pool->task_count;
+                task_id = pool->next_task.fetch_add(1)) {
+        pool->task(task_id, pool->args);
+    }
+}
+
+/**
+ * @brief Worker thread loop.
+ * 
+ * @param pool
+ */
+static void worker_loop(ThreadPool* const pool) {
+    unsigned long long seen_generation = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> guard(pool->lock);
+            pool->job_posted.wait(guard, [pool, seen_generation]() {
+                return pool->terminating || pool->generation != seen_generation;
+            });
+            if (pool->terminating) return;
+            seen_generation = pool->generation;
+        }
+
+        execute_tasks(pool);
+
+        std::unique_lock<std::mutex> guard(pool->lock);
+        if (--pool->busy_workers == 0) pool->job_done.notify_one();
+    }
+}
+
+void ThreadPool_ctor(ThreadPool* const pool, size_t thread_count, int* const err_code) {
+    _LOG_FAIL_CHECK_(pool, "error", ERROR_REPORTS, return, err_code, EFAULT);
+    _LOG_FAIL_CHECK_(thread_count > 0, "error", ERROR_REPORTS, return, err_code, EINVAL);
+
+    pool->worker_count = 0;
+    pool->workers = NULL;
+
+    if (thread_count == 1) return;
+
+    pool->workers = new(std::nothrow) std::thread[thread_count - 1];
+    _LOG_FAIL_CHECK_(pool->workers, "error", ERROR_REPORTS, return, err_code, ENOMEM);
+
+    for (size_t id = 0; id < thread_count - 1; ++id) {
+        pool->workers[id] = std::thread(worker_loop, pool);
+    }
+
+    pool->worker_count = thread_count - 1;
+}
+
+void ThreadPool_dtor(ThreadPool* const pool) {
+    _LOG_FAIL_CHECK_(pool, "error", ERROR_REPORTS, return, NULL, 0);
+
+    {
+        std::unique_lock<std::mutex> guard(pool->lock);
+        pool->terminating = true;
+    }
+    pool->job_posted.notify_all();
+
+    for (size_t id = 0; id < pool->worker_count; ++id) {
+        pool->workers[id].join();
+    }
+
+    delete[] pool->workers;
+    pool->workers = NULL;
+    pool->worker_count = 0;
+}
+
+void ThreadPool_dtor_void(void* pool) { ThreadPool_dtor((ThreadPool*) pool); }
+
+size_t ThreadPool_size(const ThreadPool* const pool) {
+    return pool ? pool->worker_count + 1 : 1;
+}
+
+void ThreadPool_run(ThreadPool* const pool, thread_task_t* task, void* args, size_t task_count) {
+    _LOG_FAIL_CHECK_(task, "error", ERROR_REPORTS, return, NULL, 0);
+
+    if (!pool || pool->worker_count == 0 || task_count <= 1) {
+        for (size_t task_id = 0; task_id < task_count; ++task_id) task(task_id, args);
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> guard(pool->lock);
+        pool->task = task;
+        pool->args = args;
+        pool->task_count = task_count;
+        pool->next_task = 0;
+        pool->busy_workers = pool->worker_count;
+        ++pool->generation;
+    }
+    pool->job_posted.notify_all();
+
+    execute_tasks(pool);
+
+    std::unique_lock<std::mutex> guard(pool->lock);
+    pool->job_done.wait(guard, [pool]() { return pool->busy_workers == 0; });
+}
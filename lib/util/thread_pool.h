@@ -0,0 +1,90 @@
+/**
+ * @file thread_pool.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Minimal fork-join thread pool.
+ * @version 0.1
+ * @date 2022-11-05
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stddef.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+//* Task function, called once for every task index in [0, task_count).
+typedef void thread_task_t(size_t task_id, void* args);
+
+/**
+ * @brief Pool of worker threads executing one batch of tasks at a time.
+ * 
+ * @note The thread calling ThreadPool_run() participates in the work,
+ *       so a pool of N threads owns N - 1 workers.
+ */
+struct ThreadPool {
+    std::thread* workers = NULL;
+    size_t worker_count = 0;
+
+    std::mutex lock = {};
+    std::condition_variable job_posted = {};
+    std::condition_variable job_done = {};
+
+    thread_task_t* task = NULL;
+    void* args = NULL;
+    size_t task_count = 0;
+    std::atomic<size_t> next_task = 0;
+
+    size_t busy_workers = 0;
+    unsigned long long generation = 0;
+    bool terminating = false;
+};
+
+/**
+ * @brief Start pool threads.
+ * 
+ * @param pool
+ * @param thread_count total number of threads to use (including the calling one)
+ * @param err_code variable to use as errno
+ */
+void ThreadPool_ctor(ThreadPool* const pool, size_t thread_count, int* const err_code = NULL);
+
+/**
+ * @brief Stop and join pool threads.
+ * 
+ * @param pool
+ */
+void ThreadPool_dtor(ThreadPool* const pool);
+
+/**
+ * @brief Dtor-capable destructor function.
+ * 
+ * @param pool pool to destroy
+ */
+void ThreadPool_dtor_void(void* pool);
+
+/**
+ * @brief Get number of threads the pool runs tasks on.
+ * 
+ * @param pool pool to check (NULL is treated as a single-threaded pool)
+ * @return size_t
+ */
+size_t ThreadPool_size(const ThreadPool* const pool);
+
+/**
+ * @brief Execute task for every index in [0, task_count) and wait for completion.
+ * 
+ * @param pool pool to run tasks on (NULL runs everything on the calling thread)
+ * @param task task function
+ * @param args argument passed to every task call
+ * @param task_count number of tasks
+ */
+void ThreadPool_run(ThreadPool* const pool, thread_task_t* task, void* args, size_t task_count);
+
+#endif
@@ -0,0 +1,1807 @@
+/**
+ * @file bench.cpp
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Listworks library benchmarks.
+ * @version 0.1
+ * @date 2022-11-05
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+
+#include "lib/util/dbg/debug.h"
+#include "lib/util/argparser.h"
+#include "lib/util/thread_pool.h"
+#include "lib/util/perf_counters.h"
+#include "lib/alloc_tracker/alloc_tracker.h"
+#include "utils/main_utils.h"
+#include "bench_float.h"
+
+typedef long long list_elem_t;
+const list_elem_t LIST_ELEM_POISON = (list_elem_t)0xC0FEDEADBEEFFACE;
+#define LIST_TRACE
+#include "lib/listworks.h"
+#include "lib/liststream.h"
+#include "lib/listjournal.h"
+#include "lib/listchunked.h"
+#include "lib/listxor.h"
+#include "lib/listcache.h"
+#include "lib/liststatic.h"
+
+//* Set by failed correctness checks, makes the benchmark exit with EXIT_FAILURE.
+static bool CHECKS_FAILED = false;
+
+/**
+ * @brief Report the result of a correctness check of the benchmark.
+ * 
+ * @param passed
+ * @param message what is printed if the check failed
+ */
+static void bench_check(const bool passed, const char* message) {
+    if (passed) return;
+
+    printf("%s\n", message);
+    CHECKS_FAILED = true;
+}
+
+/**
+ * @brief Check if the lists hold equal elements in the same order.
+ * 
+ * @note Cells are read directly, as List_get() with full checks would make the walk quadratic.
+ * 
+ * @param first
+ * @param second
+ * @return bool
+ */
+static bool same_order(const List* const first, const List* const second) {
+    if (first->size != second->size) return false;
+
+    list_position_t _ListCell::* first_forward = _List_forward(first);
+    list_position_t _ListCell::* second_forward = _List_forward(second);
+
+    list_position_t first_cell = first->buffer->*first_forward;
+    list_position_t second_cell = second->buffer->*second_forward;
+
+    for (; first_cell != 0 && second_cell != 0; first_cell = first->buffer[first_cell].*first_forward,
+                                                 second_cell = second->buffer[second_cell].*second_forward) {
+        if (_List_elem(first, first_cell) != _List_elem(second, second_cell)) return false;
+    }
+
+    return first_cell == 0 && second_cell == 0;
+}
+
+/**
+ * @brief Check if the list holds exactly the elements of the array in their order.
+ * 
+ * @param list
+ * @param elems
+ * @param count number of elements in the array
+ * @return bool
+ */
+static bool holds_in_order(const List* const list, const list_elem_t* const elems, const size_t count) {
+    if (list->size != count) return false;
+
+    list_position_t _ListCell::* forward = _List_forward(list);
+
+    size_t id = 0;
+    for (list_position_t cell = list->buffer->*forward; cell != 0; cell = list->buffer[cell].*forward, ++id) {
+        if (id == count || _List_elem(list, cell) != elems[id]) return false;
+    }
+
+    return id == count;
+}
+
+//* Size of the static list built at compile time (every operation checks the whole list, so it is kept small).
+const size_t STATIC_TABLE_SIZE = 256;
+
+/**
+ * @brief Build the table of squares in the order that leaves the list non-linearized, then linearize it.
+ * 
+ * @return StaticList
+ */
+static constexpr StaticList<STATIC_TABLE_SIZE + 1> make_static_table() {
+    StaticList<STATIC_TABLE_SIZE + 1> table = {};
+    list_position_t middle = 0;
+
+    for (size_t id = STATIC_TABLE_SIZE / 2; id < STATIC_TABLE_SIZE; ++id) {
+        list_position_t cell = List_insert(&table, (list_elem_t)(id * id), table.cells->prev);
+        if (id == STATIC_TABLE_SIZE / 2) middle = cell;
+    }
+
+    for (size_t id = 0; id < STATIC_TABLE_SIZE / 2; ++id) List_insert(&table, (list_elem_t)(id * id), table.cells[middle].prev);
+
+    List_linearize(&table);
+
+    return table;
+}
+
+//* Lives in read-only data, nothing is done at runtime to build it.
+static constexpr StaticList<STATIC_TABLE_SIZE + 1> STATIC_TABLE = make_static_table();
+
+static_assert(List_status(&STATIC_TABLE) == 0 && STATIC_TABLE.linearized, "Static table is broken.");
+static_assert(List_get(&STATIC_TABLE, List_find_position(&STATIC_TABLE, 17)) == 17 * 17, "Static lookup is wrong.");
+static_assert(List_get(&STATIC_TABLE, List_find_position(&STATIC_TABLE, -1)) ==
+              (list_elem_t)((STATIC_TABLE_SIZE - 1) * (STATIC_TABLE_SIZE - 1)), "Static lookup from the tail is wrong.");
+
+/**
+ * @brief Run operations of all kinds on a small static list and check their results the way List gives them.
+ * 
+ * @return true if every check passed
+ */
+static constexpr bool check_static_list() {
+    StaticList<8> list = {};
+
+    //* Linearized lists take the ends of the lazy region: tail insertions go forward, head ones wrap to the last cell.
+    list_position_t two = List_insert(&list, 2, 0);
+    list_position_t three = List_insert(&list, 3, two);
+    list_position_t one = List_insert(&list, 1, 0);
+    if (two != 1 || three != 2 || one != 7 || !list.linearized) return false;
+    if (List_find_position(&list, 0) != one || List_find_position(&list, -1) != three) return false;
+
+    //* Insertions into the middle break linearization, popped cells are reused first.
+    list_position_t middle = List_insert(&list, 5, two);
+    if (middle != 3 || list.linearized || List_find_position(&list, 2) != middle) return false;
+
+    List_pop(&list, two);
+    if (List_insert(&list, 4, one) != two || List_get(&list, List_find_position(&list, 1)) != 4) return false;
+
+    List_linearize(&list);
+    if (!list.linearized || List_find_position(&list, 0) != 1 || List_find_position(&list, -1) != 4) return false;
+
+    const list_elem_t expected[] = { 1, 4, 5, 3 };
+    for (int index = 0; index < 4; ++index) {
+        if (List_get(&list, List_find_position(&list, index)) != expected[index]) return false;
+    }
+
+    //* Popping the ends keeps linearized lists linearized.
+    List_pop(&list, List_find_position(&list, 0));
+    List_pop(&list, List_find_position(&list, -1));
+
+    return list.linearized && list.size == 2 && List_status(&list) == 0 && List_get(&list, List_find_position(&list, 0)) == 4;
+}
+
+static_assert(check_static_list(), "Static list operations are wrong.");
+
+/**
+ * @brief Get monotonic time in seconds.
+ * 
+ * @return double
+ */
+static double get_time() {
+    timespec moment = {};
+    clock_gettime(CLOCK_MONOTONIC, &moment);
+    return (double)moment.tv_sec + (double)moment.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Fill empty list with elements 0..size-1 placed in random buffer cells.
+ * 
+ * @note Links cells directly instead of calling List_insert(),
+ *       as per-call validation would make setup quadratic.
+ * 
+ * @param list list with capacity of at least size + 2
+ * @param size number of elements to add
+ */
+static void fill_shuffled(List* const list, const size_t size) {
+    size_t* slots = (size_t*) calloc(list->capacity - 1, sizeof(*slots));
+    for (size_t id = 0; id < list->capacity - 1; ++id) slots[id] = id + 1;
+
+    srand(42);
+    for (size_t id = list->capacity - 2; id > 0; --id) {
+        size_t other = (size_t)rand() % (id + 1);
+        size_t temp = slots[id];
+        slots[id] = slots[other];
+        slots[other] = temp;
+    }
+
+    _ListCell* buffer = list->buffer;
+
+    list_position_t cell = 0;
+    for (size_t id = 0; id < size; ++id) {
+        list_position_t next = slots[id];
+        buffer[next].content = (list_elem_t)id;
+        buffer[cell].next = next;
+        buffer[next].prev = cell;
+        cell = next;
+    }
+    buffer[cell].next = 0;
+    buffer->prev = cell;
+
+    list_position_t empty = slots[size];
+    list->first_empty = empty;
+    buffer[empty].content = LIST_ELEM_POISON;
+    for (size_t id = size + 1; id < list->capacity - 1; ++id) {
+        buffer[slots[id]].content = LIST_ELEM_POISON;
+        buffer[empty].next = slots[id];
+        buffer[slots[id]].prev = empty;
+        empty = slots[id];
+    }
+    buffer[empty].next = list->first_empty;
+    buffer[list->first_empty].prev = empty;
+
+    list->lazy_count = 0;
+    list->size = size;
+    list->linearized = false;
+    list->reversed = false;
+    _List_checksum_rebuild(list);
+
+    free(slots);
+}
+
+static list_elem_t sum_reducer(const list_elem_t left, const list_elem_t right, void* ctx) {
+    SILENCE_UNUSED(ctx);
+    return left + right;
+}
+
+/**
+ * @brief Measure List_linearize_parallel() and List_reduce() scaling over thread count.
+ * 
+ * @param size number of list elements
+ * @param max_threads maximum number of threads to try
+ */
+static void bench_parallel(const size_t size, const size_t max_threads) {
+    printf("\n[parallel] %lu elements, shuffled buffer\n", (unsigned long) size);
+    printf("%8s %16s %16s %16s\n", "threads", "linearize, ms", "reduce (frag), ms", "reduce (lin), ms");
+
+    List list = {};
+    List_ctor(&list, size + size / 4 + 2);
+
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        ThreadPool pool = {};
+        ThreadPool_ctor(&pool, threads);
+
+        fill_shuffled(&list, size);
+
+        double start = get_time();
+        list_elem_t frag_sum = List_reduce(&list, sum_reducer, 0, NULL, &pool);
+        double frag_reduce_time = get_time() - start;
+
+        start = get_time();
+        if (threads == 1) List_linearize(&list);
+        else              List_linearize_parallel(&list, &pool);
+        double linearize_time = get_time() - start;
+
+        start = get_time();
+        list_elem_t lin_sum = List_reduce(&list, sum_reducer, 0, NULL, &pool);
+        double lin_reduce_time = get_time() - start;
+
+        if (frag_sum != lin_sum) printf("Sum mismatch: %lld vs %lld!\n", frag_sum, lin_sum);
+
+        printf("%8lu %16.2lf %16.2lf %16.2lf\n", (unsigned long) threads,
+               linearize_time * 1e3, frag_reduce_time * 1e3, lin_reduce_time * 1e3);
+
+        ThreadPool_dtor(&pool);
+    }
+
+    List_dtor(&list);
+}
+
+/**
+ * @brief Check if the values are equal or both are NaN.
+ * 
+ * @param first
+ * @param second
+ * @return bool
+ */
+static bool same_f64(const double first, const double second) {
+    return (isnan(first) && isnan(second)) || first == second;
+}
+
+/**
+ * @brief Compare f64 minimum and maximum kernels with scalar loops on values with NaNs.
+ * 
+ * @return true if the results are the same
+ */
+static bool check_f64_extremums() {
+    const size_t count = 37, stride = 3;
+    double values[count * stride] = {};
+
+    //* Pairs of NaN positions: the first value, the rest of the first vector and the middle of the array.
+    const size_t nan_positions[][2] = {{0, 0}, {0, 18}, {1, 2}, {3, 18}, {18, 19}, {35, 36}};
+
+    for (const size_t* nans : nan_positions) {
+        for (size_t id = 0; id < count; ++id) values[id * stride] = (double)(id * 7919 % 101) - 50.5;
+        values[nans[0] * stride] = values[nans[1] * stride] = NAN;
+
+        double min = values[0], max = values[0];
+        for (size_t id = 1; id < count; ++id) {
+            if (values[id * stride] < min) min = values[id * stride];
+            if (max < values[id * stride]) max = values[id * stride];
+        }
+
+        if (!same_f64(min, strided_min_f64(values, stride * sizeof(double), count)) ||
+            !same_f64(max, strided_max_f64(values, stride * sizeof(double), count))) return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Compare strided SIMD kernels and list scans with plain scalar loops.
+ * 
+ * @param size number of list elements
+ */
+static void bench_scan(const size_t size) {
+    printf("\n[scan] %lu elements, stride %lu bytes, %s kernels\n", (unsigned long) size,
+           (unsigned long) sizeof(_ListCell), strided_scan_is_vectorized() ? "AVX2" : "scalar");
+    printf("%10s %16s %16s %16s\n", "operation", "scalar loop, ms", "kernel, ms", "List_*, ms");
+
+    List list = {};
+    List_ctor(&list, size + size / 4 + 2);
+    fill_shuffled(&list, size);
+    List_linearize(&list);
+
+    const _ListCell* cells = list.buffer + 1;
+    const list_elem_t needle = (list_elem_t)(size - 1);
+
+    double start = get_time();
+    size_t scalar_index = size;
+    for (size_t id = 0; id < size; ++id) if (cells[id].content == needle) { scalar_index = id; break; }
+    double scalar_time = get_time() - start;
+
+    start = get_time();
+    size_t kernel_index = strided_find_i64(&cells->content, sizeof(*cells), size, needle);
+    double kernel_time = get_time() - start;
+
+    start = get_time();
+    list_position_t list_position = List_find_value(&list, needle);
+    double list_time = get_time() - start;
+
+    bench_check(scalar_index == kernel_index && list_position == kernel_index + 1, "Find mismatch!");
+    printf("%10s %16.2lf %16.2lf %16.2lf\n", "find", scalar_time * 1e3, kernel_time * 1e3, list_time * 1e3);
+
+    start = get_time();
+    list_elem_t scalar_sum = 0;
+    for (size_t id = 0; id < size; ++id) scalar_sum += cells[id].content;
+    scalar_time = get_time() - start;
+
+    start = get_time();
+    list_elem_t kernel_sum = strided_sum_i64(&cells->content, sizeof(*cells), size);
+    kernel_time = get_time() - start;
+
+    start = get_time();
+    list_elem_t list_sum = List_sum(&list);
+    list_time = get_time() - start;
+
+    bench_check(scalar_sum == kernel_sum && scalar_sum == list_sum, "Sum mismatch!");
+    printf("%10s %16.2lf %16.2lf %16.2lf\n", "sum", scalar_time * 1e3, kernel_time * 1e3, list_time * 1e3);
+
+    start = get_time();
+    list_elem_t scalar_max = cells->content;
+    for (size_t id = 1; id < size; ++id) if (scalar_max < cells[id].content) scalar_max = cells[id].content;
+    scalar_time = get_time() - start;
+
+    start = get_time();
+    list_elem_t kernel_max = strided_max_i64(&cells->content, sizeof(*cells), size);
+    kernel_time = get_time() - start;
+
+    start = get_time();
+    list_elem_t list_max = List_max(&list);
+    list_time = get_time() - start;
+
+    bench_check(scalar_max == kernel_max && scalar_max == list_max, "Max mismatch!");
+    bench_check(check_f64_extremums(), "NaN min/max mismatch!");
+    printf("%10s %16.2lf %16.2lf %16.2lf\n", "max", scalar_time * 1e3, kernel_time * 1e3, list_time * 1e3);
+
+    List_dtor(&list);
+}
+
+/**
+ * @brief Get resident set size of the process.
+ * 
+ * @return size in megabytes (0 if it is unknown)
+ */
+static double get_resident_mb() {
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (!statm) return 0;
+
+    unsigned long total_pages = 0, resident_pages = 0;
+    int read = fscanf(statm, "%lu %lu", &total_pages, &resident_pages);
+    fclose(statm);
+
+    return read == 2 ? (double)resident_pages * (double)sysconf(_SC_PAGESIZE) / (1 << 20) : 0;
+}
+
+/**
+ * @brief Measure construction of a big list and memory it commits while only a few elements are used.
+ * 
+ * @param capacity list capacity
+ */
+static void bench_lazy(const size_t capacity) {
+    const size_t used = 4096;
+
+    printf("\n[lazy] capacity %lu (%.1lf MB of cells), %lu elements used\n", (unsigned long) capacity,
+           (double)(capacity * sizeof(_ListCell)) / (1 << 20), (unsigned long) used);
+
+    double resident_before = get_resident_mb();
+
+    List list = {};
+
+    double start = get_time();
+    List_ctor(&list, capacity);
+    double ctor_time = get_time() - start;
+
+    double resident_ctor = get_resident_mb();
+
+    list_position_t position = 0;
+    start = get_time();
+    for (size_t id = 0; id < used; ++id) position = List_insert(&list, (list_elem_t)id, position);
+    double insert_time = get_time() - start;
+
+    double resident_used = get_resident_mb();
+
+    if (List_sum(&list) != (list_elem_t)used * (list_elem_t)(used - 1) / 2) printf("Sum mismatch!\n");
+
+    List_dtor(&list);
+
+    printf("%24s %10.3lf ms\n", "List_ctor", ctor_time * 1e3);
+    printf("%24s %10.3lf us\n", "List_insert (per call)", insert_time * 1e6 / (double)used);
+    printf("%24s %10.1lf MB\n", "committed after ctor", resident_ctor - resident_before);
+    printf("%24s %10.1lf MB\n", "committed after inserts", resident_used - resident_before);
+}
+
+/**
+ * @brief Compare link walks with occupancy bitmap sweeps on the scattered list.
+ * 
+ * @param size number of list elements
+ */
+static void bench_occupancy(const size_t size) {
+    printf("\n[occupancy] %lu elements in random cells, %lu cells\n", (unsigned long) size,
+           (unsigned long)(size + size / 4 + 2));
+    printf("%12s %16s %16s\n", "operation", "link walk, ms", "bitmap, ms");
+
+    List list = {};
+    List_ctor(&list, size + size / 4 + 2);
+    fill_shuffled(&list, size);
+
+    double walk_times[4] = {};
+    double sweep_times[4] = {};
+    list_elem_t results[2][3] = {};
+
+    for (int tracked = 0; tracked < 2; ++tracked) {
+        double* times = tracked ? sweep_times : walk_times;
+        List_track_occupancy(&list, tracked);
+
+        double start = get_time();
+        results[tracked][0] = (list_elem_t) List_count(&list, (list_elem_t)(size / 2));
+        times[0] = get_time() - start;
+
+        start = get_time();
+        results[tracked][1] = List_sum(&list);
+        times[1] = get_time() - start;
+
+        start = get_time();
+        results[tracked][2] = List_min(&list);
+        times[2] = get_time() - start;
+
+        start = get_time();
+        if (List_status(&list)) printf("Status check failed!\n");
+        times[3] = get_time() - start;
+    }
+
+    if (memcmp(results[0], results[1], sizeof(results[0]))) printf("Result mismatch!\n");
+
+    const char* names[] = {"count", "sum", "min", "status"};
+    for (int id = 0; id < 4; ++id)
+        printf("%12s %16.2lf %16.2lf\n", names[id], walk_times[id] * 1e3, sweep_times[id] * 1e3);
+
+    List_dtor(&list);
+}
+
+/**
+ * @brief Compare startup time of rebuilding the list and mapping its saved copy.
+ * 
+ * @param size number of list elements
+ */
+static void bench_startup(const size_t size) {
+    const char* file_name = "bench_list.bin";
+
+    printf("\n[startup] %lu elements, file %s\n", (unsigned long) size, file_name);
+
+    List list = {};
+
+    double start = get_time();
+    List_ctor(&list, size + size / 4 + 2);
+    fill_shuffled(&list, size);
+    double build_time = get_time() - start;
+
+    start = get_time();
+    List_save(&list, file_name);
+    double save_time = get_time() - start;
+
+    list_elem_t expected_sum = List_sum(&list);
+    List_dtor(&list);
+
+    start = get_time();
+    list_report_t report = List_open_mapped(&list, file_name);
+    double open_time = get_time() - start;
+
+    start = get_time();
+    list_elem_t mapped_sum = List_sum(&list);
+    double first_walk_time = get_time() - start;
+
+    List_dtor(&list);
+
+    start = get_time();
+    report |= List_open_mapped(&list, file_name, true);
+    double verified_open_time = get_time() - start;
+
+    List_dtor(&list);
+    unlink(file_name);
+
+    if (report || expected_sum != mapped_sum) printf("Mapped list mismatch (report %d)!\n", report);
+
+    printf("%24s %10.3lf ms\n", "build (ctor + fill)", build_time * 1e3);
+    printf("%24s %10.3lf ms\n", "List_save", save_time * 1e3);
+    printf("%24s %10.3lf ms\n", "List_open_mapped", open_time * 1e3);
+    printf("%24s %10.3lf ms\n", "first walk after open", first_walk_time * 1e3);
+    printf("%24s %10.3lf ms\n", "open with verification", verified_open_time * 1e3);
+}
+
+/**
+ * @brief Measure stream export and import throughput.
+ * 
+ * @param size number of list elements
+ */
+static void bench_stream(const size_t size) {
+    const char* file_name = "bench_stream.bin";
+    const double gigabytes = (double)(size * sizeof(list_elem_t)) / 1e9;
+
+    printf("\n[stream] %lu elements, file %s\n", (unsigned long) size, file_name);
+    printf("%28s %12s %12s %10s\n", "mode", "export, GB/s", "import, GB/s", "bytes");
+
+    List list = {};
+    List_ctor(&list, size + size / 4 + 2);
+    fill_shuffled(&list, size);
+
+    static const char* const MODE_NAMES[] = {"copy, fragmented", "copy, linearized", "zero-copy, linearized"};
+
+    for (int mode = 0; mode < 3; ++mode) {
+        if (mode == 1) List_linearize(&list);
+
+        int fd = open(file_name, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+        double start = get_time();
+        List_export(&list, fd, mode == 2);
+        double export_time = get_time() - start;
+
+        off_t stream_size = lseek(fd, 0, SEEK_CUR);
+        lseek(fd, 0, SEEK_SET);
+
+        List copy = {};
+        start = get_time();
+        List_import(&copy, fd);
+        double import_time = get_time() - start;
+
+        close(fd);
+
+        bench_check(copy.buffer && same_order(&copy, &list), "Imported list mismatch!");
+        if (copy.buffer) List_dtor(&copy);
+
+        printf("%28s %12.2lf %12.2lf %10lld\n", MODE_NAMES[mode],
+               gigabytes / export_time, gigabytes / import_time, (long long) stream_size);
+    }
+
+    unlink(file_name);
+    List_dtor(&list);
+}
+
+/**
+ * @brief Run a queue-like sequence of insertions and removals on the list.
+ * 
+ * @param list list with capacity of at least 2 * depth + 2
+ * @param op_count number of operations to perform
+ * @param depth number of elements to keep in the list
+ */
+static void run_queue_ops(List* const list, const size_t op_count, const size_t depth) {
+    for (size_t op = 0; op < op_count; ++op) {
+        if (list->size < depth || op % 2 == 0) List_insert(list, (list_elem_t)op, list->buffer->prev);
+        else                                   List_pop(list, list->buffer->next);
+    }
+}
+
+/**
+ * @brief Insert elements at random indices of the list.
+ * 
+ * @param list list with capacity of at least size + insert_count + 2
+ * @param insert_count number of elements to insert
+ */
+template <typename list_t>
+static void run_middle_inserts(list_t* const list, const size_t insert_count) {
+    srand(13);
+    for (size_t insert = 0; insert < insert_count; ++insert) {
+        List_insert(list, (list_elem_t)insert, List_find_position(list, rand() % (int)list->size));
+    }
+}
+
+/**
+ * @brief Compare chunk list with linked lists on traversal, middle insertions and memory use.
+ * 
+ * @param size number of list elements
+ */
+static void bench_chunked(const size_t size) {
+    const size_t small_size = size / 64;
+    const size_t insert_count = 1024;
+
+    printf("\n[chunked] %lu elements (%lu slots per chunk), %lu random insertions into %lu elements\n",
+           (unsigned long) size, (unsigned long) LIST_CHUNK_SLOTS, (unsigned long) insert_count, (unsigned long) small_size);
+    printf("%20s %14s %14s %16s %16s\n", "storage", "append, ns", "reduce, ns", "bytes per elem", "insert, us");
+
+    List list = {};
+    List_ctor(&list, size + size / 4 + 2);
+    fill_shuffled(&list, size);
+
+    double start = get_time();
+    list_elem_t frag_sum = List_reduce(&list, sum_reducer, 0, NULL);
+    double frag_reduce_time = get_time() - start;
+
+    List_linearize(&list);
+
+    start = get_time();
+    list_elem_t lin_sum = List_reduce(&list, sum_reducer, 0, NULL);
+    double lin_reduce_time = get_time() - start;
+
+    double list_memory = (double)(list.capacity * sizeof(_ListCell)) / (double)size;
+    List_dtor(&list);
+
+    ChunkList chunked = {};
+    List_ctor(&chunked, size);
+
+    start = get_time();
+    list_position_t tail = 0;
+    for (size_t id = 0; id < size; ++id) tail = List_insert(&chunked, (list_elem_t)id, tail);
+    double append_time = get_time() - start;
+
+    start = get_time();
+    list_elem_t chunked_sum = List_reduce(&chunked, sum_reducer, 0, NULL);
+    double chunked_reduce_time = get_time() - start;
+
+    double chunked_memory = (double)(chunked.used_chunks * sizeof(_ListChunk)) / (double)size;
+    List_dtor(&chunked);
+
+    if (frag_sum != lin_sum || lin_sum != chunked_sum) printf("Sum mismatch!\n");
+
+    List_ctor(&list, small_size + insert_count + 2);
+    fill_shuffled(&list, small_size);
+
+    start = get_time();
+    run_middle_inserts(&list, insert_count);
+    double frag_insert_time = get_time() - start;
+    List_dtor(&list);
+
+    List_ctor(&chunked, small_size + insert_count);
+    tail = 0;
+    for (size_t id = 0; id < small_size; ++id) tail = List_insert(&chunked, (list_elem_t)id, tail);
+
+    start = get_time();
+    run_middle_inserts(&chunked, insert_count);
+    double chunked_insert_time = get_time() - start;
+    List_dtor(&chunked);
+
+    printf("%20s %14s %14.2lf %16.1lf %16.2lf\n", "list (fragmented)", "-", frag_reduce_time * 1e9 / (double)size,
+           list_memory, frag_insert_time * 1e6 / (double)insert_count);
+    printf("%20s %14s %14.2lf %16.1lf %16s\n", "list (linearized)", "-", lin_reduce_time * 1e9 / (double)size,
+           list_memory, "-");
+    printf("%20s %14.2lf %14.2lf %16.1lf %16.2lf\n", "chunk list", append_time * 1e9 / (double)size,
+           chunked_reduce_time * 1e9 / (double)size, chunked_memory, chunked_insert_time * 1e6 / (double)insert_count);
+}
+
+/**
+ * @brief Compare memory use and traversal speed of XOR lists with linked lists.
+ * 
+ * @note Only the traversal is compared, as List operations also run full List_status() check.
+ * 
+ * @param size number of list elements
+ */
+static void bench_compact(const size_t size) {
+    printf("\n[compact] %lu elements in list order\n", (unsigned long) size);
+    printf("%12s %12s %12s %12s %12s %12s\n", "storage", "cell, bytes", "buffer, MB", "reduce, ns", "next, ns", "append, ns");
+
+    List list = {};
+    List_ctor(&list, size + 2);
+    fill_shuffled(&list, size);
+    List_linearize(&list);
+
+    double start = get_time();
+    list_elem_t list_sum = List_reduce(&list, sum_reducer, 0, NULL);
+    double list_reduce_time = get_time() - start;
+
+    double list_memory = (double)(list.capacity * sizeof(_ListCell)) / (1 << 20);
+    List_dtor(&list);
+
+    XorList compact = {};
+    List_ctor(&compact, size + 2);
+
+    start = get_time();
+    list_position_t position = 0;
+    for (size_t id = 0; id < size; ++id) position = List_insert(&compact, (list_elem_t)id, position);
+    double append_time = get_time() - start;
+
+    start = get_time();
+    list_elem_t compact_sum = List_reduce(&compact, sum_reducer, 0, NULL);
+    double reduce_time = get_time() - start;
+
+    start = get_time();
+    list_elem_t next_sum = 0;
+    for (position = List_next(&compact, 0); position; position = List_next(&compact, position)) next_sum += List_get(&compact, position);
+    double next_time = get_time() - start;
+
+    double compact_memory = (double)(compact.capacity * sizeof(_ListXorCell)) / (1 << 20);
+    List_dtor(&compact);
+
+    if (list_sum != compact_sum || compact_sum != next_sum) printf("Sum mismatch!\n");
+
+    printf("%12s %12lu %12.1lf %12.2lf %12s %12s\n", "list", (unsigned long) sizeof(_ListCell), list_memory,
+           list_reduce_time * 1e9 / (double)size, "-", "-");
+    printf("%12s %12lu %12.1lf %12.2lf %12.2lf %12.2lf\n", "xor list", (unsigned long) sizeof(_ListXorCell), compact_memory,
+           reduce_time * 1e9 / (double)size, next_time * 1e9 / (double)size, append_time * 1e9 / (double)size);
+    printf("Memory saved: %.0lf%%\n", 100 * (1 - compact_memory / list_memory));
+}
+
+/**
+ * @brief Run a mix of lookups, insertions and removals at random indices of the list.
+ * 
+ * @param list list with capacity of at least size + 2
+ * @param op_count number of operations to perform
+ * @param lookup_percent share of operations that only read the element
+ * @return sum of read elements
+ */
+static list_elem_t run_mixed_ops(List* const list, const size_t op_count, const int lookup_percent) {
+    list_elem_t sum = 0;
+
+    srand(11);
+    for (size_t op = 0; op < op_count; ++op) {
+        list_position_t position = List_find_position(list, rand() % (int)list->size);
+
+        if (rand() % 100 < lookup_percent) sum += List_get(list, position);
+        else if (op % 2)                   List_insert(list, (list_elem_t)op, position);
+        else                               List_pop(list, position);
+    }
+
+    return sum;
+}
+
+/**
+ * @brief Compare linearization policies on workloads with different shares of lookups.
+ * 
+ * @note Uses a small list, as every operation also runs full List_status() check.
+ * 
+ * @param op_count number of operations per workload
+ */
+static void bench_policy(const size_t op_count) {
+    const size_t size = 1 << 13;
+    static const int LOOKUP_PERCENTS[] = {99, 90, 50, 10};
+
+    struct {
+        const char* name;
+        bool attached;
+        ListPolicyConfig config;
+    } policies[] = {
+        { "never",          false, {} },
+        { "always",         true,  {} },
+        { "adaptive",       true,  {} },
+        { "adaptive, step", true,  {} },
+    };
+    policies[1].config.mode = LIST_LINEARIZE_ALWAYS;
+    policies[3].config.step_budget = 64;
+
+    printf("\n[policy] %lu operations on %lu elements at random indices, shuffled buffer\n",
+           (unsigned long) op_count, (unsigned long) size);
+    printf("%10s %16s %12s %14s\n", "lookups, %", "policy", "us per op", "linearizations");
+
+    List list = {};
+    List_ctor(&list, size + size / 4 + 2);
+
+    for (int lookup_percent : LOOKUP_PERCENTS) {
+        list_elem_t expected_sum = 0;
+
+        for (size_t policy = 0; policy < sizeof(policies) / sizeof(*policies); ++policy) {
+            fill_shuffled(&list, size);
+            List_set_policy(&list, policies[policy].attached ? &policies[policy].config : NULL);
+
+            double start = get_time();
+            list_elem_t sum = run_mixed_ops(&list, op_count, lookup_percent);
+            double run_time = get_time() - start;
+
+            if (policy == 0) expected_sum = sum;
+            else if (sum != expected_sum) printf("Sum mismatch!\n");
+
+            printf("%10d %16s %12.2lf %14lu\n", lookup_percent, policies[policy].name,
+                   run_time * 1e6 / (double)op_count, (unsigned long) List_policy_linearize_count(&list));
+        }
+    }
+
+    List_dtor(&list);
+}
+
+/**
+ * @brief Insert the value into the sorted list looking up every index from the head until a greater element.
+ * 
+ * @param list sorted list
+ * @param value value to insert
+ */
+static void insert_scanning(List* const list, const list_elem_t value) {
+    list_position_t position = 0;
+
+    for (int index = 0; index < (int)list->size; ++index) {
+        list_position_t next = List_find_position(list, index);
+        if (value < List_get(list, next)) break;
+        position = next;
+    }
+
+    List_insert(list, value, position);
+}
+
+static void scramble_visitor(list_elem_t* elem, void* ctx) {
+    SILENCE_UNUSED(ctx);
+    *elem = (*elem * 0x9E3779B1) & 0xFFFFFF;
+}
+
+/**
+ * @brief Compare scan-then-insert with sorted container mode and measure List_sort().
+ * 
+ * @note Insertions use small lists, as scanning inserts call List_find_position() for every element before them.
+ * 
+ * @param sort_size number of elements to sort
+ */
+static void bench_sorted(const size_t sort_size) {
+    static const size_t SIZES[] = {256, 1024};
+
+    printf("\n[sorted] random values inserted into sorted lists\n");
+    printf("%10s %18s %18s %18s\n", "elements", "scan+insert, us", "insert_sorted, us", "lower_bound, us");
+
+    for (size_t size : SIZES) {
+        List scanned = {};
+        List indexed = {};
+        List_ctor(&scanned, size + 2);
+        List_ctor(&indexed, size + 2);
+        List_set_sorted(&indexed, true);
+
+        srand(5);
+        double start = get_time();
+        for (size_t id = 0; id < size; ++id) insert_scanning(&scanned, (list_elem_t)(rand() % 1000000));
+        double scan_time = get_time() - start;
+
+        srand(5);
+        start = get_time();
+        for (size_t id = 0; id < size; ++id) List_insert_sorted(&indexed, (list_elem_t)(rand() % 1000000));
+        double insert_time = get_time() - start;
+
+        start = get_time();
+        size_t found = 0;
+        for (size_t id = 0; id < size; ++id) found += List_lower_bound(&indexed, (list_elem_t)(rand() % 1000000)) != 0;
+        double lookup_time = get_time() - start;
+
+        list_position_t scanned_cell = scanned.buffer->next;
+        list_position_t indexed_cell = indexed.buffer->next;
+        for (; scanned_cell != 0 && indexed_cell != 0; scanned_cell = scanned.buffer[scanned_cell].next,
+                                                       indexed_cell = indexed.buffer[indexed_cell].next) {
+            if (scanned.buffer[scanned_cell].content != indexed.buffer[indexed_cell].content) break;
+        }
+        if (scanned_cell != 0 || indexed_cell != 0 || found > size) printf("Order mismatch!\n");
+
+        printf("%10lu %18.2lf %18.2lf %18.2lf\n", (unsigned long) size, scan_time * 1e6 / (double)size,
+               insert_time * 1e6 / (double)size, lookup_time * 1e6 / (double)size);
+
+        List_dtor(&scanned);
+        List_dtor(&indexed);
+    }
+
+    List list = {};
+    List_ctor(&list, sort_size + sort_size / 4 + 2);
+    fill_shuffled(&list, sort_size);
+    List_for_each(&list, scramble_visitor, NULL);
+
+    double start = get_time();
+    List_sort(&list);
+    double sort_time = get_time() - start;
+
+    for (list_position_t cell = list.buffer->next; list.buffer[cell].next != 0; cell = list.buffer[cell].next) {
+        if (list.buffer[list.buffer[cell].next].content < list.buffer[cell].content) {
+            printf("Sort failed!\n");
+            break;
+        }
+    }
+
+    printf("List_sort of %lu shuffled elements: %.2lf ms (%.1lf ns per element)\n", (unsigned long) sort_size,
+           sort_time * 1e3, sort_time * 1e9 / (double)sort_size);
+
+    List_dtor(&list);
+}
+
+/**
+ * @brief Measure journaling overhead per operation and journal replay speed.
+ * 
+ * @note Uses a small list, as every operation also runs full List_status() check.
+ * 
+ * @param op_count number of operations to journal
+ */
+static void bench_journal(const size_t op_count) {
+    const char* base_name = "bench_journal";
+    const size_t depth = 256;
+    const size_t sync_op_count = op_count < 1024 ? op_count : 1024;
+
+    printf("\n[journal] %lu operations on %lu elements, files %s.*\n",
+           (unsigned long) op_count, (unsigned long) depth, base_name);
+    printf("%28s %12s\n", "mode", "ns per op");
+
+    List list = {};
+    List_ctor(&list, 2 * depth + 2);
+
+    double start = get_time();
+    run_queue_ops(&list, op_count, depth);
+    double plain_time = get_time() - start;
+
+    ListJournal journal = {};
+    ListJournal_ctor(&journal, &list, base_name, 0, 1);
+
+    start = get_time();
+    run_queue_ops(&list, sync_op_count, depth);
+    double sync_time = get_time() - start;
+
+    ListJournal_dtor(&journal);
+    ListJournal_ctor(&journal, &list, base_name);
+
+    start = get_time();
+    run_queue_ops(&list, op_count, depth);
+    ListJournal_commit(&journal);
+    double group_time = get_time() - start;
+
+    //* Replay also has to restore the direction and the head of the list.
+    List_reverse(&list);
+    List_rotate(&list, (int)depth / 3);
+    ListJournal_commit(&journal);
+
+    ListJournal_dtor(&journal);
+
+    List recovered = {};
+
+    start = get_time();
+    list_report_t report = List_recover(&recovered, base_name);
+    double replay_time = get_time() - start;
+
+    bench_check(report == 0 && recovered.first_empty == list.first_empty && recovered.reversed == list.reversed &&
+                memcmp(recovered.buffer, list.buffer, list.capacity * sizeof(*list.buffer)) == 0 && same_order(&recovered, &list),
+                "Recovered list mismatch!");
+
+    if (recovered.buffer) List_dtor(&recovered);
+    List_dtor(&list);
+
+    unlink("bench_journal.ckpt");
+    unlink("bench_journal.wal");
+
+    printf("%28s %12.1lf\n", "no journal", plain_time * 1e9 / (double)op_count);
+    printf("%28s %12.1lf\n", "journal, sync every op", sync_time * 1e9 / (double)sync_op_count);
+    printf("%28s %12.1lf\n", "journal, group commit", group_time * 1e9 / (double)op_count);
+    printf("%28s %12.0lf ops/s\n", "replay", (double)op_count / replay_time);
+}
+
+/**
+ * @brief Hash the buffer byte by byte the way get_simple_hash() used to.
+ * 
+ * @param start
+ * @param end
+ * @param hash
+ * @return hash_t
+ */
+static hash_t get_bytewise_hash(const void* start, const void* end, hash_t hash) {
+    for (const char* ptr = (const char*)start; ptr < (const char*)end; ++ptr) {
+        hash *= 0xC0FEBABEDEAD;
+        hash += (unsigned char)*ptr;
+    }
+    return hash;
+}
+
+/**
+ * @brief Compare hash speeds and costs of list check modes.
+ * 
+ * @param size number of cells to hash
+ */
+static void bench_checks(const size_t size) {
+    List list = {};
+    List_ctor(&list, size + 2);
+    fill_shuffled(&list, size);
+
+    const _ListCell* cells = list.buffer;
+    size_t data_size = (size + 2) * sizeof(*cells);
+
+    double start = get_time();
+    hash_t bytewise = get_bytewise_hash(cells, cells + size + 2, SIMPLE_HASH_SEED);
+    double bytewise_time = get_time() - start;
+
+    start = get_time();
+    hash_t wordwise = get_simple_hash(cells, cells + size + 2, SIMPLE_HASH_SEED);
+    double wordwise_time = get_time() - start;
+
+    printf("\n[checks] hashing %.1lf MB\n", (double)data_size / (1 << 20));
+    printf("%12s %10s %12s %18s\n", "hash", "ms", "GB/s", "value");
+    printf("%12s %10.2lf %12.2lf %18llx\n", "byte-wise", bytewise_time * 1e3, (double)data_size / bytewise_time / 1e9,
+           (unsigned long long) bytewise);
+    printf("%12s %10.2lf %12.2lf %18llx\n", "word-wise", wordwise_time * 1e3, (double)data_size / wordwise_time / 1e9,
+           (unsigned long long) wordwise);
+
+    List_dtor(&list);
+
+    const size_t depth = 1 << 12;
+    const size_t op_count = 1 << 16;
+    const size_t audit_interval = 256;
+
+    struct {
+        const char* name;
+        ListCheckMode mode;
+        size_t audit_interval;
+    } modes[] = {
+        { "full",       LIST_CHECK_FULL,     0 },
+        { "periodic",   LIST_CHECK_PERIODIC, audit_interval },
+        { "sampled",    LIST_CHECK_SAMPLED,  audit_interval },
+        { "cheap only", LIST_CHECK_PERIODIC, 0 },
+    };
+
+    printf("\n[checks] %lu queue operations on %lu elements, audit every %lu operations\n",
+           (unsigned long) op_count, (unsigned long) depth, (unsigned long) audit_interval);
+    printf("%12s %12s\n", "mode", "us per op");
+
+    for (size_t mode = 0; mode < sizeof(modes) / sizeof(*modes); ++mode) {
+        List_ctor(&list, 2 * depth + 2);
+        List_set_checks(&list, modes[mode].mode, modes[mode].audit_interval);
+
+        start = get_time();
+        run_queue_ops(&list, op_count, depth);
+        double run_time = get_time() - start;
+
+        if (List_status(&list)) printf("Status check failed!\n");
+        printf("%12s %12.3lf\n", modes[mode].name, run_time * 1e6 / (double)op_count);
+
+        List_dtor(&list);
+    }
+}
+
+/**
+ * @brief Generate keys with Zipfian distribution (key k has weight 1 / (k + 1)^exponent).
+ * 
+ * @param[out] keys
+ * @param count number of keys to generate
+ * @param key_count number of distinct keys
+ * @param exponent
+ */
+static void fill_zipfian(list_cache_key_t* const keys, const size_t count, const size_t key_count, const double exponent) {
+    double* cdf = (double*) calloc(key_count, sizeof(*cdf));
+
+    double total = 0;
+    for (size_t key = 0; key < key_count; ++key) {
+        total += pow((double)(key + 1), -exponent);
+        cdf[key] = total;
+    }
+
+    srand(7);
+    for (size_t id = 0; id < count; ++id) {
+        double point = total * ((double)rand() / ((double)RAND_MAX + 1));
+
+        size_t left = 0, right = key_count - 1;
+        while (left < right) {
+            size_t middle = (left + right) / 2;
+            if (cdf[middle] < point) left = middle + 1;
+            else                     right = middle;
+        }
+
+        keys[id] = left;
+    }
+
+    free(cdf);
+}
+
+/**
+ * @brief Run a small random trace on caches of every policy and compare them with a model.
+ * 
+ * @note The model keeps keys from the most recently used one, so it predicts every hit of the LRU cache.
+ *       Caches of all policies have to return the last value put for the key and keep at most capacity entries.
+ * 
+ * @return true if all caches agreed with the model
+ */
+static bool check_cache() {
+    const size_t key_count = 64;
+    const size_t capacity = 16;
+    const size_t op_count = 1 << 14;
+
+    for (int policy = LIST_CACHE_LRU; policy <= LIST_CACHE_LFU; ++policy) {
+        ListCache cache = {};
+        ListCache_ctor(&cache, capacity, (ListCachePolicy) policy);
+
+        list_cache_key_t recency[capacity] = {};
+        size_t cached = 0;
+        list_elem_t values[key_count] = {};
+        bool passed = true;
+
+        srand(11);
+        for (size_t op = 0; op < op_count && passed; ++op) {
+            list_cache_key_t key = (list_cache_key_t)rand() % key_count;
+            list_elem_t value = 0;
+
+            bool hit = ListCache_get(&cache, key, &value);
+            if (hit) {
+                passed &= value == values[key];
+            } else {
+                values[key] = (list_elem_t)op + 1;
+                ListCache_put(&cache, key, values[key]);
+            }
+
+            passed &= cache.list.size <= capacity;
+
+            if (policy != LIST_CACHE_LRU) continue;
+
+            //* Missed keys take the place of the least recently used one once the model is full.
+            size_t found = 0;
+            while (found < cached && recency[found] != key) ++found;
+
+            passed &= hit == (found < cached);
+            if (found == cached && cached < capacity) ++cached;
+            if (found == cached) --found;
+
+            memmove(recency + 1, recency, found * sizeof(*recency));
+            recency[0] = key;
+        }
+
+        ListCache_dtor(&cache);
+        if (!passed) return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Compare hit rates and throughput of cache policies on Zipfian traces.
+ * 
+ * @param op_count number of lookups per trace
+ */
+static void bench_cache(const size_t op_count) {
+    const size_t key_count = 1 << 20;
+    static const double EXPONENTS[] = {0.8, 0.99};
+    static const size_t CACHE_PERMILLES[] = {10, 100};
+
+    list_cache_key_t* keys = (list_cache_key_t*) calloc(op_count, sizeof(*keys));
+
+    printf("\n[cache] %lu lookups of %lu keys (missed keys are put), Zipfian traces\n",
+           (unsigned long) op_count, (unsigned long) key_count);
+    printf("%10s %10s %8s %12s %12s\n", "exponent", "capacity", "policy", "hit rate, %", "Mops/s");
+
+    for (double exponent : EXPONENTS) {
+        fill_zipfian(keys, op_count, key_count, exponent);
+
+        for (size_t permille : CACHE_PERMILLES) {
+            size_t capacity = key_count * permille / 1000;
+
+            for (int policy = LIST_CACHE_LRU; policy <= LIST_CACHE_LFU; ++policy) {
+                ListCache cache = {};
+                ListCache_ctor(&cache, capacity, (ListCachePolicy) policy);
+
+                double start = get_time();
+                for (size_t id = 0; id < op_count; ++id) {
+                    if (!ListCache_get(&cache, keys[id], NULL)) ListCache_put(&cache, keys[id], (list_elem_t)id);
+                }
+                double run_time = get_time() - start;
+
+                printf("%10.2lf %10lu %8s %12.2lf %12.2lf\n", exponent, (unsigned long) capacity, LIST_CACHE_POLICY_NAMES[policy],
+                       100.0 * (double)cache.hits / (double)op_count, (double)op_count / run_time / 1e6);
+
+                ListCache_dtor(&cache);
+            }
+        }
+    }
+
+    free(keys);
+
+    bench_check(check_cache(), "Cache mismatch!");
+}
+
+/**
+ * @brief Compare separate lookups with batched and interleaved ones on shuffled lists.
+ * 
+ * @note Lists only run cheap checks, so the walks are measured rather than List_status().
+ * 
+ * @param list_size total number of elements of the lists
+ */
+static void bench_batch(const size_t list_size) {
+    const size_t lookup_count = 1 << 10;
+    const size_t list_count = 64;
+    const size_t size = list_size / list_count;
+    const size_t multi_size = list_size / list_count;
+
+    int* indices = (int*) calloc(lookup_count, sizeof(*indices));
+    list_position_t* positions = (list_position_t*) calloc(lookup_count, sizeof(*positions));
+    list_elem_t* values = (list_elem_t*) calloc(lookup_count, sizeof(*values));
+
+    List list = {};
+    List_ctor(&list, size + 2);
+    fill_shuffled(&list, size);
+    List_set_checks(&list, LIST_CHECK_PERIODIC, 0);
+
+    srand(11);
+    for (size_t id = 0; id < lookup_count; ++id) indices[id] = rand() % (int)size;
+
+    printf("\n[batch] %lu lookups at random indices of shuffled lists\n", (unsigned long) lookup_count);
+    printf("%28s %12s %12s\n", "mode", "ms", "ns per op");
+
+    list_elem_t single_sum = 0, batch_sum = 0;
+
+    double start = get_time();
+    for (size_t id = 0; id < lookup_count; ++id) single_sum += List_get(&list, List_find_position(&list, indices[id]));
+    double single_time = get_time() - start;
+
+    start = get_time();
+    List_find_positions(&list, indices, lookup_count, positions, values);
+    for (size_t id = 0; id < lookup_count; ++id) batch_sum += values[id];
+    double batch_time = get_time() - start;
+
+    if (single_sum != batch_sum) printf("Sum mismatch!\n");
+
+    printf("%28s %12.2lf %12.1lf\n", "separate, 1 list", single_time * 1e3, single_time * 1e9 / (double)lookup_count);
+    printf("%28s %12.2lf %12.1lf\n", "batched, 1 list", batch_time * 1e3, batch_time * 1e9 / (double)lookup_count);
+
+    List_dtor(&list);
+
+    List* lists = (List*) calloc(list_count, sizeof(*lists));
+    List** lookup_lists = (List**) calloc(lookup_count, sizeof(*lookup_lists));
+
+    for (size_t list_id = 0; list_id < list_count; ++list_id) {
+        lists[list_id] = List {};
+        List_ctor(&lists[list_id], multi_size + 2);
+        fill_shuffled(&lists[list_id], multi_size);
+        List_set_checks(&lists[list_id], LIST_CHECK_PERIODIC, 0);
+    }
+
+    srand(12);
+    for (size_t id = 0; id < lookup_count; ++id) {
+        lookup_lists[id] = &lists[(size_t)rand() % list_count];
+        indices[id] = rand() % (int)(multi_size / 2);
+    }
+
+    single_sum = batch_sum = 0;
+
+    start = get_time();
+    for (size_t id = 0; id < lookup_count; ++id) {
+        single_sum += List_get(lookup_lists[id], List_find_position(lookup_lists[id], indices[id]));
+    }
+    single_time = get_time() - start;
+
+    start = get_time();
+    List_find_positions_multi(lookup_lists, indices, lookup_count, positions, values);
+    for (size_t id = 0; id < lookup_count; ++id) batch_sum += values[id];
+    batch_time = get_time() - start;
+
+    if (single_sum != batch_sum) printf("Sum mismatch!\n");
+
+    char mode[32] = "";
+    snprintf(mode, sizeof(mode), "separate, %lu lists", (unsigned long) list_count);
+    printf("%28s %12.2lf %12.1lf\n", mode, single_time * 1e3, single_time * 1e9 / (double)lookup_count);
+    snprintf(mode, sizeof(mode), "interleaved, %lu lists", (unsigned long) list_count);
+    printf("%28s %12.2lf %12.1lf\n", mode, batch_time * 1e3, batch_time * 1e9 / (double)lookup_count);
+
+    for (size_t list_id = 0; list_id < list_count; ++list_id) List_dtor(&lists[list_id]);
+
+    free(lists);
+    free(lookup_lists);
+    free(indices);
+    free(positions);
+    free(values);
+}
+
+/**
+ * @brief Get the list of the array of lists or small lists.
+ * 
+ * @param objects array of lists or small lists
+ * @param object_size size of one object
+ * @param list_id index of the object
+ * @return List*
+ */
+static inline List* list_at(char* const objects, const size_t object_size, const size_t list_id) {
+    return (List*)(objects + list_id * object_size);
+}
+
+/**
+ * @brief Create, fill and destroy many small lists with heap buffers and many small lists with inline ones.
+ * 
+ * @param list_count number of lists alive at once
+ */
+static void bench_small(const size_t list_count) {
+    const size_t fixed_size = LIST_INLINE_CELLS - 1;
+    const size_t grown_size = LIST_INLINE_CELLS * 4;
+
+    struct SmallMode {
+        const char* name;
+        size_t capacity;        // 0 for small lists made by List_ctor_small().
+        size_t size;
+    };
+
+    const SmallMode modes[] = {
+        { "heap buffer",        LIST_INLINE_CELLS, fixed_size },
+        { "growable, inline",   0,                 fixed_size },
+        { "growable, spilled",  0,                 grown_size },
+    };
+
+    printf("\n[small] %lu lists at once, List is %lu bytes, SmallList is %lu bytes (%lu inline cells)\n",
+           (unsigned long) list_count, (unsigned long) sizeof(List), (unsigned long) sizeof(SmallList),
+           (unsigned long) LIST_INLINE_CELLS);
+    printf("%20s %8s %12s %12s %12s %14s\n", "mode", "size", "ctor ns", "fill ns", "dtor ns", "bytes per list");
+
+    for (const SmallMode& mode : modes) {
+        //* Lists are the first members of small lists, so both kinds are reached through List pointers.
+        size_t object_size = mode.capacity ? sizeof(List) : sizeof(SmallList);
+        char* objects = (char*) calloc(list_count, object_size);
+        if (!objects) return;
+
+        double resident_before = get_resident_mb();
+
+        //* Full checks probe buffers with system calls, so lists are checked in O(1) time from their ctors on.
+        for (size_t list_id = 0; list_id < list_count; ++list_id)
+            list_at(objects, object_size, list_id)->check_mode = LIST_CHECK_PERIODIC;
+
+        double start = get_time();
+        for (size_t list_id = 0; list_id < list_count; ++list_id) {
+            if (mode.capacity) List_ctor(list_at(objects, object_size, list_id), mode.capacity);
+            else               List_ctor_small((SmallList*) list_at(objects, object_size, list_id));
+        }
+        double ctor_time = get_time() - start;
+
+        start = get_time();
+        for (size_t list_id = 0; list_id < list_count; ++list_id) {
+            List* list = list_at(objects, object_size, list_id);
+            for (size_t id = 0; id < mode.size; ++id) List_insert(list, (list_elem_t)id, list->buffer->prev);
+        }
+        double fill_time = get_time() - start;
+
+        double resident_used = get_resident_mb();
+
+        list_elem_t sum = 0;
+        for (size_t list_id = 0; list_id < list_count; list_id += 97) sum += List_sum(list_at(objects, object_size, list_id));
+        if (sum != (list_elem_t)((list_count + 96) / 97 * mode.size * (mode.size - 1) / 2)) printf("Sum mismatch!\n");
+
+        start = get_time();
+        for (size_t list_id = 0; list_id < list_count; ++list_id) List_dtor(list_at(objects, object_size, list_id));
+        double dtor_time = get_time() - start;
+
+        free(objects);
+
+        printf("%20s %8lu %12.1lf %12.1lf %12.1lf %14.0lf\n", mode.name, (unsigned long) mode.size,
+               ctor_time * 1e9 / (double)list_count, fill_time * 1e9 / (double)list_count, dtor_time * 1e9 / (double)list_count,
+               (resident_used - resident_before) * (1 << 20) / (double)list_count);
+    }
+}
+
+/**
+ * @brief Compare the static table built at compile time with the same list built at runtime.
+ * 
+ * @param lookup_count number of lookups in every table
+ */
+static void bench_static(const size_t lookup_count) {
+    int* indices = (int*) calloc(lookup_count, sizeof(*indices));
+    if (!indices) return;
+
+    srand(13);
+    for (size_t id = 0; id < lookup_count; ++id) indices[id] = rand() % (int)STATIC_TABLE_SIZE;
+
+    printf("\n[static] table of %lu squares, %lu lookups\n", (unsigned long) STATIC_TABLE_SIZE, (unsigned long) lookup_count);
+    printf("%20s %12s %14s\n", "table", "build us", "ns per lookup");
+
+    double start = get_time();
+
+    List list = {};
+    List_ctor(&list, STATIC_TABLE_SIZE + 1);
+    for (size_t id = 0; id < STATIC_TABLE_SIZE; ++id) List_insert(&list, (list_elem_t)(id * id), list.buffer->prev);
+
+    double build_time = get_time() - start;
+
+    List_set_checks(&list, LIST_CHECK_PERIODIC, 0);
+
+    list_elem_t list_sum = 0, static_sum = 0;
+
+    start = get_time();
+    for (size_t id = 0; id < lookup_count; ++id) list_sum += List_get(&list, List_find_position(&list, indices[id]));
+    double list_time = get_time() - start;
+
+    start = get_time();
+    for (size_t id = 0; id < lookup_count; ++id) static_sum += List_get(&STATIC_TABLE, List_find_position(&STATIC_TABLE, indices[id]));
+    double static_time = get_time() - start;
+
+    if (list_sum != static_sum) printf("Sum mismatch!\n");
+
+    printf("%20s %12.2lf %14.1lf\n", "List, runtime", build_time * 1e6, list_time * 1e9 / (double)lookup_count);
+    printf("%20s %12.2lf %14.1lf\n", "StaticList, rodata", 0.0, static_time * 1e9 / (double)lookup_count);
+
+    List_dtor(&list);
+    free(indices);
+}
+
+/**
+ * @brief Measure tracing overhead and latency distribution of list operations.
+ * 
+ * @param op_count number of operations to measure
+ * @param trace_name name of the Chrome trace file to write
+ */
+static void bench_trace(const size_t op_count, const char* trace_name) {
+    printf("\n[trace] %lu operations, %s timer\n", (unsigned long) op_count,
+#ifdef LATENCY_TRACE_TSC
+           "TSC");
+#else
+           "monotonic clock");
+#endif
+    printf("%28s %12s %12s\n", "mode", "scope, ns", "List_get, ns");
+
+    //* List_get() on a tiny list shows tracing cost relative to a whole validated call.
+    List list = {};
+    List_ctor(&list, 4);
+    list_position_t position = List_insert(&list, 1, 0);
+
+    static const char* const MODE_NAMES[] = {"tracing stopped", "sampling every 64th call", "sampling every call"};
+    static const size_t SAMPLE_PERIODS[] = {0, 64, 1};
+
+    for (int mode = 0; mode < 3; ++mode) {
+        if (SAMPLE_PERIODS[mode]) LatencyTrace_start(SAMPLE_PERIODS[mode]);
+        else                      LatencyTrace_stop();
+
+        double start = get_time();
+        for (size_t op = 0; op < op_count; ++op) {
+            LatencyTraceScope scope(LIST_SPAN_COUNT);
+            __asm__ volatile("" ::: "memory");
+        }
+        double scope_time = get_time() - start;
+
+        list_elem_t sum = 0;
+        start = get_time();
+        for (size_t op = 0; op < op_count; ++op) sum += List_get(&list, position);
+        double get_time_total = get_time() - start;
+
+        if (sum != (list_elem_t)op_count) printf("List_get mismatch!\n");
+
+        printf("%28s %12.2lf %12.2lf\n", MODE_NAMES[mode],
+               scope_time * 1e9 / (double)op_count, get_time_total * 1e9 / (double)op_count);
+    }
+
+    List_dtor(&list);
+
+    //* Queue-like workload over a bigger list with occasional linearization spikes.
+    const size_t depth = 1024;
+    List_ctor(&list, 2 * depth + 2);
+
+    LatencyTrace_start(1, (1 << LIST_SPAN_INSERT) | (1 << LIST_SPAN_POP) | (1 << LIST_SPAN_LINEARIZE));
+
+    for (size_t op = 0; op < op_count / 64; ++op) {
+        if (list.size < depth || op % 2 == 0) List_insert(&list, (list_elem_t)op, list.buffer[list.buffer->next].next);
+        else                                   List_pop(&list, list.buffer->next);
+
+        if (op % 1024 == 0) List_linearize(&list);
+    }
+
+    LatencyTrace_stop();
+
+    printf("\nLatencies of %lu queue operations on %lu elements:\n", (unsigned long)(op_count / 64), (unsigned long) depth);
+    List_print_trace(stdout);
+
+    List_write_trace(trace_name);
+    printf("Chrome trace of insert, pop and linearize spans is written to %s.\n", trace_name);
+
+    LatencyTrace_clear();
+    List_dtor(&list);
+}
+
+/**
+ * @brief Scatter elements of the linearized list by swapping random pairs of its cells.
+ * 
+ * @param list linearized list
+ * @param swap_count number of swaps
+ */
+static void scatter_cells(List* const list, const size_t swap_count) {
+    for (size_t swap = 0; swap < swap_count; ++swap) {
+        list_position_t alpha = (list_position_t)rand() % list->size + 1;
+        list_position_t beta = (list_position_t)rand() % list->size + 1;
+        if (alpha != beta) _List_swap_cells(list->buffer, alpha, beta);
+    }
+
+    if (swap_count) list->linearized = false;
+    _List_checksum_rebuild(list);
+}
+
+/**
+ * @brief Measure hardware counters of list traversal at different fragmentation levels.
+ * 
+ * @param size number of list elements
+ */
+static void bench_profile(const size_t size) {
+    printf("\n[profile] %lu elements, sequential traversal with List_reduce(), counters per element\n", (unsigned long) size);
+
+    PerfCounters counters = {};
+    int error = 0;
+    PerfCounters_ctor(&counters, &error);
+    if (error) printf("Hardware counters are not available (%s).\n", strerror(error));
+
+    printf("%14s %10s", "fragmentation", "ns");
+    for (int counter = 0; counter < PERF_COUNTER_COUNT; ++counter) printf(" %12s", PERF_COUNTER_NAMES[counter]);
+    printf("\n");
+
+    List list = {};
+    List_ctor(&list, size + size / 4 + 2);
+
+    static const double SCATTER_RATES[] = {-1, 0.25, 0.05, 0.01, 0};
+
+    for (double rate : SCATTER_RATES) {
+        fill_shuffled(&list, size);
+        if (rate >= 0) {
+            List_linearize(&list);
+            srand(7);
+            scatter_cells(&list, (size_t)(rate * (double)size));
+        }
+
+        double fragmentation = List_fragmentation(&list);
+
+        PerfCounters_start(&counters);
+        double start = get_time();
+        list_elem_t sum = List_reduce(&list, sum_reducer, 0, NULL);
+        double traversal_time = get_time() - start;
+        PerfCounters_stop(&counters);
+
+        if (sum != (list_elem_t)size * (list_elem_t)(size - 1) / 2) printf("Sum mismatch!\n");
+
+        printf("%14.3lf %10.2lf", fragmentation, traversal_time * 1e9 / (double)size);
+        PerfCounters_print(&counters, stdout, (double)size);
+        printf("\n");
+    }
+
+    List_dtor(&list);
+    PerfCounters_dtor(&counters);
+}
+
+/**
+ * @brief Compare traversal of lists with buffers allocated with different page sizes and NUMA placements.
+ * 
+ * @param size number of list elements
+ */
+static void bench_pages(const size_t size) {
+    printf("\n[pages] %lu elements, traversal with List_reduce(), time and dTLB misses per element\n", (unsigned long) size);
+
+    PerfCounters counters = {};
+    PerfCounters_ctor(&counters);
+
+    struct PageSetting {
+        const char* name;
+        PageAllocOptions options;
+    };
+
+    static const PageSetting SETTINGS[] = {
+        { "calloc",         { PAGE_HEAP,             NUMA_FIRST_TOUCH, 0 } },
+        { "mmap",           { PAGE_NORMAL,           NUMA_FIRST_TOUCH, 0 } },
+        { "thp",            { PAGE_TRANSPARENT_HUGE, NUMA_FIRST_TOUCH, 0 } },
+        { "hugetlb",        { PAGE_HUGETLB,          NUMA_FIRST_TOUCH, 0 } },
+        { "bind node 0",    { PAGE_NORMAL,           NUMA_BIND,        0 } },
+        { "thp bind 0",     { PAGE_TRANSPARENT_HUGE, NUMA_BIND,        0 } },
+        { "interleave",     { PAGE_NORMAL,           NUMA_INTERLEAVE,  0 } },
+        { "thp interleave", { PAGE_TRANSPARENT_HUGE, NUMA_INTERLEAVE,  0 } },
+    };
+
+    printf("%16s %8s %12s %12s %12s %12s\n", "setting", "pages", "random, ns", "dTLB-misses", "linear, ns", "dTLB-misses");
+
+    for (const PageSetting& setting : SETTINGS) {
+        List list = {};
+        List_ctor_with(&list, size + 2, &setting.options);
+        fill_shuffled(&list, size);
+
+        printf("%16s %8s", setting.name, PAGE_SIZE_NAMES[list.pages.pages]);
+
+        for (int pass = 0; pass < 2; ++pass) {
+            if (pass == 1) List_linearize(&list);
+
+            PerfCounters_start(&counters);
+            double start = get_time();
+            list_elem_t sum = List_reduce(&list, sum_reducer, 0, NULL);
+            double traversal_time = get_time() - start;
+            PerfCounters_stop(&counters);
+
+            if (sum != (list_elem_t)size * (list_elem_t)(size - 1) / 2) printf("Sum mismatch!\n");
+
+            printf(" %12.2lf", traversal_time * 1e9 / (double)size);
+            if (PerfCounters_available(&counters, PERF_DTLB_MISSES))
+                printf(" %12.3lf", (double)counters.values[PERF_DTLB_MISSES] / (double)size);
+            else
+                printf(" %12s", "n/a");
+        }
+        printf("\n");
+
+        List_dtor(&list);
+    }
+
+    PerfCounters_dtor(&counters);
+}
+
+static bool third_predicate(const list_elem_t* elem, void* ctx) {
+    SILENCE_UNUSED(ctx);
+    return *elem % 3 == 0;
+}
+
+/**
+ * @brief Compare removal of every third element with List_pop() calls and with one List_remove_if() call.
+ * 
+ * @note Pops walk the list by links and run cheap checks, as full List_status() per pop would make the loop quadratic.
+ * 
+ * @param size number of list elements
+ */
+static void bench_remove(const size_t size) {
+    printf("\n[remove] %lu elements, removal of every third one, time per element\n", (unsigned long) size);
+    printf("%12s %12s %16s %16s %12s\n", "layout", "pops, ns", "remove_if, ns", "full checks, ns", "linearized");
+
+    //* Elements that have to stay, in their order.
+    list_elem_t* kept = (list_elem_t*) calloc(size, sizeof(*kept));
+    if (!kept) return;
+
+    List list = {};
+    List_ctor(&list, size + 2);
+
+    //* Rotated lists stay linearized, but their elements have to be put back in order before compaction.
+    const char* layouts[] = {"scattered", "linearized", "rotated"};
+
+    for (int layout = 0; layout < 3; ++layout) {
+        double times[3] = {};
+        list_elem_t sums[3] = {};
+
+        for (int way = 0; way < 3; ++way) {
+            fill_shuffled(&list, size);
+            if (layout > 0)  List_linearize(&list);
+            if (layout == 2) List_rotate(&list, (int)size / 3);
+            List_set_checks(&list, way == 2 ? LIST_CHECK_FULL : LIST_CHECK_PERIODIC, 0);
+
+            size_t kept_count = 0;
+            for (list_position_t cell = list.buffer->next; cell != 0; cell = list.buffer[cell].next) {
+                if (_List_elem(&list, cell) % 3 != 0) kept[kept_count++] = _List_elem(&list, cell);
+            }
+
+            double start = get_time();
+            if (way == 0) {
+                for (list_position_t cell = list.buffer->next; cell != 0;) {
+                    list_position_t next = list.buffer[cell].next;
+                    if (List_get(&list, cell) % 3 == 0) List_pop(&list, cell);
+                    cell = next;
+                }
+            } else {
+                List_remove_if(&list, third_predicate, NULL);
+            }
+            times[way] = get_time() - start;
+
+            sums[way] = List_reduce(&list, sum_reducer, 0, NULL);
+            bench_check(holds_in_order(&list, kept, kept_count), "Order mismatch after removal!");
+        }
+
+        bench_check(sums[0] == sums[1] && sums[1] == sums[2], "Sum mismatch!");
+
+        printf("%12s %12.2lf %16.2lf %16.2lf %12s\n", layouts[layout], times[0] * 1e9 / (double)size,
+               times[1] * 1e9 / (double)size, times[2] * 1e9 / (double)size, list.linearized ? "yes" : "no");
+    }
+
+    free(kept);
+    List_dtor(&list);
+}
+
+/**
+ * @brief Compare List_reverse() and List_rotate() with rebuilding the order element by element.
+ * 
+ * @note Reversal is rebuilt by inserting elements at the head of another list, rotation by moving head elements to the tail.
+ *       Lookups are random List_find_position() calls before and after the reversal,
+ *       linearized column tells if the reversed and rotated list kept index arithmetic of lookups.
+ * 
+ * @param size number of list elements
+ */
+static void bench_reverse(const size_t size) {
+    const size_t lookup_count = 1 << 12;
+    const size_t shift = size / 2;
+
+    printf("\n[reverse] %lu elements, rotation by %lu, %lu lookups\n", (unsigned long) size, (unsigned long) shift,
+           (unsigned long) lookup_count);
+    printf("%12s %16s %16s %16s %16s %16s %16s %12s\n", "layout", "rebuild rev, us", "reverse, us",
+           "rebuild rot, us", "rotate, us", "lookup, ns", "reversed, ns", "linearized");
+
+    List list = {};
+    List_ctor(&list, size + 2);
+
+    const char* layouts[] = {"scattered", "linearized"};
+
+    for (int linear = 0; linear < 2; ++linear) {
+        List copy = {};
+        List_ctor(&copy, size + 2);
+        List_set_checks(&copy, LIST_CHECK_PERIODIC, 0);
+
+        fill_shuffled(&list, size);
+        if (linear) List_linearize(&list);
+        List_set_checks(&list, LIST_CHECK_PERIODIC, 0);
+
+        //* Reversed list gets the mirrored indices, so both runs read the same elements.
+        list_elem_t sums[2] = {};
+        double lookup_times[2] = {};
+
+        for (int reversed = 0; reversed < 2; ++reversed) {
+            srand(7);
+
+            double start = get_time();
+            for (size_t id = 0; id < lookup_count; ++id) {
+                int index = rand() % (int)size;
+                sums[reversed] += List_get(&list, List_find_position(&list, reversed ? -1 - index : index));
+            }
+            lookup_times[reversed] = get_time() - start;
+
+            List_reverse(&list);
+        }
+
+        bench_check(sums[0] == sums[1], "Sum mismatch!");
+
+        double start = get_time();
+        for (list_position_t cell = list.buffer->next; cell != 0; cell = list.buffer[cell].next)
+            List_insert(&copy, List_get(&list, cell), 0);
+        double rebuild_reverse = get_time() - start;
+
+        start = get_time();
+        List_reverse(&list);
+        double reverse = get_time() - start;
+
+        bench_check(same_order(&list, &copy), "Order mismatch after reversal!");
+
+        start = get_time();
+        for (size_t id = 0; id < shift; ++id) List_move(&copy, copy.buffer->next, copy.buffer->prev);
+        double rebuild_rotate = get_time() - start;
+
+        start = get_time();
+        List_rotate(&list, (int)shift);
+        double rotate = get_time() - start;
+
+        bench_check(same_order(&list, &copy), "Order mismatch after rotation!");
+
+        printf("%12s %16.2lf %16.2lf %16.2lf %16.2lf %16.1lf %16.1lf %12s\n", layouts[linear], rebuild_reverse * 1e6,
+               reverse * 1e6, rebuild_rotate * 1e6, rotate * 1e6, lookup_times[0] * 1e9 / (double)lookup_count,
+               lookup_times[1] * 1e9 / (double)lookup_count, list.linearized ? "yes" : "no");
+
+        List_dtor(&copy);
+    }
+
+    List_dtor(&list);
+
+    bench_check(check_float_extremums(), "NaN min/max mismatch on lists of doubles!");
+}
+
+int main(const int argc, const char** argv) {
+    atexit(log_end_program);
+
+    unsigned int log_threshold = ABSOLUTE_IMPORTANCE;
+    unsigned int list_size = 1 << 22;
+    unsigned int max_threads = 32;
+
+    ActionTag line_tags[] = {
+        #include "cmd_flags/bench_flags.h"
+    };
+    const int number_of_tags = sizeof(line_tags) / sizeof(*line_tags);
+
+    parse_args(argc, argv, number_of_tags, line_tags);
+    log_init("bench_log.html", log_threshold, &errno);
+
+    bench_profile(list_size);
+    bench_pages(list_size);
+    bench_parallel(list_size, max_threads);
+    bench_scan(list_size);
+    bench_chunked(list_size);
+    bench_compact(list_size);
+    bench_startup(list_size);
+    bench_lazy((size_t)list_size * 4);
+    bench_occupancy(list_size);
+    bench_stream(list_size);
+    bench_journal(list_size / 16);
+    bench_policy(list_size / 1024);
+    bench_sorted(list_size / 4);
+    bench_checks(list_size);
+    bench_cache(list_size);
+    bench_batch(list_size);
+    bench_small(list_size / 16);
+    bench_static(list_size);
+    bench_remove(list_size);
+    bench_reverse(list_size / 16);
+    bench_trace(list_size, "bench_trace.json");
+
+    return_clean(errno == 0 && !CHECKS_FAILED ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,118 @@
+#include "bench_float.h"
+
+//* Benchmark lists hold integers, and the library is configured once per unit, so lists of doubles get
+//* their own unit. The library is included in a namespace to keep its symbols apart from the integer ones,
+//* and everything it includes has to be included before (include guards keep it out of the namespace).
+
+#include <new>
+#include <cmath>
+#include <utility>
+#include <atomic>
+#include <type_traits>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "lib/util/dbg/debug.h"
+#include "lib/util/thread_pool.h"
+#include "lib/util/strided_scan.h"
+#include "lib/util/latency_trace.h"
+#include "lib/util/page_alloc.h"
+#include "lib/alloc_tracker/alloc_tracker.h"
+#include "lib/listreports.h"
+#include "lib/list_config.h"
+
+namespace float_lists {
+
+typedef double list_elem_t;
+const list_elem_t LIST_ELEM_POISON = -1e300;
+#include "lib/listworks.h"
+
+}
+
+using namespace float_lists;
+
+static const size_t CHECKED_SIZE = 5;
+
+//* Values in the list order: NaNs at the head, in the middle and at the tail.
+static const double CHECKED_VALUES[][CHECKED_SIZE] = {
+    {2, 5, NAN, 1, 4},
+    {NAN, 3, 1, 4, 2},
+    {NAN, NAN, 7, 2, 9},
+    {3, NAN, NAN, -1, 8},
+    {6, 1, 4, NAN, NAN},
+};
+
+/**
+ * @brief Check if the values are equal or both are NaN.
+ * 
+ * @param first
+ * @param second
+ * @return bool
+ */
+static bool same(const double first, const double second) {
+    return (std::isnan(first) && std::isnan(second)) || first == second;
+}
+
+/**
+ * @brief Build the list with the values in its order.
+ * 
+ * @note Storage of the list wraps around the end of the buffer, so linearized scans see two segments.
+ * 
+ * @param list list to initialize
+ * @param values values in the list order
+ * @param reversed true to build the list in backward order and reverse it
+ * @param scattered true to scatter the list keeping the order of values
+ */
+static void build_list(List* const list, const double* const values, const bool reversed, const bool scattered) {
+    List_ctor(list, CHECKED_SIZE + 3);
+
+    for (size_t id = 0; id < 4; ++id) List_insert(list, 0, list->buffer->prev);
+    for (size_t id = 0; id < 4; ++id) List_pop(list, list->buffer->next);
+
+    for (size_t id = 0; id < CHECKED_SIZE; ++id) {
+        const double value = values[reversed ? CHECKED_SIZE - 1 - id : id];
+        List_insert(list, value, list->buffer->prev);
+    }
+
+    if (reversed) List_reverse(list);
+
+    //* The moves put the head after the second element and back, so the list is no longer linearized.
+    if (scattered) {
+        list_position_t head = List_find_position(list, 0), second = List_find_position(list, 1);
+        List_move(list, head, second);
+        List_move(list, second, head);
+    }
+}
+
+bool check_float_extremums() {
+    for (const double* values : CHECKED_VALUES) {
+        double min = values[0], max = values[0];
+        for (size_t id = 1; id < CHECKED_SIZE; ++id) {
+            if (values[id] < min) min = values[id];
+            if (max < values[id]) max = values[id];
+        }
+
+        for (int variant = 0; variant < 4; ++variant) {
+            List list = {};
+            build_list(&list, values, variant & 1, variant & 2);
+
+            bool passed = same(List_min(&list), min) && same(List_max(&list), max);
+            for (size_t id = 0; id < CHECKED_SIZE; ++id) {
+                passed = passed && same(List_get(&list, List_find_position(&list, (int)id)), values[id]);
+            }
+
+            List_dtor(&list);
+
+            if (!passed) return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,24 @@
+/**
+ * @file bench_float.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Benchmark checks of lists of floating point elements.
+ * @version 0.1
+ * @date 2022-11-05
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#ifndef BENCH_FLOAT_H
+#define BENCH_FLOAT_H
+
+/**
+ * @brief Compare List_min() and List_max() of lists of doubles with NaNs with loops in the list order.
+ * 
+ * @note Checks linearized and scattered, reversed and not reversed lists.
+ * 
+ * @return true if the results are the same
+ */
+bool check_float_extremums();
+
+#endif
@@ -0,0 +1,22 @@
+/**
+ * @file bench_flags.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Flags present in benchmark program.
+ * @version 0.1
+ * @date 2022-11-05
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+{ {'I', ""}, { bundle(1, &log_threshold), 1, edit_int },
+    "set log threshold to the specified number.\n"
+    "\tDoes not check if integer was specified." },
+
+{ {'S', ""}, { bundle(1, &list_size), 1, edit_int },
+    "set number of elements in benchmarked lists.\n"
+    "\tDoes not check if integer was specified." },
+
+{ {'T', ""}, { bundle(1, &max_threads), 1, edit_int },
+    "set maximum number of threads to measure scaling on.\n"
+    "\tDoes not check if integer was specified." },
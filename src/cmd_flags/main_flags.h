@@ -18,4 +18,22 @@
 
 { {'S', ""}, { bundle(1, &list_size), 1, edit_int },
     "set size of the list.\n"
-    "\tDoes not check if integer was specified." },
\ No newline at end of file
+    "\tDoes not check if integer was specified." },
+
+{ {'P', ""}, { bundle(2, profile_name, &string_size), 2, edit_bounded_string },
+    "write allocation profile to the specified file on exit and on SIGUSR1.\n"
+    "\tFiles ending with .pb get pprof format, other ones get a text table." },
+
+{ {'W', ""}, { bundle(2, trace_name, &string_size), 2, edit_bounded_string },
+    "record list calls of the run to the specified workload trace file." },
+
+{ {'R', ""}, { bundle(2, replay_name, &string_size), 2, edit_bounded_string },
+    "replay the specified workload trace instead of the demo run\n"
+    "\tand print its throughput and latency percentiles." },
+
+{ {'V', ""}, { bundle(2, check_level, &string_size), 2, edit_bounded_string },
+    "set validation level of replayed lists: full (the default), periodic, sampled or cheap." },
+
+{ {'B', ""}, { bundle(2, backend, &string_size), 2, edit_bounded_string },
+    "set storage backend of replayed lists: heap (the default), normal, thp, hugetlb or file\n"
+    "\t(file keeps the list in <trace>.list mapped into memory)." },
\ No newline at end of file
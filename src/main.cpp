@@ -11,24 +11,89 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <signal.h>
 
 #include "lib/util/dbg/debug.h"
 #include "lib/util/argparser.h"
 #include "lib/alloc_tracker/alloc_tracker.h"
 #include "utils/main_utils.h"
+#include "utils/config.h"
 
 typedef long long list_elem_t;
 const list_elem_t LIST_ELEM_POISON = (list_elem_t)0xC0FEDEADBEEFFACE;
+#define LIST_STATS
+#define LIST_PROFILE
 #include "lib/listworks.h"
+#include "lib/listworkload.h"
 
 #define MAIN
 
+/**
+ * @brief Replay the workload trace and print its throughput and latencies.
+ * 
+ * @param trace_name name of the trace file
+ * @param check_level checks of the replayed list (full, periodic, sampled or cheap)
+ * @param backend storage of the replayed list (heap, normal, thp, hugetlb or file)
+ * @return EXIT_SUCCESS or EXIT_FAILURE
+ */
+static int replay_workload(const char* trace_name, const char* check_level, const char* backend) {
+    ListReplayOptions options = {};
+
+    if      (strcmp(check_level, "full") == 0)     options.check_mode = LIST_CHECK_FULL;
+    else if (strcmp(check_level, "periodic") == 0) options.check_mode = LIST_CHECK_PERIODIC;
+    else if (strcmp(check_level, "sampled") == 0)  options.check_mode = LIST_CHECK_SAMPLED;
+    else if (strcmp(check_level, "cheap") == 0)    options.check_mode = LIST_CHECK_PERIODIC;
+    else {
+        printf("Unknown validation level \"%s\".\n", check_level);
+        return EXIT_FAILURE;
+    }
+
+    if (options.check_mode != LIST_CHECK_FULL && strcmp(check_level, "cheap") != 0) options.audit_interval = REPLAY_AUDIT_INTERVAL;
+
+    char mapped_name[LIST_FILE_NAME_SIZE] = "";
+    bool known_backend = false;
+
+    for (size_t pages = 0; pages < sizeof(PAGE_SIZE_NAMES) / sizeof(*PAGE_SIZE_NAMES); ++pages) {
+        if (strcmp(backend, PAGE_SIZE_NAMES[pages]) != 0) continue;
+        options.pages.pages = (PageSize) pages;
+        known_backend = true;
+    }
+
+    if (strcmp(backend, "file") == 0) {
+        snprintf(mapped_name, sizeof(mapped_name), "%s.list", trace_name);
+        options.mapped_file = mapped_name;
+        known_backend = true;
+    }
+
+    if (!known_backend) {
+        printf("Unknown storage backend \"%s\".\n", backend);
+        return EXIT_FAILURE;
+    }
+
+    ListReplayReport report = {};
+    int error = 0;
+    List_replay(trace_name, &options, &report, &error);
+
+    printf("Replay of %s (%s checks, %s storage):\n", trace_name, check_level, backend);
+    List_print_replay(&report, stdout);
+
+    if (error) printf("Replay stopped: %s.\n", strerror(error));
+    return error == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 int main(const int argc, const char** argv) {
     atexit(log_end_program);
 
     //* Ignore everything less or equally important as status reports.
     unsigned int log_threshold = STATUS_REPORTS + 1;
     unsigned int list_size = 16;
+    size_t string_size = LIST_FILE_NAME_SIZE;  //* Size of string arguments below.
+    char profile_name[LIST_FILE_NAME_SIZE] = "";
+    char trace_name[LIST_FILE_NAME_SIZE] = "";
+    char replay_name[LIST_FILE_NAME_SIZE] = "";
+    char check_level[LIST_FILE_NAME_SIZE] = "full";
+    char backend[LIST_FILE_NAME_SIZE] = "heap";
 
     ActionTag line_tags[] = {
         #include "cmd_flags/main_flags.h"
@@ -39,6 +104,16 @@ int main(const int argc, const char** argv) {
     log_init("program_log.html", log_threshold, &errno);
     print_label();
 
+    if (*profile_name) {
+        size_t name_length = strlen(profile_name);
+        bool pprof = name_length > 3 && strcmp(profile_name + name_length - 3, ".pb") == 0;
+
+        alloc_profile_set_output(profile_name, pprof ? ALLOC_REPORT_PPROF : ALLOC_REPORT_TEXT);
+        alloc_profile_on_signal(SIGUSR1);
+    }
+
+    if (*replay_name) return_clean(replay_workload(replay_name, check_level, backend));
+
     log_printf(STATUS_REPORTS, "status", "Initializing list structure...\n");
 
     List list = {};
@@ -50,6 +125,14 @@ int main(const int argc, const char** argv) {
 
     track_allocation(&list, (dtor_t*)List_dtor_void);
 
+    ListRecorder recorder = {};
+    if (*trace_name) {
+        log_printf(STATUS_REPORTS, "status", "Recording list calls to %s.\n", trace_name);
+
+        ListRecorder_ctor(&recorder, &list, trace_name, &errno);
+        track_allocation(&recorder, (dtor_t*)ListRecorder_dtor_void);
+    }
+
     log_printf(STATUS_REPORTS, "status", "Pushing elements into the list.\n");
 
     for (int counter = 0; counter < 10; counter++) {
@@ -94,5 +177,7 @@ int main(const int argc, const char** argv) {
 
     List_dump(&list, ABSOLUTE_IMPORTANCE);
 
+    List_print_stats(&list, stdout, LIST_STATS_TEXT, &errno);
+
     return_clean(errno == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
 }
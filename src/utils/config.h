@@ -12,6 +12,11 @@
 #ifndef MAIN_CONFIG_H
 #define MAIN_CONFIG_H
 
+#include <stddef.h>
+
 const int NUMBER_OF_OWLS = 10;
 
+//* Number of cheap checks per full list check of periodic and sampled replay validation.
+const size_t REPLAY_AUDIT_INTERVAL = 1024;
+
 #endif
\ No newline at end of file
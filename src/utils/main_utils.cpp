@@ -8,7 +8,7 @@ void** bundle(size_t count, ...) {
     va_start(args, count);
 
     void** array = (void**) calloc(count, sizeof(*array));
-    track_allocation(array, free);
+    track_allocation_sized(array, free, count * sizeof(*array));
 
     for (size_t index = 0; index < count; index++) {
         array[index] = va_arg(args, void*);